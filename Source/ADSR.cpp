@@ -228,6 +228,17 @@ bool ::ADSR::IsDone(double time) const
    return GetStage(time, dummy) == mNumStages;
 }
 
+bool ::ADSR::IsReleasedBelow(double time, float level) const
+{
+   //only the final stage is guaranteed to stay down, earlier stages can dip to zero and come back up
+   const EventInfo* e = GetEventConst(time);
+   double stageStartTime;
+   int stage = GetStage(time, stageStartTime, e);
+   if (stage != mNumStages - 1 || mStages[stage].target * e->mMult >= level)
+      return false;
+   return Value(time, e) < level;
+}
+
 namespace
 {
    const int kSaveStateRev = 1;
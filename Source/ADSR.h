@@ -96,6 +96,7 @@ public:
    void SetMaxSustain(float max) { mMaxSustain = max; }
    void SetSustainStage(int stage) { mSustainStage = stage; }
    bool IsDone(double time) const;
+   bool IsReleasedBelow(double time, float level) const;
    bool IsStandardADSR() const { return mNumStages == 3 && mSustainStage == 1; }
    float GetStartTime(double time) const { return GetEventConst(time)->mStartTime; }
    float GetStopTime(double time) const { return GetEventConst(time)->mStopTime; }
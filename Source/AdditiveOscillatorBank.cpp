@@ -0,0 +1,100 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    AdditiveOscillatorBank.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AdditiveOscillatorBank.h"
+#include "SynthGlobals.h"
+
+#include "juce_dsp/maths/juce_FastMathApproximations.h"
+
+AdditiveOscillatorBank::AdditiveOscillatorBank(int maxPartials)
+: mPhase(maxPartials)
+, mPhaseInc(maxPartials)
+, mTargetPhaseInc(maxPartials)
+, mAmp(maxPartials)
+, mTargetAmp(maxPartials)
+{
+}
+
+void AdditiveOscillatorBank::SetPartial(int partial, float freq, float amp, bool glide /*= true*/)
+{
+   mTargetPhaseInc[partial] = freq / gSampleRate;
+   mTargetAmp[partial] = amp;
+   if (!glide)
+   {
+      mPhaseInc[partial] = mTargetPhaseInc[partial];
+      mAmp[partial] = amp;
+   }
+}
+
+void AdditiveOscillatorBank::SetPhase(int partial, float phase)
+{
+   float cycles = phase / FTWO_PI;
+   mPhase[partial] = cycles - floorf(cycles);
+}
+
+void AdditiveOscillatorBank::ResetPhases()
+{
+   std::fill(mPhase.begin(), mPhase.end(), 0);
+}
+
+void AdditiveOscillatorBank::Reset()
+{
+   ResetPhases();
+   std::fill(mAmp.begin(), mAmp.end(), 0);
+   std::fill(mTargetAmp.begin(), mTargetAmp.end(), 0);
+}
+
+void AdditiveOscillatorBank::Process(float* out, int size)
+{
+   if (size <= 0)
+      return;
+
+   const float invSize = 1.0f / size;
+   for (int j = 0; j < (int)mPhase.size(); ++j)
+   {
+      const float phase = mPhase[j];
+      const float inc = mPhaseInc[j];
+      const float incStep = (mTargetPhaseInc[j] - inc) * invSize;
+      const float amp = mAmp[j];
+      const float ampStep = (mTargetAmp[j] - amp) * invSize;
+
+      if (amp != 0 || ampStep != 0)
+      {
+         //phase and amplitude are computed directly from the sample index rather than accumulated, so there's no loop-carried dependency
+         for (int i = 0; i < size; ++i)
+         {
+            float p = phase + i * inc + incStep * (i * (i + 1) / 2);
+            p -= floorf(p); //not a truncating cast, through-zero fm can make the phase negative
+            out[i] += (amp + i * ampStep) * -juce::dsp::FastMathApproximations::sin<float>(FTWO_PI * (p - .5f));
+         }
+      }
+
+      double nextPhase = phase + double(size) * inc + double(incStep) * (size * (size + 1) / 2);
+      mPhase[j] = float(nextPhase - floor(nextPhase));
+      mPhaseInc[j] = mTargetPhaseInc[j];
+      mAmp[j] = mTargetAmp[j];
+   }
+}
@@ -0,0 +1,53 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    AdditiveOscillatorBank.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+
+//a bank of sine partials, rendered a partial at a time across the whole block so the inner loop vectorizes
+//frequency and amplitude are control-rate targets, interpolated linearly across each Process() call
+class AdditiveOscillatorBank
+{
+public:
+   AdditiveOscillatorBank(int maxPartials);
+
+   int GetMaxPartials() const { return (int)mPhase.size(); }
+   void SetPartial(int partial, float freq, float amp, bool glide = true);
+   void SetPhase(int partial, float phase); //radians, of the next rendered sample
+   void ResetPhases();
+   void Reset();
+
+   void Process(float* out, int size); //adds into out
+
+private:
+   //phases are in cycles, increments in cycles per sample
+   std::vector<float> mPhase;
+   std::vector<float> mPhaseInc;
+   std::vector<float> mTargetPhaseInc;
+   std::vector<float> mAmp;
+   std::vector<float> mTargetAmp;
+};
@@ -48,6 +48,9 @@ public:
    void Process(double time) override;
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
 
+   //IAudioProcessor
+   float GetSilenceTailMs() override { return 0; }
+
    //IFloatSliderListener
    void FloatSliderUpdated(FloatSlider* slider, float oldVal, double time) override {}
 
@@ -34,19 +34,11 @@ BandVocoder::BandVocoder()
    mCarrierInputBuffer = new float[GetBuffer()->BufferSize()];
    Clear(mCarrierInputBuffer, GetBuffer()->BufferSize());
 
-   mWorkBuffer = new float[GetBuffer()->BufferSize()];
-   Clear(mWorkBuffer, GetBuffer()->BufferSize());
-
    mOutBuffer = new float[GetBuffer()->BufferSize()];
    Clear(mOutBuffer, GetBuffer()->BufferSize());
 
-   for (int i = 0; i < VOCODER_MAX_BANDS; ++i)
-   {
-      mPeaks[i].SetDecayTime(mRingTime);
-      mOutputPeaks[i].SetDecayTime(mRingTime);
-      mPeaks[i].SetLimit(mMaxBand);
-      mOutputPeaks[i].SetLimit(mMaxBand);
-   }
+   mModulatorBank.SetEnvelopeDecayTime(mRingTime);
+   mModulatorBank.SetEnvelopeLimit(mMaxBand);
 
    CalcFilters();
 }
@@ -75,7 +67,7 @@ void BandVocoder::CreateUIControls()
 BandVocoder::~BandVocoder()
 {
    delete[] mCarrierInputBuffer;
-   delete[] mWorkBuffer;
+   delete[] mOutBuffer;
 }
 
 void BandVocoder::SetCarrierBuffer(float* carrier, int bufferSize)
@@ -107,34 +99,15 @@ void BandVocoder::Process(double time)
    Mult(GetBuffer()->GetChannel(0), inputPreampSq * 5, bufferSize);
    Mult(mCarrierInputBuffer, carrierPreampSq * 5, bufferSize);
 
+   //get the level of each modulator band
    for (int i = 0; i < mNumBands; ++i)
-   {
-      //get modulator band
-      BufferCopy(mWorkBuffer, GetBuffer()->GetChannel(0), bufferSize);
-      mBiquadCarrier[i].Filter(mWorkBuffer, bufferSize);
-
-      float oldPeak = mPeaks[i].GetPeak();
-
-      //calculate modulator band level
-      mPeaks[i].Process(mWorkBuffer, bufferSize);
-
-      //get carrier band
-      BufferCopy(mWorkBuffer, mCarrierInputBuffer, bufferSize);
-      mBiquadOut[i].Filter(mWorkBuffer, bufferSize);
-
-      //multiply carrier band by modulator band level
-      //Mult(mWorkBuffer, mPeaks[i].GetPeak(), bufferSize);
-      for (int j = 0; j < bufferSize; ++j)
-         mWorkBuffer[j] *= ofMap(j, 0, bufferSize, oldPeak, mPeaks[i].GetPeak());
-
-      //don't allow a band to go crazy
-      /*mOutputPeaks[i].Process(mWorkBuffer, bufferSize);
-      if (mOutputPeaks[i].GetPeak() > mMaxBand)
-         Mult(mWorkBuffer, 1/mOutputPeaks[i].GetPeak(), bufferSize);*/
+      mBandStartLevels[i] = mModulatorBank.GetEnvelope(i);
+   mModulatorBank.ProcessEnvelopes(GetBuffer()->GetChannel(0), bufferSize);
+   for (int i = 0; i < mNumBands; ++i)
+      mBandEndLevels[i] = mModulatorBank.GetEnvelope(i);
 
-      //accumulate output band into total output
-      Add(mOutBuffer, mWorkBuffer, bufferSize);
-   }
+   //sum the carrier bands, each multiplied by its modulator band level
+   mCarrierBank.ProcessWeightedSum(mCarrierInputBuffer, mOutBuffer, bufferSize, mBandStartLevels, mBandEndLevels);
 
    Mult(mOutBuffer, mDryWet * volSq, bufferSize);
    Mult(GetBuffer()->GetChannel(0), (1 - mDryWet), bufferSize);
@@ -175,7 +148,7 @@ void BandVocoder::DrawModule()
    for (int i = 0; i < mNumBands; ++i)
    {
       float x = PosForFreq(mBiquadCarrier[i].mF) * w;
-      ofLine(x, h, x, h - mPeaks[i].GetPeak() * 200);
+      ofLine(x, h, x, h - mModulatorBank.GetEnvelope(i) * 200);
    }
 
    auto FreqForPos = [](float pos)
@@ -211,6 +184,8 @@ void BandVocoder::DrawModule()
 
 void BandVocoder::CalcFilters()
 {
+   mModulatorBank.SetNumBands(mNumBands);
+   mCarrierBank.SetNumBands(mNumBands);
    for (int i = 0; i < mNumBands; ++i)
    {
       float a = float(i) / (mNumBands - 1);
@@ -225,9 +200,9 @@ void BandVocoder::CalcFilters()
          f = ofLerp(fExp, fBass, -mSpacingStyle);
 
       mBiquadCarrier[i].SetFilterType(kFilterType_Bandpass);
-      mBiquadOut[i].SetFilterType(kFilterType_Bandpass);
       mBiquadCarrier[i].SetFilterParams(f, mQ);
-      mBiquadOut[i].CopyCoeffFrom(mBiquadCarrier[i]);
+      mModulatorBank.SetCoefficients(i, mBiquadCarrier[i]);
+      mCarrierBank.SetCoefficients(i, mBiquadCarrier[i]);
    }
 }
 
@@ -235,11 +210,8 @@ void BandVocoder::CheckboxUpdated(Checkbox* checkbox, double time)
 {
    if (checkbox == mEnabledCheckbox)
    {
-      for (int i = 0; i < VOCODER_MAX_BANDS; ++i)
-      {
-         mBiquadCarrier[i].Clear();
-         mBiquadOut[i].Clear();
-      }
+      mModulatorBank.Clear();
+      mCarrierBank.Clear();
    }
 }
 
@@ -259,19 +231,11 @@ void BandVocoder::FloatSliderUpdated(FloatSlider* slider, float oldVal, double t
    }
    if (slider == mRingTimeSlider)
    {
-      for (int i = 0; i < VOCODER_MAX_BANDS; ++i)
-      {
-         mPeaks[i].SetDecayTime(mRingTime);
-         mOutputPeaks[i].SetDecayTime(mRingTime);
-      }
+      mModulatorBank.SetEnvelopeDecayTime(mRingTime);
    }
    if (slider == mMaxBandSlider)
    {
-      for (int i = 0; i < VOCODER_MAX_BANDS; ++i)
-      {
-         mPeaks[i].SetLimit(mMaxBand);
-         mOutputPeaks[i].SetLimit(mMaxBand);
-      }
+      mModulatorBank.SetEnvelopeLimit(mMaxBand);
    }
 }
 
@@ -33,8 +33,8 @@
 #include "RollingBuffer.h"
 #include "Slider.h"
 #include "BiquadFilterEffect.h"
+#include "BiquadFilterBank.h"
 #include "VocoderCarrierInput.h"
-#include "PeakTracker.h"
 
 #define VOCODER_MAX_BANDS 64
 
@@ -82,7 +82,6 @@ private:
 
    float* mCarrierInputBuffer{ nullptr };
 
-   float* mWorkBuffer{ nullptr };
    float* mOutBuffer{ nullptr };
 
    float mInputPreamp{ 1 };
@@ -108,10 +107,11 @@ private:
    float mSpacingStyle{ 0 };
    FloatSlider* mSpacingStyleSlider{ nullptr };
 
-   BiquadFilter mBiquadCarrier[VOCODER_MAX_BANDS]{};
-   BiquadFilter mBiquadOut[VOCODER_MAX_BANDS]{};
-   PeakTracker mPeaks[VOCODER_MAX_BANDS]{};
-   PeakTracker mOutputPeaks[VOCODER_MAX_BANDS]{};
+   BiquadFilter mBiquadCarrier[VOCODER_MAX_BANDS]{}; //designs the band filters and draws their responses, the banks do the filtering
+   BiquadFilterBank mModulatorBank{ VOCODER_MAX_BANDS };
+   BiquadFilterBank mCarrierBank{ VOCODER_MAX_BANDS };
+   float mBandStartLevels[VOCODER_MAX_BANDS]{};
+   float mBandEndLevels[VOCODER_MAX_BANDS]{};
 
    bool mCarrierDataSet{ false };
 };
@@ -251,6 +251,7 @@ void BeatBloks::FilesDropped(std::vector<std::string> files, int x, int y)
    mSample->Reset();
 
    mSample->Read(files[0].c_str());
+   mSample->WaitForSampleRateConversion();
 
    ResetRead();
 
@@ -137,6 +137,7 @@ void Beats::FilesDropped(std::vector<std::string> files, int x, int y)
    {
       Sample* sample = new Sample();
       sample->Read(file.c_str());
+      sample->WaitForSampleRateConversion();
       SampleDropped(x, y, sample);
    }
 
@@ -73,6 +73,8 @@ public:
    FilterType mType{ FilterType::kFilterType_Lowpass };
 
 private:
+   friend class BiquadFilterBank;
+
    double mA0{ 1 };
    double mA1{ 0 };
    double mA2{ 0 };
@@ -0,0 +1,195 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    BiquadFilterBank.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BiquadFilterBank.h"
+#include "SynthGlobals.h"
+#include "Profiler.h"
+
+#include <cfloat>
+
+BiquadFilterBank::BiquadFilterBank(int maxBands)
+: mGroups((maxBands + kLanes - 1) / kLanes)
+, mNumBands(maxBands)
+{
+}
+
+void BiquadFilterBank::SetNumBands(int numBands)
+{
+   assert(numBands >= 0 && numBands <= (int)mGroups.size() * kLanes);
+
+   //silence the lanes that are falling out of use, so they don't leak into the sum of a partially filled group
+   for (int band = numBands; band < mNumBands; ++band)
+   {
+      LaneGroup& group = mGroups[band / kLanes];
+      int lane = band % kLanes;
+      group.mA0[lane] = 0;
+      group.mA1[lane] = 0;
+      group.mA2[lane] = 0;
+      group.mB1[lane] = 0;
+      group.mB2[lane] = 0;
+      group.mZ1[lane] = 0;
+      group.mZ2[lane] = 0;
+      group.mEnvelope[lane] = 0;
+   }
+   mNumBands = numBands;
+}
+
+void BiquadFilterBank::SetCoefficients(int band, const BiquadFilter& filter)
+{
+   assert(band >= 0 && band < mNumBands);
+
+   LaneGroup& group = mGroups[band / kLanes];
+   int lane = band % kLanes;
+   group.mA0[lane] = filter.mA0;
+   group.mA1[lane] = filter.mA1;
+   group.mA2[lane] = filter.mA2;
+   group.mB1[lane] = filter.mB1;
+   group.mB2[lane] = filter.mB2;
+}
+
+void BiquadFilterBank::Clear()
+{
+   for (auto& group : mGroups)
+   {
+      for (int lane = 0; lane < kLanes; ++lane)
+      {
+         group.mZ1[lane] = 0;
+         group.mZ2[lane] = 0;
+         group.mEnvelope[lane] = 0;
+      }
+   }
+}
+
+void BiquadFilterBank::ProcessEnvelopes(const float* input, int bufferSize)
+{
+   PROFILER(BiquadFilterBankEnvelopes);
+
+   const float scalar = powf(0.5f, 1.0f / (mDecayTime * gSampleRate));
+   const float limit = mLimit == -1 ? FLT_MAX : mLimit;
+   const int numGroups = NumGroups();
+   for (int g = 0; g < numGroups; ++g)
+   {
+      LaneGroup& group = mGroups[g];
+
+      //keep the group in locals for the length of the block, so the compiler can hold it in registers
+      double a0[kLanes], a1[kLanes], a2[kLanes], b1[kLanes], b2[kLanes], z1[kLanes], z2[kLanes];
+      float env[kLanes];
+      for (int lane = 0; lane < kLanes; ++lane)
+      {
+         a0[lane] = group.mA0[lane];
+         a1[lane] = group.mA1[lane];
+         a2[lane] = group.mA2[lane];
+         b1[lane] = group.mB1[lane];
+         b2[lane] = group.mB2[lane];
+         z1[lane] = group.mZ1[lane];
+         z2[lane] = group.mZ2[lane];
+         env[lane] = group.mEnvelope[lane];
+      }
+
+      for (int i = 0; i < bufferSize; ++i)
+      {
+         const double in = input[i];
+         for (int lane = 0; lane < kLanes; ++lane)
+         {
+            double out = in * a0[lane] + z1[lane];
+            z1[lane] = in * a1[lane] + z2[lane] - b1[lane] * out;
+            z2[lane] = in * a2[lane] - b2[lane] * out;
+
+            //same as PeakTracker: ride peaks up, decay exponentially otherwise
+            float level = fabsf(float(out));
+            float decayed = env[lane] * scalar;
+            decayed = decayed < FLT_EPSILON ? 0 : decayed;
+            float peak = level >= env[lane] ? level : decayed;
+            env[lane] = peak < limit ? peak : limit;
+         }
+      }
+
+      for (int lane = 0; lane < kLanes; ++lane)
+      {
+         group.mZ1[lane] = z1[lane];
+         group.mZ2[lane] = z2[lane];
+         group.mEnvelope[lane] = env[lane];
+      }
+   }
+}
+
+void BiquadFilterBank::ProcessWeightedSum(const float* input, float* output, int bufferSize, const float* startGains, const float* endGains)
+{
+   PROFILER(BiquadFilterBankWeightedSum);
+
+   const float invBufferSize = 1.0f / bufferSize;
+   const int numGroups = NumGroups();
+   for (int g = 0; g < numGroups; ++g)
+   {
+      LaneGroup& group = mGroups[g];
+
+      double a0[kLanes], a1[kLanes], a2[kLanes], b1[kLanes], b2[kLanes], z1[kLanes], z2[kLanes];
+      float gain[kLanes], gainStep[kLanes];
+      for (int lane = 0; lane < kLanes; ++lane)
+      {
+         a0[lane] = group.mA0[lane];
+         a1[lane] = group.mA1[lane];
+         a2[lane] = group.mA2[lane];
+         b1[lane] = group.mB1[lane];
+         b2[lane] = group.mB2[lane];
+         z1[lane] = group.mZ1[lane];
+         z2[lane] = group.mZ2[lane];
+
+         int band = g * kLanes + lane;
+         if (band < mNumBands)
+         {
+            gain[lane] = startGains[band];
+            gainStep[lane] = (endGains[band] - startGains[band]) * invBufferSize;
+         }
+         else
+         {
+            gain[lane] = 0;
+            gainStep[lane] = 0;
+         }
+      }
+
+      for (int i = 0; i < bufferSize; ++i)
+      {
+         const double in = input[i];
+         float y[kLanes];
+         for (int lane = 0; lane < kLanes; ++lane)
+         {
+            double out = in * a0[lane] + z1[lane];
+            z1[lane] = in * a1[lane] + z2[lane] - b1[lane] * out;
+            z2[lane] = in * a2[lane] - b2[lane] * out;
+            y[lane] = float(out) * (gain[lane] + gainStep[lane] * i);
+         }
+         static_assert(kLanes == 4, "update the lane sum");
+         output[i] += (y[0] + y[1]) + (y[2] + y[3]);
+      }
+
+      for (int lane = 0; lane < kLanes; ++lane)
+      {
+         group.mZ1[lane] = z1[lane];
+         group.mZ2[lane] = z2[lane];
+      }
+   }
+}
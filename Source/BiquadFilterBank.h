@@ -0,0 +1,77 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    BiquadFilterBank.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+#include "BiquadFilter.h"
+
+//a set of biquads that all filter the same input block, like the bands of a vocoder
+//bands are packed in groups of kLanes and each sample updates a whole group at once, so the recursion vectorizes across bands instead of running one band at a time
+//the filter state stays in double precision like BiquadFilter, since narrow low-frequency bands lose too much accuracy in float
+class BiquadFilterBank
+{
+public:
+   static const int kLanes = 4;
+
+   BiquadFilterBank(int maxBands);
+
+   void SetNumBands(int numBands);
+   int GetNumBands() const { return mNumBands; }
+   void SetCoefficients(int band, const BiquadFilter& filter);
+   void Clear();
+
+   //each band follows its output level the same way PeakTracker does, in the same pass as the filtering
+   void SetEnvelopeDecayTime(float time) { mDecayTime = time; }
+   void SetEnvelopeLimit(float limit) { mLimit = limit; }
+   float GetEnvelope(int band) const { return mGroups[band / kLanes].mEnvelope[band % kLanes]; }
+
+   //filters input through every band and updates the band envelopes, without keeping the filtered signals
+   void ProcessEnvelopes(const float* input, int bufferSize);
+   //filters input through every band and adds the sum of the bands into output, with each band's gain ramping linearly from startGains[band] to endGains[band] over the block
+   void ProcessWeightedSum(const float* input, float* output, int bufferSize, const float* startGains, const float* endGains);
+
+private:
+   struct alignas(32) LaneGroup
+   {
+      double mA0[kLanes]{};
+      double mA1[kLanes]{};
+      double mA2[kLanes]{};
+      double mB1[kLanes]{};
+      double mB2[kLanes]{};
+      double mZ1[kLanes]{};
+      double mZ2[kLanes]{};
+      float mEnvelope[kLanes]{};
+   };
+
+   //lanes past the last band in a group have zero coefficients, so they cost a little time but never contribute anything
+   int NumGroups() const { return (mNumBands + kLanes - 1) / kLanes; }
+
+   std::vector<LaneGroup> mGroups;
+   int mNumBands{ 0 };
+   float mDecayTime{ .01f };
+   float mLimit{ -1 };
+};
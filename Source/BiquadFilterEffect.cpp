@@ -27,9 +27,9 @@
 #include "SynthGlobals.h"
 #include "FloatSliderLFOControl.h"
 #include "Profiler.h"
+#include "BufferArena.h"
 
 BiquadFilterEffect::BiquadFilterEffect()
-: mDryBuffer(gBufferSize)
 {
 }
 
@@ -71,15 +71,19 @@ void BiquadFilterEffect::ProcessAudio(double time, ChannelBuffer* buffer)
       return;
 
    float bufferSize = buffer->BufferSize();
-   if (buffer->NumActiveChannels() != mDryBuffer.NumActiveChannels())
+   if (buffer->NumActiveChannels() != mNumChannels)
       mCoefficientsHaveChanged = true; //force filters for other channels to get updated
-   mDryBuffer.SetNumActiveChannels(buffer->NumActiveChannels());
+   mNumChannels = buffer->NumActiveChannels();
 
    const float fadeOutStart = mFSlider->GetMax() * .75f;
    const float fadeOutEnd = mFSlider->GetMax();
    bool fadeOut = mBiquad[0].mF > fadeOutStart && mBiquad[0].mType == kFilterType_Lowpass;
+   ScratchBuffer dryBuffer(buffer->BufferSize(), buffer->NumActiveChannels());
    if (fadeOut)
-      mDryBuffer.CopyFrom(buffer);
+   {
+      for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
+         BufferCopy(dryBuffer.Get(ch), buffer->GetChannel(ch), buffer->BufferSize());
+   }
 
    for (int i = 0; i < bufferSize; ++i)
    {
@@ -101,8 +105,8 @@ void BiquadFilterEffect::ProcessAudio(double time, ChannelBuffer* buffer)
       {
          float dryness = ofMap(mBiquad[0].mF, fadeOutStart, fadeOutEnd, 0, 1);
          Mult(buffer->GetChannel(ch), 1 - dryness, bufferSize);
-         Mult(mDryBuffer.GetChannel(ch), dryness, bufferSize);
-         Add(buffer->GetChannel(ch), mDryBuffer.GetChannel(ch), bufferSize);
+         Mult(dryBuffer.Get(ch), dryness, bufferSize);
+         Add(buffer->GetChannel(ch), dryBuffer.Get(ch), bufferSize);
       }
    }
 }
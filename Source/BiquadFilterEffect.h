@@ -57,6 +57,7 @@ public:
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
    float GetEffectAmount() override;
    std::string GetType() override { return "biquad"; }
+   float GetTailLengthMs() override { return 0; }
 
    bool MouseMoved(float x, float y) override;
 
@@ -86,7 +87,7 @@ private:
    bool mMouseControl{ false };
 
    BiquadFilter mBiquad[ChannelBuffer::kMaxNumChannels];
-   ChannelBuffer mDryBuffer;
+   int mNumChannels{ 1 };
 
    bool mCoefficientsHaveChanged{ true };
 };
@@ -0,0 +1,204 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    BufferArena.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BufferArena.h"
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+   const int kFloatsPerLine = BufferArena::kAlignment / sizeof(float);
+   const int kMaxSlabAllocation = 1 << 16; //in floats. anything larger (sample data, long delay lines) goes straight to the system allocator
+   const size_t kSlabBytes = 4 << 20;
+   const int kScratchStackSize = 1 << 18; //in floats, per thread
+
+   //sits in the cache line just before each buffer, so Free() knows where it came from
+   struct BlockHeader
+   {
+      int mCapacity; //in floats
+      bool mFromSlab;
+   };
+   static_assert(sizeof(BlockHeader) <= BufferArena::kAlignment, "header must fit in the line before the buffer");
+
+   int RoundUpToLine(int numFloats)
+   {
+      return (numFloats + kFloatsPerLine - 1) / kFloatsPerLine * kFloatsPerLine;
+   }
+
+   BlockHeader* GetHeader(float* buffer)
+   {
+      return reinterpret_cast<BlockHeader*>(reinterpret_cast<char*>(buffer) - BufferArena::kAlignment);
+   }
+
+   struct ArenaState
+   {
+      std::mutex mMutex;
+      char* mSlabCursor{ nullptr };
+      char* mSlabEnd{ nullptr };
+      std::unordered_map<int, std::vector<float*> > mFreeLists; //keyed by capacity
+   };
+
+   ArenaState& GetState()
+   {
+      //intentionally never destroyed, since static ChannelBuffers may free into it during shutdown
+      static ArenaState* sState = new ArenaState();
+      return *sState;
+   }
+
+   char* AllocateAligned(size_t bytes)
+   {
+      return static_cast<char*>(::operator new(bytes, std::align_val_t(BufferArena::kAlignment)));
+   }
+
+   void FreeAligned(char* block)
+   {
+      ::operator delete(block, std::align_val_t(BufferArena::kAlignment));
+   }
+
+   float* CarveFromSlab(ArenaState& state, int capacity)
+   {
+      size_t bytes = BufferArena::kAlignment + capacity * sizeof(float);
+      if (state.mSlabCursor == nullptr || state.mSlabCursor + bytes > state.mSlabEnd)
+      {
+         //whatever is left of the previous slab is abandoned, it's a small fraction of it
+         char* slab = AllocateAligned(kSlabBytes);
+         state.mSlabCursor = slab;
+         state.mSlabEnd = slab + kSlabBytes;
+      }
+
+      float* buffer = reinterpret_cast<float*>(state.mSlabCursor + BufferArena::kAlignment);
+      state.mSlabCursor += bytes;
+      return buffer;
+   }
+}
+
+float* BufferArena::Allocate(int numSamples)
+{
+   assert(numSamples >= 0);
+   int capacity = RoundUpToLine(numSamples > 0 ? numSamples : 1);
+
+   if (capacity > kMaxSlabAllocation)
+   {
+      char* block = AllocateAligned(kAlignment + capacity * sizeof(float));
+      float* buffer = reinterpret_cast<float*>(block + kAlignment);
+      GetHeader(buffer)->mCapacity = capacity;
+      GetHeader(buffer)->mFromSlab = false;
+      return buffer;
+   }
+
+   ArenaState& state = GetState();
+   std::lock_guard<std::mutex> lock(state.mMutex);
+
+   float* buffer;
+   auto& freeList = state.mFreeLists[capacity];
+   if (!freeList.empty())
+   {
+      buffer = freeList.back();
+      freeList.pop_back();
+   }
+   else
+   {
+      buffer = CarveFromSlab(state, capacity);
+   }
+
+   GetHeader(buffer)->mCapacity = capacity;
+   GetHeader(buffer)->mFromSlab = true;
+   return buffer;
+}
+
+void BufferArena::Free(float* buffer)
+{
+   if (buffer == nullptr)
+      return;
+
+   assert(reinterpret_cast<uintptr_t>(buffer) % kAlignment == 0);
+   BlockHeader* header = GetHeader(buffer);
+
+   if (!header->mFromSlab)
+   {
+      FreeAligned(reinterpret_cast<char*>(header));
+      return;
+   }
+
+   ArenaState& state = GetState();
+   std::lock_guard<std::mutex> lock(state.mMutex);
+   state.mFreeLists[header->mCapacity].push_back(buffer);
+}
+
+namespace
+{
+   struct ScratchStack
+   {
+      ~ScratchStack() { BufferArena::Free(mData); }
+
+      float* mData{ nullptr };
+      int mUsed{ 0 };
+   };
+
+   thread_local ScratchStack tScratchStack;
+}
+
+ScratchBuffer::ScratchBuffer(int numSamples, int numChannels /*= 1*/)
+: mNumSamples(numSamples)
+, mNumChannels(numChannels)
+, mChannelStride(RoundUpToLine(numSamples))
+{
+   int size = mChannelStride * numChannels;
+
+   ScratchStack& stack = tScratchStack;
+   if (stack.mData == nullptr)
+      stack.mData = BufferArena::Allocate(kScratchStackSize);
+
+   if (stack.mUsed + size <= kScratchStackSize)
+   {
+      mData = stack.mData + stack.mUsed;
+      mStackSize = size;
+      stack.mUsed += size;
+   }
+   else
+   {
+      mData = BufferArena::Allocate(size);
+      mStackSize = 0;
+   }
+}
+
+ScratchBuffer::~ScratchBuffer()
+{
+   if (mStackSize > 0)
+   {
+      ScratchStack& stack = tScratchStack;
+      assert(mData + mStackSize == stack.mData + stack.mUsed); //released out of order
+      stack.mUsed -= mStackSize;
+   }
+   else
+   {
+      BufferArena::Free(mData);
+   }
+}
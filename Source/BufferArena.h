@@ -0,0 +1,64 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    BufferArena.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//64-byte aligned storage for audio buffers
+//small buffers are carved out of large slabs one after another, so the buffers a module allocates together end up next to each other in memory
+//freed buffers go on a free list for their size and get handed back out, so rebuilding the graph with the same modules doesn't touch the system allocator
+namespace BufferArena
+{
+   const int kAlignment = 64;
+
+   //contents are uninitialized
+   float* Allocate(int numSamples);
+   //buffer must have come from Allocate(). nullptr is ignored
+   void Free(float* buffer);
+}
+
+//stack-allocated temporary audio buffers for use within a single Process() call, so modules don't need to keep their own dry/work buffers around
+//each audio thread gets its own stack, and scratch buffers are released in reverse order of creation when they go out of scope
+//contents are uninitialized
+class ScratchBuffer
+{
+public:
+   ScratchBuffer(int numSamples, int numChannels = 1);
+   ~ScratchBuffer();
+
+   float* Get(int channel = 0) const { return mData + channel * mChannelStride; }
+   int BufferSize() const { return mNumSamples; }
+   int NumChannels() const { return mNumChannels; }
+
+   ScratchBuffer(const ScratchBuffer&) = delete;
+   ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+private:
+   float* mData{ nullptr };
+   int mNumSamples{ 0 };
+   int mNumChannels{ 0 };
+   int mChannelStride{ 0 };
+   int mStackSize{ 0 }; //floats taken from this thread's stack, zero if we overflowed into the arena
+};
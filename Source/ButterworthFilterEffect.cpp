@@ -27,10 +27,10 @@
 #include "SynthGlobals.h"
 #include "FloatSliderLFOControl.h"
 #include "Profiler.h"
+#include "BufferArena.h"
 #include "UIControlMacros.h"
 
 ButterworthFilterEffect::ButterworthFilterEffect()
-: mDryBuffer(gBufferSize)
 {
 }
 
@@ -63,13 +63,16 @@ void ButterworthFilterEffect::ProcessAudio(double time, ChannelBuffer* buffer)
       return;
 
    float bufferSize = buffer->BufferSize();
-   mDryBuffer.SetNumActiveChannels(buffer->NumActiveChannels());
 
    const float fadeOutStart = mFSlider->GetMax() * .75f;
    const float fadeOutEnd = mFSlider->GetMax();
    bool fadeOut = mF > fadeOutStart;
+   ScratchBuffer dryBuffer(buffer->BufferSize(), buffer->NumActiveChannels());
    if (fadeOut)
-      mDryBuffer.CopyFrom(buffer);
+   {
+      for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
+         BufferCopy(dryBuffer.Get(ch), buffer->GetChannel(ch), buffer->BufferSize());
+   }
 
    for (int i = 0; i < bufferSize; ++i)
    {
@@ -91,8 +94,8 @@ void ButterworthFilterEffect::ProcessAudio(double time, ChannelBuffer* buffer)
       {
          float dryness = ofMap(mF, fadeOutStart, fadeOutEnd, 0, 1);
          Mult(buffer->GetChannel(ch), 1 - dryness, bufferSize);
-         Mult(mDryBuffer.GetChannel(ch), dryness, bufferSize);
-         Add(buffer->GetChannel(ch), mDryBuffer.GetChannel(ch), bufferSize);
+         Mult(dryBuffer.Get(ch), dryness, bufferSize);
+         Add(buffer->GetChannel(ch), dryBuffer.Get(ch), bufferSize);
       }
    }
 }
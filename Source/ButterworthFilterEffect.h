@@ -53,6 +53,7 @@ public:
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
    float GetEffectAmount() override;
    std::string GetType() override { return "butterworth"; }
+   float GetTailLengthMs() override { return 0; }
 
    void DropdownUpdated(DropdownList* list, int oldVal, double time) override;
    void CheckboxUpdated(Checkbox* checkbox, double time) override;
@@ -84,7 +85,6 @@ private:
    float mHeight{ 20 };
 
    CFilterButterworth24db mButterworth[ChannelBuffer::kMaxNumChannels]{};
-   ChannelBuffer mDryBuffer;
 
    bool mCoefficientsHaveChanged{ true };
 };
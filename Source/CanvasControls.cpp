@@ -68,7 +68,7 @@ void CanvasControls::SetCanvas(Canvas* canvas)
    mCanvas = canvas;
    mWidth = mCanvas->GetWidth();
    mCanvas->SetControls(this);
-   StringCopy(NameMutable(), (std::string(mCanvas->Name()) + "_controls").c_str(), MAX_TEXTENTRY_LENGTH);
+   SetName((std::string(mCanvas->Name()) + "_controls").c_str());
 }
 
 void CanvasControls::SetElement(CanvasElement* element)
@@ -26,9 +26,24 @@
 */
 
 #include "ChannelBuffer.h"
+#include "BufferArena.h"
+#include "PeakPyramid.h"
+
+#include <limits>
+
+namespace
+{
+   const int kPeakRefreshSamplesPerDraw = 1 << 16;
+}
 
 ChannelBuffer::ChannelBuffer(int bufferSize)
 {
+   for (int i = 0; i < kMaxNumChannels; ++i)
+   {
+      mDirtyStart[i] = std::numeric_limits<int>::max();
+      mDirtyEnd[i] = 0;
+   }
+
    mNumChannels = kMaxNumChannels;
    mOwnsBuffers = true;
 
@@ -39,6 +54,12 @@ ChannelBuffer::ChannelBuffer(float* data, int bufferSize)
 {
    //intended as a temporary holder for passing raw data to methods that want a ChannelBuffer
 
+   for (int i = 0; i < kMaxNumChannels; ++i)
+   {
+      mDirtyStart[i] = std::numeric_limits<int>::max();
+      mDirtyEnd[i] = 0;
+   }
+
    mNumChannels = 1;
    mOwnsBuffers = false;
 
@@ -52,9 +73,12 @@ ChannelBuffer::~ChannelBuffer()
    if (mOwnsBuffers)
    {
       for (int i = 0; i < mNumChannels; ++i)
-         delete[] mBuffers[i];
+         BufferArena::Free(mBuffers[i]);
    }
    delete[] mBuffers;
+
+   for (int i = 0; i < kMaxNumChannels; ++i)
+      delete mPeaks[i];
 }
 
 void ChannelBuffer::Setup(int bufferSize)
@@ -76,7 +100,7 @@ float* ChannelBuffer::GetChannel(int channel)
    if (ret == nullptr)
    {
       assert(mOwnsBuffers);
-      ret = new float[BufferSize()];
+      ret = BufferArena::Allocate(BufferSize());
       ::Clear(ret, BufferSize());
       mBuffers[MIN(channel, mActiveChannels - 1)] = ret;
    }
@@ -90,6 +114,7 @@ void ChannelBuffer::Clear() const
       if (mBuffers[i] != nullptr)
          ::Clear(mBuffers[i], BufferSize());
    }
+   MarkDirty(0, BufferSize());
 }
 
 void ChannelBuffer::SetMaxAllowedChannels(int channels)
@@ -104,7 +129,7 @@ void ChannelBuffer::SetMaxAllowedChannels(int channels)
    }
 
    for (int i = channels; i < mNumChannels; ++i)
-      delete[] mBuffers[i];
+      BufferArena::Free(mBuffers[i]);
    delete[] mBuffers;
 
    mBuffers = newBuffers;
@@ -127,31 +152,33 @@ void ChannelBuffer::CopyFrom(ChannelBuffer* src, int length /*= -1*/, int startO
          if (mBuffers[i] == nullptr)
          {
             assert(mOwnsBuffers);
-            mBuffers[i] = new float[mBufferSize];
+            mBuffers[i] = BufferArena::Allocate(mBufferSize);
             ::Clear(mBuffers[i], mBufferSize);
          }
          BufferCopy(mBuffers[i], src->mBuffers[i] + startOffset, length);
       }
       else
       {
-         delete mBuffers[i];
+         BufferArena::Free(mBuffers[i]);
          mBuffers[i] = nullptr;
       }
    }
+   MarkDirty(0, length);
 }
 
 void ChannelBuffer::SetChannelPointer(float* data, int channel, bool deleteOldData)
 {
    if (deleteOldData)
-      delete[] mBuffers[channel];
+      BufferArena::Free(mBuffers[channel]);
    mBuffers[channel] = data;
+   MarkDirty(0, mBufferSize);
 }
 
 void ChannelBuffer::Resize(int bufferSize)
 {
    assert(mOwnsBuffers);
    for (int i = 0; i < mNumChannels; ++i)
-      delete[] mBuffers[i];
+      BufferArena::Free(mBuffers[i]);
    delete[] mBuffers;
 
    Setup(bufferSize);
@@ -200,4 +227,49 @@ void ChannelBuffer::Load(FileStreamIn& in, int& readLength, LoadMode loadMode)
       if (hasBuffer)
          in.Read(GetChannel(i), readLength);
    }
+   MarkDirty(0, readLength);
+}
+
+void ChannelBuffer::MarkDirty(int start, int length) const
+{
+   if (!mTrackPeaks)
+      return;
+
+   int end = start + length;
+   for (int i = 0; i < kMaxNumChannels; ++i)
+   {
+      //widen the dirty range without a lock, since this can come from the audio thread
+      int cur = mDirtyStart[i];
+      while (start < cur && !mDirtyStart[i].compare_exchange_weak(cur, start))
+      {
+      }
+      cur = mDirtyEnd[i];
+      while (end > cur && !mDirtyEnd[i].compare_exchange_weak(cur, end))
+      {
+      }
+   }
+}
+
+const PeakPyramid* ChannelBuffer::GetPeaks(int channel)
+{
+   if (!mTrackPeaks)
+      return nullptr;
+
+   channel = MIN(channel, mActiveChannels - 1);
+   const float* data = GetChannel(channel);
+
+   if (mPeaks[channel] == nullptr)
+      mPeaks[channel] = new PeakPyramid();
+
+   int dirtyStart = mDirtyStart[channel].exchange(std::numeric_limits<int>::max());
+   int dirtyEnd = mDirtyEnd[channel].exchange(0);
+
+   PeakPyramid* peaks = mPeaks[channel];
+   if (peaks->Length() != mBufferSize)
+      peaks->Build(data, mBufferSize);
+   else if (dirtyStart < dirtyEnd)
+      peaks->Update(data, dirtyStart, dirtyEnd);
+   peaks->Refresh(data, kPeakRefreshSamplesPerDraw);
+
+   return peaks;
 }
@@ -26,9 +26,12 @@
 */
 
 #pragma once
+#include <atomic>
 #include "SynthGlobals.h"
 #include "FileStream.h"
 
+class PeakPyramid;
+
 class ChannelBuffer
 {
 public:
@@ -47,7 +50,7 @@ public:
    int NumTotalChannels() const { return mNumChannels; }
    int BufferSize() const { return mBufferSize; }
    void CopyFrom(ChannelBuffer* src, int length = -1, int startOffset = 0);
-   void SetChannelPointer(float* data, int channel, bool deleteOldData);
+   void SetChannelPointer(float* data, int channel, bool deleteOldData); //data must come from BufferArena::Allocate(), since we'll free it later
    void Reset()
    {
       Clear();
@@ -66,6 +69,13 @@ public:
    void Save(FileStreamOut& out, int writeLength);
    void Load(FileStreamIn& in, int& readLength, LoadMode loadMode);
 
+   //opt in to keeping a PeakPyramid per channel for drawing. it's built the first time the buffer is drawn,
+   //changes made through ChannelBuffer methods are picked up automatically, and anyone writing into GetChannel() directly
+   //can MarkDirty() to have it redrawn right away. anything else is caught up a bit at a time on each draw
+   void EnablePeaks() { mTrackPeaks = true; }
+   void MarkDirty(int start, int length) const;
+   const PeakPyramid* GetPeaks(int channel); //ui thread. nullptr if peaks aren't enabled
+
    static const int kMaxNumChannels = 2;
 
 private:
@@ -77,4 +87,9 @@ private:
    float** mBuffers;
    int mRecentActiveChannels{ 1 };
    bool mOwnsBuffers{ true };
+
+   bool mTrackPeaks{ false };
+   PeakPyramid* mPeaks[kMaxNumChannels]{};
+   mutable std::atomic<int> mDirtyStart[kMaxNumChannels];
+   mutable std::atomic<int> mDirtyEnd[kMaxNumChannels];
 };
@@ -191,6 +191,7 @@ void ClipArranger::FilesDropped(std::vector<std::string> files, int x, int y)
 {
    Sample* sample = new Sample();
    sample->Read(files[0].c_str());
+   sample->WaitForSampleRateConversion();
    AddSample(sample, x, y);
 }
 
@@ -139,6 +139,11 @@ void Compressor::ProcessAudio(double time, ChannelBuffer* buffer)
    }
 }
 
+float Compressor::GetTailLengthMs()
+{
+   return kMaxLookaheadMs; //the lookahead delay
+}
+
 void Compressor::DrawModule()
 {
    mMixSlider->Draw();
@@ -35,6 +35,10 @@
 DelayEffect::DelayEffect()
 : mDelayBuffer(DELAY_BUFFER_SIZE)
 {
+   mDelaySampsBuffer.resize(gBufferSize);
+   mFeedbackBuffer.resize(gBufferSize);
+   mReadBuffer.resize(gBufferSize);
+   mDryBuffer.resize(gBufferSize);
 }
 
 void DelayEffect::CreateUIControls()
@@ -75,16 +79,26 @@ void DelayEffect::ProcessAudio(double time, ChannelBuffer* buffer)
    if (!mEnabled)
       return;
 
-   float bufferSize = buffer->BufferSize();
+   int bufferSize = buffer->BufferSize();
    mDelayBuffer.SetNumChannels(buffer->NumActiveChannels());
 
+   if ((int)mDelaySampsBuffer.size() < bufferSize)
+   {
+      mDelaySampsBuffer.resize(bufferSize);
+      mFeedbackBuffer.resize(bufferSize);
+      mReadBuffer.resize(bufferSize);
+      mDryBuffer.resize(bufferSize);
+   }
+
    if (mInterval != kInterval_None)
    {
       mDelay = TheTransport->GetDuration(mInterval) + .1f; //+1 to avoid perfect sample collision
       mDelayRamp.Start(time, mDelay, time + 10);
    }
 
+   //gather the per-sample control values first, so the audio itself can be processed in blocks
    mAmountRamp.Start(time, mFeedback, time + 3);
+   bool constantDelay = true;
    for (int i = 0; i < bufferSize; ++i)
    {
       mFeedback = mAmountRamp.Value(time);
@@ -98,37 +112,68 @@ void DelayEffect::ProcessAudio(double time, ChannelBuffer* buffer)
          delaySamps -= gBufferSize;
       delaySamps = ofClamp(delaySamps, 0.1f, DELAY_BUFFER_SIZE - 2);
 
-      int sampsAgoA = int(delaySamps);
-      int sampsAgoB = sampsAgoA + 1;
+      mDelaySampsBuffer[i] = delaySamps;
+      mFeedbackBuffer[i] = mFeedback * (mInvert ? -1 : 1);
+      if (delaySamps != mDelaySampsBuffer[0])
+         constantDelay = false;
+
+      time += gInvSampleRateMs;
+   }
+
+   int chunkStart = 0;
+   while (chunkStart < bufferSize)
+   {
+      //we can read ahead for as many samples as we have before the read position catches up with what we're writing
+      int chunkSize = 0;
+      while (chunkStart + chunkSize < bufferSize && int(mDelaySampsBuffer[chunkStart + chunkSize]) > chunkSize)
+         ++chunkSize;
+      chunkSize = MAX(chunkSize, 1);
+
+      float* samplesAgo = mDelaySampsBuffer.data() + chunkStart;
+      if (!constantDelay)
+      {
+         for (int i = 0; i < chunkSize; ++i)
+            samplesAgo[i] -= i;
+      }
 
+      const float* feedback = mFeedbackBuffer.data() + chunkStart;
+      float* delayInput = mReadBuffer.data();
       for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
       {
-         float sample = mDelayBuffer.GetSample(sampsAgoA, ch);
-         float nextSample = mDelayBuffer.GetSample(sampsAgoB, ch);
-         float a = delaySamps - sampsAgoA;
-         float delayedSample = (1 - a) * sample + a * nextSample; //interpolate
+         float* in = buffer->GetChannel(ch) + chunkStart;
+
+         if (constantDelay)
+            mDelayBuffer.ReadInterpolated(delayInput, chunkSize, samplesAgo[0], ch);
+         else
+            mDelayBuffer.ReadInterpolated(delayInput, chunkSize, samplesAgo, ch);
 
-         float in = buffer->GetChannel(ch)[i];
+         for (int i = 0; i < chunkSize; ++i)
+         {
+            delayInput[i] *= feedback[i];
+            JUCE_UNDENORMALISE(delayInput[i]);
+            if (delayInput[i] != delayInput[i]) //filter NaNs
+               delayInput[i] = 0;
+         }
 
          if (!mEcho && mAcceptInput) //single delay, no continuous feedback so do it pre
-            mDelayBuffer.Write(buffer->GetChannel(ch)[i], ch);
+            mDelayBuffer.WriteChunk(in, chunkSize, ch);
 
-         float delayInput = delayedSample * mFeedback * (mInvert ? -1 : 1);
-         JUCE_UNDENORMALISE(delayInput);
-         if (delayInput == delayInput) //filter NaNs
-            buffer->GetChannel(ch)[i] += delayInput;
+         if (!mDry)
+            BufferCopy(mDryBuffer.data(), in, chunkSize);
+
+         Add(in, delayInput, chunkSize);
 
          if (mEcho && mAcceptInput) //continuous feedback so do it post
-            mDelayBuffer.Write(buffer->GetChannel(ch)[i], ch);
+            mDelayBuffer.WriteChunk(in, chunkSize, ch);
 
          if (!mAcceptInput)
-            mDelayBuffer.Write(delayInput, ch);
+            mDelayBuffer.WriteChunk(delayInput, chunkSize, ch);
 
          if (!mDry)
-            buffer->GetChannel(ch)[i] -= in;
+            Subtract(in, mDryBuffer.data(), chunkSize);
       }
 
-      time += gInvSampleRateMs;
+      chunkStart += chunkSize;
    }
 }
 
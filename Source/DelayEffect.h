@@ -28,7 +28,7 @@
 
 #include <iostream>
 #include "IAudioEffect.h"
-#include "RollingBuffer.h"
+#include "DelayLine.h"
 #include "Slider.h"
 #include "Checkbox.h"
 #include "DropdownList.h"
@@ -60,6 +60,7 @@ public:
    void SetEnabled(bool enabled) override;
    float GetEffectAmount() override;
    std::string GetType() override { return "delay"; }
+   float GetTailLengthMs() override { return mDelayBuffer.Size() * gInvSampleRateMs; }
 
    void CheckboxUpdated(Checkbox* checkbox, double time) override;
    void FloatSliderUpdated(FloatSlider* slider, float oldVal, double time) override;
@@ -83,7 +84,7 @@ private:
    float mDelay{ 500 };
    float mFeedback{ 0 };
    bool mEcho{ true };
-   RollingBuffer mDelayBuffer;
+   DelayLine mDelayBuffer;
    FloatSlider* mFeedbackSlider{ nullptr };
    FloatSlider* mDelaySlider{ nullptr };
    Checkbox* mEchoCheckbox{ nullptr };
@@ -105,6 +106,11 @@ private:
    float mHeight{ 20 };
 
    bool mFeedbackModuleMode{ false }; //special mode when this delay effect is being used in a FeedbackModule
+
+   std::vector<float> mDelaySampsBuffer;
+   std::vector<float> mFeedbackBuffer;
+   std::vector<float> mReadBuffer;
+   std::vector<float> mDryBuffer;
 };
 
 #endif /* defined(__modularSynth__DelayEffect__) */
@@ -0,0 +1,232 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    DelayLine.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DelayLine.h"
+#include "SynthGlobals.h"
+#include "MathUtils.h"
+
+DelayLine::DelayLine(int minSizeInSamples)
+: mSize(MathUtils::NextPow2(minSizeInSamples))
+, mMask(mSize - 1)
+, mNominalSize(minSizeInSamples)
+, mBuffer(mSize)
+{
+}
+
+void DelayLine::ClearBuffer()
+{
+   mBuffer.Clear();
+   for (int i = 0; i < ChannelBuffer::kMaxNumChannels; ++i)
+      mHead[i] = 0;
+}
+
+void DelayLine::SyncChannelHead(int channel)
+{
+   if (channel != 0 && ((mHead[0] - mHead[channel]) & mMask) > gBufferSize * 2) //channels out of sync, probably was only writing to channel 0 for a while
+      mHead[channel] = mHead[0];
+}
+
+WrappedSpan DelayLine::GetSpan(int size, int samplesAgo, int channel)
+{
+   assert(size >= 0 && samplesAgo >= 0);
+   assert(size + samplesAgo <= mSize);
+
+   float* buffer = mBuffer.GetChannel(channel);
+   int start = (mHead[channel] - samplesAgo - size) & mMask;
+
+   WrappedSpan span;
+   span.mFirst = buffer + start;
+   span.mFirstSize = MIN(size, mSize - start);
+   span.mSecond = buffer;
+   span.mSecondSize = size - span.mFirstSize;
+   return span;
+}
+
+WrappedSpan DelayLine::GetWriteSpan(int size, int channel)
+{
+   assert(size >= 0 && size < mSize);
+
+   float* buffer = mBuffer.GetChannel(channel);
+   int head = mHead[channel];
+
+   WrappedSpan span;
+   span.mFirst = buffer + head;
+   span.mFirstSize = MIN(size, mSize - head);
+   span.mSecond = buffer;
+   span.mSecondSize = size - span.mFirstSize;
+   return span;
+}
+
+void DelayLine::CommitWrite(int size, int channel)
+{
+   mHead[channel] = (mHead[channel] + size) & mMask;
+   SyncChannelHead(channel);
+}
+
+void DelayLine::WriteChunk(const float* samples, int size, int channel)
+{
+   WrappedSpan span = GetWriteSpan(size, channel);
+   BufferCopy(span.mFirst, samples, span.mFirstSize);
+   if (span.mSecondSize > 0) //wrap around loop point
+      BufferCopy(span.mSecond, samples + span.mFirstSize, span.mSecondSize);
+   CommitWrite(size, channel);
+}
+
+void DelayLine::ReadChunk(float* dst, int size, int samplesAgo, int channel)
+{
+   WrappedSpan span = GetSpan(size, samplesAgo, channel);
+   BufferCopy(dst, span.mFirst, span.mFirstSize);
+   if (span.mSecondSize > 0) //wrap around loop point
+      BufferCopy(dst + span.mFirstSize, span.mSecond, span.mSecondSize);
+}
+
+void DelayLine::ReadInterpolated(float* dst, int size, float delaySamples, int channel)
+{
+   assert(delaySamples >= 0 && delaySamples < mSize - 1);
+
+   const float* buffer = mBuffer.GetChannel(channel);
+   int sampsAgo = int(delaySamples);
+   float a = delaySamples - sampsAgo;
+   int idx = (mHead[channel] - sampsAgo) & mMask;
+
+   int i = 0;
+   while (i < size)
+   {
+      if (idx == 0) //the previous sample is at the other end of the buffer
+      {
+         dst[i] = buffer[0] + a * (buffer[mMask] - buffer[0]);
+         ++i;
+         idx = 1;
+         continue;
+      }
+
+      //contiguous span, with no wraparound for either tap, so this loop vectorizes
+      int span = MIN(size - i, mSize - idx);
+      const float* cur = buffer + idx;
+      const float* prev = cur - 1;
+      float* out = dst + i;
+      for (int j = 0; j < span; ++j)
+         out[j] = cur[j] + a * (prev[j] - cur[j]);
+
+      i += span;
+      idx = (idx + span) & mMask;
+   }
+}
+
+void DelayLine::ReadInterpolated(float* dst, int size, const float* samplesAgo, int channel)
+{
+   const float* buffer = mBuffer.GetChannel(channel);
+   const int head = mHead[channel];
+   for (int i = 0; i < size; ++i)
+   {
+      assert(samplesAgo[i] >= 0 && samplesAgo[i] < mSize - 1);
+      int sampsAgo = int(samplesAgo[i]);
+      float a = samplesAgo[i] - sampsAgo;
+      int idx = (head - sampsAgo) & mMask;
+      float cur = buffer[idx];
+      float prev = buffer[(idx - 1) & mMask];
+      dst[i] = cur + a * (prev - cur);
+   }
+}
+
+void DelayLine::Draw(int x, int y, int width, int height, int length /*= -1*/, int channel /*= -1*/, int delayOffset /*= 0*/)
+{
+   ofPushStyle();
+   ofPushMatrix();
+
+   ofTranslate(x, y);
+
+   if (length == -1) //draw full buffer
+   {
+      if (channel == -1)
+         DrawAudioBuffer(width, height, &mBuffer, 0, mSize, -1);
+      else
+         DrawAudioBuffer(width, height, mBuffer.GetChannel(channel), 0, mSize, -1);
+   }
+   else //draw segment
+   {
+      int head = (channel == -1) ? mHead[0] : mHead[channel];
+      int startSample = (head - length - delayOffset) & mMask;
+      int endSample = (startSample + length) & mMask; //draw wraparound
+
+      if (channel == -1)
+         DrawAudioBuffer(width, height, &mBuffer, startSample, endSample, -1, 1, ofColor::black, mSize);
+      else
+         DrawAudioBuffer(width, height, mBuffer.GetChannel(channel), startSample, endSample, -1, 1, ofColor::black, mSize);
+   }
+
+   ofPopMatrix();
+   ofPopStyle();
+}
+
+namespace
+{
+   //matches RollingBuffer's format, so modules that switched over can still load their old state
+   const int kSaveStateRev = 3;
+}
+
+void DelayLine::SaveState(FileStreamOut& out)
+{
+   out << kSaveStateRev;
+
+   out << mBuffer.NumActiveChannels();
+   out << mSize;
+   for (int i = 0; i < mBuffer.NumActiveChannels(); ++i)
+   {
+      out << mHead[i];
+      out.Write(mBuffer.GetChannel(i), mSize);
+   }
+}
+
+void DelayLine::LoadState(FileStreamIn& in)
+{
+   int rev;
+   in >> rev;
+
+   int channels = ChannelBuffer::kMaxNumChannels;
+   if (rev >= 2)
+      in >> channels;
+   int savedSize = mNominalSize;
+   if (rev >= 3)
+      in >> savedSize;
+   mBuffer.SetNumActiveChannels(channels);
+
+   std::vector<float> saved(savedSize);
+   for (int i = 0; i < channels; ++i)
+   {
+      int savedOffset;
+      in >> savedOffset;
+      in.Read(saved.data(), savedSize);
+
+      //the saved buffer may have a different size (or be an old non power-of-two RollingBuffer), so unroll it from newest to oldest
+      float* buffer = mBuffer.GetChannel(i);
+      ::Clear(buffer, mSize);
+      mHead[i] = 0;
+      int count = MIN(savedSize, mSize);
+      for (int k = 1; k <= count; ++k)
+         buffer[(-k) & mMask] = saved[((savedOffset - k) % savedSize + savedSize) % savedSize];
+   }
+}
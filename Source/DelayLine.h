@@ -0,0 +1,92 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    DelayLine.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+#include "FileStream.h"
+#include "ChannelBuffer.h"
+#include "RollingBuffer.h"
+
+//multichannel circular history buffer with a power-of-two size, so indexing is a mask instead of a modulo
+//"samplesAgo" has the same meaning as in RollingBuffer: 1 is the most recently written sample
+class DelayLine
+{
+public:
+   DelayLine(int minSizeInSamples);
+
+   int Size() const { return mSize; }
+   void SetNumChannels(int channels) { mBuffer.SetNumActiveChannels(channels); }
+   int NumChannels() const { return mBuffer.NumActiveChannels(); }
+   void ClearBuffer();
+
+   float GetSample(int samplesAgo, int channel)
+   {
+      assert(samplesAgo >= 0 && samplesAgo < mSize);
+      return mBuffer.GetChannel(channel)[(mHead[channel] - samplesAgo) & mMask];
+   }
+   void Accum(int samplesAgo, float sample, int channel)
+   {
+      assert(samplesAgo >= 0 && samplesAgo < mSize);
+      mBuffer.GetChannel(channel)[(mHead[channel] - samplesAgo) & mMask] += sample;
+   }
+   void Write(float sample, int channel)
+   {
+      mBuffer.GetChannel(channel)[mHead[channel]] = sample;
+      mHead[channel] = (mHead[channel] + 1) & mMask;
+      SyncChannelHead(channel);
+   }
+   void WriteChunk(const float* samples, int size, int channel);
+   void ReadChunk(float* dst, int size, int samplesAgo, int channel);
+
+   //the same samples that ReadChunk() would copy out, for reading or modifying history in place
+   WrappedSpan GetSpan(int size, int samplesAgo, int channel);
+   //the next "size" slots to be written. fill them in, then CommitWrite() moves the write head past them
+   WrappedSpan GetWriteSpan(int size, int channel);
+   void CommitWrite(int size, int channel);
+
+   //fractional reads for a block of upcoming samples at a fixed delay: dst[i] is the sample "delaySamples" before sample i of the next chunk that will be written
+   //delaySamples must be at least size, or the read will hit samples that haven't been written yet
+   void ReadInterpolated(float* dst, int size, float delaySamples, int channel);
+   //fractional reads at an arbitrary (ramping, modulated) position per sample, relative to the current write head
+   void ReadInterpolated(float* dst, int size, const float* samplesAgo, int channel);
+
+   void Draw(int x, int y, int width, int height, int length = -1, int channel = -1, int delayOffset = 0);
+   ChannelBuffer* GetRawBuffer() { return &mBuffer; }
+   int GetRawBufferOffset(int channel) const { return mHead[channel]; }
+
+   void SaveState(FileStreamOut& out);
+   void LoadState(FileStreamIn& in);
+
+private:
+   void SyncChannelHead(int channel);
+
+   int mSize{ 0 };
+   int mMask{ 0 };
+   int mNominalSize{ 0 };
+   int mHead[ChannelBuffer::kMaxNumChannels]{};
+   ChannelBuffer mBuffer;
+};
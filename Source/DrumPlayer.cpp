@@ -140,21 +140,56 @@ void DrumPlayer::DrumHit::CreateUIControls(DrumPlayer* owner, int index)
 namespace
 {
    static std::list<std::string> sHitDirectories;
+   static int sHitDirectoriesGeneration{ 0 }; //bumped whenever sHitDirectories changes
+   static int sHitDirectoriesIndexGeneration{ -1 }; //the sample index's generation when sHitDirectories was last read from it
+
+   //from the sample index, or straight from disk if the index hasn't gotten to this directory yet
+   std::vector<std::string> GetSamplesInDirectory(const std::string& dirPath)
+   {
+      std::vector<std::string> files;
+      if (!TheSynth->GetSampleLibraryIndex()->GetSamples(dirPath, files))
+      {
+         auto dirContents = File(dirPath).findChildFiles(File::findFiles, false);
+         dirContents.sort();
+         for (auto file : dirContents)
+         {
+            if (file.getFileName()[0] != '.')
+               files.push_back(file.getFullPathName().toStdString());
+         }
+      }
+      return files;
+   }
 }
 
 //static
 void DrumPlayer::SetUpHitDirectories()
 {
-   sHitDirectories.clear();
+   sHitDirectoriesIndexGeneration = TheSynth->GetSampleLibraryIndex()->GetGeneration();
+
    File parentDirectory(ofToDataPath("drums"));
-   Array<File> hitDirs;
-   parentDirectory.findChildFiles(hitDirs, File::findDirectories, true);
-   for (auto dir : hitDirs)
+   std::vector<std::string> hitDirs;
+   if (!TheSynth->GetSampleLibraryIndex()->GetDirectoriesWithSamples(parentDirectory.getFullPathName().toStdString(), hitDirs))
    {
-      Array<File> filesInDir;
-      dir.findChildFiles(filesInDir, File::findFiles, false);
-      if (filesInDir.size() > 0)
-         sHitDirectories.push_back(dir.getRelativePathFrom(parentDirectory).replaceCharacter('\\', '/').toStdString());
+      if (!sHitDirectories.empty())
+         return; //keep what we have until the index catches up
+
+      //not indexed yet, so walk it ourselves this once
+      Array<File> dirs;
+      parentDirectory.findChildFiles(dirs, File::findDirectories, true);
+      for (auto dir : dirs)
+      {
+         Array<File> filesInDir;
+         dir.findChildFiles(filesInDir, File::findFiles, false);
+         if (filesInDir.size() > 0)
+            hitDirs.push_back(dir.getRelativePathFrom(parentDirectory).replaceCharacter('\\', '/').toStdString());
+      }
+   }
+
+   std::list<std::string> hitDirectories(hitDirs.begin(), hitDirs.end());
+   if (hitDirectories != sHitDirectories)
+   {
+      sHitDirectories = hitDirectories;
+      ++sHitDirectoriesGeneration;
    }
 }
 
@@ -176,6 +211,15 @@ void DrumPlayer::Poll()
    if (mNeedSetup)
       SetUpNewDrumPlayer();
 
+   if (sHitDirectoriesIndexGeneration != TheSynth->GetSampleLibraryIndex()->GetGeneration())
+      SetUpHitDirectories();
+   if (mHitDirectoriesGeneration != sHitDirectoriesGeneration)
+   {
+      mHitDirectoriesGeneration = sHitDirectoriesGeneration;
+      for (int i = 0; i < NUM_DRUM_HITS; ++i)
+         mDrumHits[i].UpdateHitDirectoryDropdown();
+   }
+
    UpdateLights();
 }
 
@@ -244,7 +288,7 @@ void DrumPlayer::LoadKit(int kit)
          mDrumHits[i].mVol = mKits[kit].mVols[i];
          mDrumHits[i].mSpeed = mKits[kit].mSpeeds[i];
          mDrumHits[i].mPan = mKits[kit].mPans[i];
-         mDrumHits[i].mEnvelopeLength = mDrumHits[i].mSample.LengthInSamples() * gInvSampleRateMs;
+         mDrumHits[i].mEnvelopeLength = mDrumHits[i].mSample.GetLengthMs();
       }
       LoadSampleUnlock();
    }
@@ -346,6 +390,7 @@ void DrumPlayer::DrumHit::StartPlayhead(double time, float startOffsetPercent, f
          mPlayheads[i].mStartTime = time;
          mPlayheads[i].mCutOffTime = -1;
          mPlayheads[i].mOffset = startOffsetPercent * mSample.LengthInSamples();
+         mPlayheads[i].mSampleRateRatio = mSample.GetSampleRateRatio();
          mPlayheads[i].mEnvelopeTime = 0;
          mPlayheads[i].mEnvelopeScale = ofLerp(.2f, 1, velocity);
          mPlayheads[i].mSpeedTweak = ofRandom(1 - mOwner->mSpeedRandomization, 1 + mOwner->mSpeedRandomization);
@@ -386,6 +431,15 @@ float DrumPlayer::DrumHit::GetPlayProgress(double time)
 
 bool DrumPlayer::DrumHit::Process(double time, float speed, float vol, ChannelBuffer* out, int bufferSize)
 {
+   for (size_t playhead = 0; playhead < mPlayheads.size(); ++playhead)
+   {
+      if (mPlayheads[playhead].mSampleRateRatio != mSample.GetSampleRateRatio()) //the sample finished converting to the session rate, move the playhead to the same spot in the converted data
+      {
+         mPlayheads[playhead].mOffset *= mPlayheads[playhead].mSampleRateRatio / mSample.GetSampleRateRatio();
+         mPlayheads[playhead].mSampleRateRatio = mSample.GetSampleRateRatio();
+      }
+   }
+
    ChannelBuffer* sampleData = mSample.Data();
    speed *= mSpeed;
 
@@ -551,7 +605,7 @@ void DrumPlayer::FilesDropped(std::vector<std::string> files, int x, int y)
                mDrumHits[sampleIdx].mVol = 1;
                mDrumHits[sampleIdx].mSpeed = 1;
                mDrumHits[sampleIdx].mPan = 0;
-               mDrumHits[sampleIdx].mEnvelopeLength = mDrumHits[sampleIdx].mSample.LengthInSamples() * gInvSampleRateMs;
+               mDrumHits[sampleIdx].mEnvelopeLength = mDrumHits[sampleIdx].mSample.GetLengthMs();
 
                mSelectedHitIdx = sampleIdx;
                UpdateVisibleControls();
@@ -611,7 +665,7 @@ void DrumPlayer::SetHitSample(int sampleIndex, Sample* sample)
    mDrumHits[sampleIndex].mVol = 1;
    mDrumHits[sampleIndex].mSpeed = 1;
    mDrumHits[sampleIndex].mPan = 0;
-   mDrumHits[sampleIndex].mEnvelopeLength = mDrumHits[sampleIndex].mSample.LengthInSamples() * gInvSampleRateMs;
+   mDrumHits[sampleIndex].mEnvelopeLength = mDrumHits[sampleIndex].mSample.GetLengthMs();
 }
 
 void DrumPlayer::OnClicked(float x, float y, bool right)
@@ -815,7 +869,7 @@ void DrumPlayer::DrumHit::DrawUIControls()
    mUseEnvelopeCheckbox->Draw();
    if (mUseEnvelope)
    {
-      mEnvelopeLengthSlider->SetExtents(10, mSample.LengthInSamples() * gInvSampleRateMs);
+      mEnvelopeLengthSlider->SetExtents(10, mSample.GetLengthMs());
       mEnvelopeLengthSlider->Draw();
       mEnvelopeDisplay->SetMaxTime(mEnvelopeLength);
       mEnvelopeDisplay->SetOverrideDrawTime(mPlayheads[mCurrentPlayheadIndex].mEnvelopeTime);
@@ -968,14 +1022,12 @@ void DrumPlayer::FloatSliderUpdated(FloatSlider* slider, float oldVal, double ti
    {
       mAuditionSampleIdx += mAuditionInc > 0 ? -1 : 1;
       mAuditionInc = 0;
-      File dir(mAuditionDir);
-      Array<File> files;
-      dir.findChildFiles(files, File::findFiles, false);
+      std::vector<std::string> files = GetSamplesInDirectory(mAuditionDir);
       if (files.size() > 0)
       {
-         mAuditionSampleIdx = ofClamp(mAuditionSampleIdx, 0, files.size() - 1);
+         mAuditionSampleIdx = ofClamp(mAuditionSampleIdx, 0, (int)files.size() - 1);
 
-         std::string file = files[mAuditionSampleIdx].getFullPathName().toStdString();
+         std::string file = files[mAuditionSampleIdx];
          if (mSelectedHitIdx >= 0 && mSelectedHitIdx < NUM_DRUM_HITS)
          {
             LoadSampleLock();
@@ -983,7 +1035,7 @@ void DrumPlayer::FloatSliderUpdated(FloatSlider* slider, float oldVal, double ti
             LoadSampleUnlock();
             mDrumHits[mSelectedHitIdx].StartPlayhead(time, 0, 1);
             mDrumHits[mSelectedHitIdx].mVelocity = .5f;
-            mDrumHits[mSelectedHitIdx].mEnvelopeLength = mDrumHits[mSelectedHitIdx].mSample.LengthInSamples() * gInvSampleRateMs;
+            mDrumHits[mSelectedHitIdx].mEnvelopeLength = mDrumHits[mSelectedHitIdx].mSample.GetLengthMs();
          }
       }
    }
@@ -1070,42 +1122,26 @@ void DrumPlayer::DrumHit::LoadSample(std::string path)
    mOwner->LoadSampleUnlock();
    //mSample.Play(gTime, mSpeed, 0);
    //mVelocity = .5f;
-   mEnvelopeLength = mSample.LengthInSamples() * gInvSampleRateMs;
+   mEnvelopeLength = mSample.GetLengthMs();
    for (size_t i = 0; i < mPlayheads.size(); ++i)
       mPlayheads[i].mStartTime = -1;
 }
 
 void DrumPlayer::DrumHit::LoadRandomSample()
 {
-   File dir(ofToDataPath("drums/" + mHitCategory));
-   Array<File> files;
-   for (auto file : dir.findChildFiles(File::findFiles, false))
-   {
-      if (file.getFileName()[0] != '.')
-         files.add(file);
-   }
-
+   std::vector<std::string> files = GetSamplesInDirectory(ofToDataPath("drums/" + mHitCategory));
    if (files.size() > 0)
-      LoadSample(files[gRandom() % files.size()].getFullPathName().toStdString());
+      LoadSample(files[gRandom() % files.size()]);
 }
 
 void DrumPlayer::DrumHit::LoadNextSample(int direction)
 {
-   File dir(ofToDataPath("drums/" + mHitCategory));
-   Array<File> files;
+   std::vector<std::string> files = GetSamplesInDirectory(ofToDataPath("drums/" + mHitCategory));
    int currentIndex = -1;
-   int i = 0;
-   auto dirContents = dir.findChildFiles(File::findFiles, false);
-   dirContents.sort();
-   for (auto file : dirContents)
+   for (int i = 0; i < (int)files.size(); ++i)
    {
-      if (file.getFileName()[0] != '.')
-      {
-         files.add(file);
-         if (mSample.GetReadPath() == file.getFullPathName().replace(GetPathSeparator(), "/"))
-            currentIndex = i;
-         ++i;
-      }
+      if (mSample.GetReadPath() == String(files[i]).replace(GetPathSeparator(), "/"))
+         currentIndex = i;
    }
 
    if (files.size() > 0)
@@ -1115,7 +1151,7 @@ void DrumPlayer::DrumHit::LoadNextSample(int direction)
          newIndex = 0;
       else
          newIndex = ofClamp(currentIndex + direction, 0, (int)files.size() - 1);
-      LoadSample(files[newIndex].getFullPathName().toStdString());
+      LoadSample(files[newIndex]);
    }
 }
 
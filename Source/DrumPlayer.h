@@ -151,6 +151,7 @@ private:
    float mAuditionInc{ 0 };
    FloatSlider* mAuditionSlider{ nullptr };
    std::string mAuditionDir;
+   int mHitDirectoriesGeneration{ -1 };
    char mNewKitName[MAX_TEXTENTRY_LENGTH]{};
    TextEntry* mNewKitNameEntry{ nullptr };
    ofMutex mLoadSamplesAudioMutex;
@@ -212,6 +213,7 @@ private:
          double mEnvelopeTime{ 0 };
          double mEnvelopeScale{ 1 };
          float mSpeedTweak{ 1 };
+         float mSampleRateRatio{ 1 }; //the sample rate ratio mOffset is in
       };
 
       DrumHit()
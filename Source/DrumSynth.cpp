@@ -306,7 +306,6 @@ DrumSynth::DrumSynthHit::DrumSynthHit(DrumSynth* parent, int index, int x, int y
 , mX(x)
 , mY(y)
 {
-   mFilter.SetFilterType(kFilterType_Lowpass);
    mFilter.SetFilterParams(1000, sqrt(2) / 2);
 }
 
@@ -389,14 +388,12 @@ void DrumSynth::DrumSynthHit::Process(double time, float* out, int bufferSize, i
       return;
    }
 
+   mFilter.SetSampleRate(sampleRate);
    for (size_t i = 0; i < bufferSize; ++i)
    {
       float freq = ofLerp(mData.mFreqMin, mData.mFreqMax, mData.mFreqAdsr.Value(time));
       if (mData.mCutoffMax != DRUMSYNTH_NO_CUTOFF)
-      {
-         mFilter.SetSampleRate(sampleRate);
          mFilter.SetFilterParams(ofLerp(mData.mCutoffMin, mData.mCutoffMax, mData.mFilterAdsr.Value(time)), mData.mQ);
-      }
       float phaseInc = GetPhaseInc(freq) / oversampling;
 
       float sample = mData.mTone.Audio(time, mPhase) * mData.mVol * mData.mVol;
@@ -39,7 +39,7 @@
 #include "ADSR.h"
 #include "RadioButton.h"
 #include "PeakTracker.h"
-#include "BiquadFilter.h"
+#include "StateVariableFilter.h"
 #include "TextEntry.h"
 #include "PatchCableSource.h"
 
@@ -137,7 +137,7 @@ private:
       int mIndex{ 0 };
       int mX{ 0 };
       int mY{ 0 };
-      BiquadFilter mFilter;
+      StateVariableFilter mFilter;
 
       IndividualOutput* mIndividualOutput{ nullptr };
    };
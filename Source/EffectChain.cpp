@@ -28,12 +28,12 @@
 #include "SynthGlobals.h"
 #include "ModularSynth.h"
 #include "Profiler.h"
+#include "BufferArena.h"
 
 const double gSwapLength = 150.0;
 
 EffectChain::EffectChain()
 : IAudioProcessor(gBufferSize)
-, mDryBuffer(gBufferSize)
 {
 }
 
@@ -125,17 +125,22 @@ void EffectChain::Process(double time)
 
    ComputeSliders(0);
    SyncBuffers();
-   mDryBuffer.SetNumActiveChannels(GetBuffer()->NumActiveChannels());
 
    int bufferSize = GetBuffer()->BufferSize();
 
+   mTailMs = 0;
    if (mEnabled)
    {
       mEffectMutex.lock();
 
+      ScratchBuffer dryBuffer(bufferSize, GetBuffer()->NumActiveChannels());
       for (int i = 0; i < mEffects.size(); ++i)
       {
-         mDryBuffer.CopyFrom(GetBuffer());
+         float tailMs = mEffects[i]->GetTailLengthMs();
+         mTailMs = (tailMs < 0 || mTailMs < 0) ? -1 : std::max(mTailMs, tailMs);
+
+         for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
+            BufferCopy(dryBuffer.Get(ch), GetBuffer()->GetChannel(ch), bufferSize);
 
          mEffects[i]->ProcessAudio(time, GetBuffer());
 
@@ -150,9 +155,9 @@ void EffectChain::Process(double time)
 
          for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
          {
-            Mult(mDryBuffer.GetChannel(ch), invDryWetBuffer, bufferSize);
+            Mult(dryBuffer.Get(ch), invDryWetBuffer, bufferSize);
             Mult(GetBuffer()->GetChannel(ch), dryWetBuffer, bufferSize);
-            Add(GetBuffer()->GetChannel(ch), mDryBuffer.GetChannel(ch), bufferSize);
+            Add(GetBuffer()->GetChannel(ch), dryBuffer.Get(ch), bufferSize);
          }
       }
 
@@ -169,6 +174,8 @@ void EffectChain::Process(double time)
       GetVizBuffer()->WriteChunk(buffer, bufferSize, ch);
    }
 
+   mOutputSilent = IsSilent(GetBuffer());
+
    GetBuffer()->Reset();
 }
 
@@ -60,6 +60,10 @@ public:
    //IAudioSource
    void Process(double time) override;
 
+   //IAudioProcessor
+   float GetSilenceTailMs() override { return mTailMs; }
+   bool IsOutputSilent() override { return mOutputSilent; }
+
    void KeyPressed(int key, bool isRepeat) override;
    void KeyReleased(int key) override;
 
@@ -102,7 +106,6 @@ private:
    };
 
    std::vector<IAudioEffect*> mEffects{};
-   ChannelBuffer mDryBuffer;
    std::vector<EffectControls> mEffectControls;
    std::array<float, MAX_EFFECTS_IN_CHAIN> mDryWetLevels{};
 
@@ -117,6 +120,8 @@ private:
    bool mInitialized{ false };
    bool mShowSpawnList{ true };
    int mWantToDeleteEffectAtIndex{ -1 };
+   float mTailMs{ -1 };
+   bool mOutputSilent{ false };
    IAudioEffect* mPush2DisplayEffect{ nullptr };
 
    std::vector<std::string> mEffectTypesToSpawn;
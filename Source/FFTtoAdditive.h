@@ -35,6 +35,7 @@
 #include "Slider.h"
 #include "GateEffect.h"
 #include "BiquadFilterEffect.h"
+#include "AdditiveOscillatorBank.h"
 
 #define VIZ_WIDTH 1000
 #define RAZOR_HISTORY 100
@@ -70,7 +71,6 @@ public:
 
 private:
    void DrawViz();
-   float SinSample(float phase);
 
    //IDrawableModule
    void DrawModule() override;
@@ -105,7 +105,8 @@ private:
 
    float mPeakHistory[RAZOR_HISTORY][VIZ_WIDTH + 1]{};
    int mHistoryPtr{ 0 };
-   float* mPhaseInc{ nullptr };
+   float* mPartialFreqs{ nullptr };
+   AdditiveOscillatorBank mOscillators;
 };
 
 #endif /* defined(__modularSynth__FFTtoAdditive__) */
@@ -30,6 +30,7 @@
 #include "Profiler.h"
 #include "ChannelBuffer.h"
 #include "PolyphonyMgr.h"
+#include "BufferArena.h"
 
 FMVoice::FMVoice(IDrawableModule* owner)
 : mOwner(owner)
@@ -45,6 +46,11 @@ bool FMVoice::IsDone(double time)
    return mOsc.GetADSR()->IsDone(time);
 }
 
+bool FMVoice::IsReleasedBelow(double time, float level)
+{
+   return mOsc.GetADSR()->IsReleasedBelow(time, level);
+}
+
 bool FMVoice::Process(double time, ChannelBuffer* out, int oversampling)
 {
    PROFILER(FMVoice);
@@ -66,12 +72,19 @@ bool FMVoice::Process(double time, ChannelBuffer* out, int oversampling)
       sampleIncrementMs /= oversampling;
    }
 
+   //look up the whole block's frequencies at once
+   ScratchBuffer pitchBuffer(out->BufferSize(), 2);
+   float* freqs = pitchBuffer.Get(1);
+   for (int i = 0; i < out->BufferSize(); ++i)
+      pitchBuffer.Get(0)[i] = GetPitch(i);
+   TheScale->PitchToFreq(pitchBuffer.Get(0), freqs, out->BufferSize());
+
    for (int pos = 0; pos < bufferSize; ++pos)
    {
       if (mOwner)
          mOwner->ComputeSliders(pos / oversampling);
 
-      float oscFreq = TheScale->PitchToFreq(GetPitch(pos / oversampling));
+      float oscFreq = freqs[pos / oversampling];
       float harmFreq = oscFreq * mHarm.GetADSR()->Value(time) * mVoiceParams->mHarmRatio;
       float harmFreq2 = harmFreq * mHarm2.GetADSR()->Value(time) * mVoiceParams->mHarmRatio2;
 
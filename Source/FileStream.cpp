@@ -28,9 +28,24 @@
 
 #include "juce_core/juce_core.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
 //static
 bool FileStreamIn::s32BitMode = false;
 
+namespace
+{
+   const std::int64_t kPrefetchMinFileSize = 16 << 20;
+   const std::int64_t kPrefetchAhead = 256 << 20; //how far past the read position the prefetch thread is allowed to get
+   const std::int64_t kPrefetchChunk = 1 << 20;
+   const std::int64_t kPageSize = 4096;
+   const std::int64_t kParallelCopyMinSize = 16 << 20; //reads larger than this (long sample and looper buffers) are split across threads
+   const int kMaxCopyThreads = 8;
+}
+
 FileStreamOut::FileStreamOut(const std::string& file)
 : mStream(std::make_unique<juce::FileOutputStream>(juce::File{ file }))
 {
@@ -44,11 +59,40 @@ FileStreamOut::~FileStreamOut()
 }
 
 FileStreamIn::FileStreamIn(const std::string& file)
-: mStream(std::make_unique<juce::FileInputStream>(juce::File{ file }))
 {
+   juce::File inputFile{ file };
+   if (!inputFile.existsAsFile())
+      return;
+
+   mOpenedOk = true;
+   mSize = inputFile.getSize();
+   if (mSize == 0)
+      return;
+
+   mMappedFile = std::make_unique<juce::MemoryMappedFile>(inputFile, juce::MemoryMappedFile::readOnly);
+   if (mMappedFile->getData() != nullptr && (std::int64_t)mMappedFile->getSize() == mSize)
+   {
+      mData = static_cast<const char*>(mMappedFile->getData());
+   }
+   else
+   {
+      mMappedFile.reset();
+      mFallbackData = std::make_unique<juce::MemoryBlock>();
+      mOpenedOk = inputFile.loadFileAsData(*mFallbackData);
+      mData = static_cast<const char*>(mFallbackData->getData());
+      mSize = (std::int64_t)mFallbackData->getSize();
+   }
+
+   if (mMappedFile != nullptr && mSize >= kPrefetchMinFileSize)
+      mPrefetchThread = std::thread([this] { Prefetch(); });
 }
 
-FileStreamIn::~FileStreamIn() = default;
+FileStreamIn::~FileStreamIn()
+{
+   mStopPrefetch = true;
+   if (mPrefetchThread.joinable())
+      mPrefetchThread.join();
+}
 
 FileStreamOut& FileStreamOut::operator<<(const int& var)
 {
@@ -104,33 +148,38 @@ void FileStreamOut::WriteGeneric(const void* buffer, int size)
    mStream->write(buffer, size);
 }
 
+std::int64_t FileStreamOut::GetPosition() const
+{
+   return mStream->getPosition();
+}
+
 FileStreamIn& FileStreamIn::operator>>(int& var)
 {
-   mStream->read(&var, sizeof(int));
+   ReadBytes(&var, sizeof(int));
    return *this;
 }
 
 FileStreamIn& FileStreamIn::operator>>(uint32_t& var)
 {
-   mStream->read(&var, sizeof(uint32_t));
+   ReadBytes(&var, sizeof(uint32_t));
    return *this;
 }
 
 FileStreamIn& FileStreamIn::operator>>(bool& var)
 {
-   mStream->read(&var, sizeof(bool));
+   ReadBytes(&var, sizeof(bool));
    return *this;
 }
 
 FileStreamIn& FileStreamIn::operator>>(float& var)
 {
-   mStream->read(&var, sizeof(float));
+   ReadBytes(&var, sizeof(float));
    return *this;
 }
 
 FileStreamIn& FileStreamIn::operator>>(double& var)
 {
-   mStream->read(&var, sizeof(double));
+   ReadBytes(&var, sizeof(double));
    return *this;
 }
 
@@ -140,12 +189,12 @@ FileStreamIn& FileStreamIn::operator>>(std::string& var)
    if (s32BitMode)
    {
       uint32_t len32;
-      mStream->read(&len32, sizeof(len32));
+      ReadBytes(&len32, sizeof(len32));
       len = len32;
    }
    else
    {
-      mStream->read(&len, sizeof(len));
+      ReadBytes(&len, sizeof(len));
    }
 
    if (TheSynth->IsLoadingModule())
@@ -154,44 +203,102 @@ FileStreamIn& FileStreamIn::operator>>(std::string& var)
       assert(len < sMaxStringLength); //probably garbage beyond this point
 
    var.resize(len);
-   mStream->read(var.data(), len);
+   ReadBytes(var.data(), len);
    return *this;
 }
 
 FileStreamIn& FileStreamIn::operator>>(char& var)
 {
-   mStream->read(&var, sizeof(char));
+   ReadBytes(&var, sizeof(char));
    return *this;
 }
 
 void FileStreamIn::Read(float* buffer, int size)
 {
-   mStream->read(buffer, sizeof(float) * size);
+   ReadBytes(buffer, sizeof(float) * (std::int64_t)size);
 }
 
 void FileStreamIn::ReadGeneric(void* buffer, int size)
 {
-   mStream->read(buffer, size);
+   ReadBytes(buffer, size);
 }
 
 void FileStreamIn::Peek(void* buffer, int size)
 {
-   auto pos = mStream->getPosition();
-   mStream->read(buffer, size);
-   mStream->setPosition(pos);
+   auto pos = GetPosition();
+   ReadBytes(buffer, size);
+   Seek(pos);
 }
 
 bool FileStreamIn::Eof() const
 {
-   return mStream->isExhausted();
+   return GetPosition() >= mSize;
 }
 
 int FileStreamIn::GetFilePosition() const
 {
-   return int(mStream->getPosition());
+   return int(GetPosition());
 }
 
 bool FileStreamIn::OpenedOk() const
 {
-   return mStream->openedOk();
+   return mOpenedOk;
+}
+
+void FileStreamIn::Prefetch()
+{
+   std::int64_t prefetched = 0;
+   volatile char sink = 0;
+   while (!mStopPrefetch && prefetched < mSize)
+   {
+      if (prefetched > GetPosition() + kPrefetchAhead)
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(2));
+         continue;
+      }
+
+      prefetched = std::max(prefetched, GetPosition());
+      std::int64_t end = std::min(prefetched + kPrefetchChunk, mSize);
+      for (std::int64_t i = prefetched; i < end; i += kPageSize)
+         sink = sink + mData[i];
+      prefetched = end;
+   }
+}
+
+void FileStreamIn::ReadBytes(void* buffer, std::int64_t size)
+{
+   std::int64_t position = GetPosition();
+   size = std::max<std::int64_t>(0, std::min(size, mSize - position));
+   if (size == 0)
+      return;
+
+   const char* src = mData + position;
+   char* dst = static_cast<char*>(buffer);
+   if (size >= kParallelCopyMinSize)
+   {
+      //copying out of the map is what actually pulls pages off the disk, so several threads keep more reads in flight
+      int numThreads = juce::jlimit(1, kMaxCopyThreads, juce::SystemStats::getNumCpus());
+      std::int64_t chunk = (size / numThreads + kPageSize - 1) / kPageSize * kPageSize;
+      std::vector<std::thread> threads;
+      for (int i = 1; i < numThreads && i * chunk < size; ++i)
+      {
+         std::int64_t start = i * chunk;
+         std::int64_t length = std::min(chunk, size - start);
+         threads.emplace_back([=] { memcpy(dst + start, src + start, length); });
+      }
+      memcpy(dst, src, std::min(chunk, size));
+      for (auto& thread : threads)
+         thread.join();
+   }
+   else
+   {
+      memcpy(dst, src, size);
+   }
+
+   mPosition.store(position + size, std::memory_order_relaxed);
+}
+
+void FileStreamIn::Seek(std::int64_t position)
+{
+   mPosition.store(juce::jlimit<std::int64_t>(0, mSize, position), std::memory_order_relaxed);
 }
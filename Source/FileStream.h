@@ -26,14 +26,17 @@
 #ifndef __Bespoke__FileStream__
 #define __Bespoke__FileStream__
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <thread>
 
 namespace juce
 {
-   class FileInputStream;
    class FileOutputStream;
+   class MemoryMappedFile;
+   class MemoryBlock;
 }
 
 class FileStreamOut
@@ -51,6 +54,7 @@ public:
    FileStreamOut& operator<<(const char& var);
    void Write(const float* buffer, int size);
    void WriteGeneric(const void* buffer, int size);
+   std::int64_t GetPosition() const;
 
 private:
    std::unique_ptr<juce::FileOutputStream> mStream;
@@ -73,13 +77,29 @@ public:
    void ReadGeneric(void* buffer, int size);
    void Peek(void* buffer, int size);
    int GetFilePosition() const;
+   std::int64_t GetPosition() const { return mPosition.load(std::memory_order_relaxed); }
+   std::int64_t GetSize() const { return mSize; }
+   void Seek(std::int64_t position);
    bool OpenedOk() const;
    bool Eof() const;
    static bool s32BitMode;
    static const int sMaxStringLength = 999999; //the primary thing that might hit this limit is the json layout file (one user has had a file that exceeded a length of 100000)
 
 private:
-   std::unique_ptr<juce::FileInputStream> mStream;
+   void ReadBytes(void* buffer, std::int64_t size);
+   void Prefetch();
+
+   //the file is memory-mapped, so reads are plain copies and the OS pages data in as we go
+   std::unique_ptr<juce::MemoryMappedFile> mMappedFile;
+   std::unique_ptr<juce::MemoryBlock> mFallbackData; //if mapping fails, the whole file is read up front
+   const char* mData{ nullptr };
+   std::int64_t mSize{ 0 };
+   std::atomic<std::int64_t> mPosition{ 0 };
+   bool mOpenedOk{ false };
+
+   //for big files, a background thread touches pages ahead of the read position so disk reads overlap with deserializing
+   std::thread mPrefetchThread;
+   std::atomic<bool> mStopPrefetch{ false };
 };
 
 #endif /* defined(__Bespoke__FileStream__) */
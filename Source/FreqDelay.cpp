@@ -26,11 +26,11 @@
 #include "FreqDelay.h"
 #include "ModularSynth.h"
 #include "Profiler.h"
+#include "BufferArena.h"
 #include "Scale.h"
 
 FreqDelay::FreqDelay()
 : IAudioProcessor(gBufferSize)
-, mDryBuffer(gBufferSize)
 {
    AddChild(&mDelayEffect);
    mDelayEffect.SetPosition(5, 30);
@@ -60,18 +60,19 @@ void FreqDelay::Process(double time)
       return;
 
    SyncBuffers();
-   mDryBuffer.SetNumActiveChannels(GetBuffer()->NumActiveChannels());
 
    int bufferSize = GetBuffer()->BufferSize();
 
-   mDryBuffer.CopyFrom(GetBuffer());
+   ScratchBuffer dryBuffer(bufferSize, GetBuffer()->NumActiveChannels());
+   for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
+      BufferCopy(dryBuffer.Get(ch), GetBuffer()->GetChannel(ch), bufferSize);
    mDelayEffect.ProcessAudio(time, GetBuffer());
 
    for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
    {
-      Mult(mDryBuffer.GetChannel(ch), (1 - mDryWet), bufferSize);
+      Mult(dryBuffer.Get(ch), (1 - mDryWet), bufferSize);
       Mult(GetBuffer()->GetChannel(ch), mDryWet, bufferSize);
-      Add(GetBuffer()->GetChannel(ch), mDryBuffer.GetChannel(ch), bufferSize);
+      Add(GetBuffer()->GetChannel(ch), dryBuffer.Get(ch), bufferSize);
       Add(target->GetBuffer()->GetChannel(ch), GetBuffer()->GetChannel(ch), bufferSize);
       GetVizBuffer()->WriteChunk(GetBuffer()->GetChannel(ch), bufferSize, ch);
    }
@@ -68,7 +68,6 @@ private:
       height = 120;
    }
 
-   ChannelBuffer mDryBuffer;
    float mDryWet{ 1 };
    FloatSlider* mDryWetSlider{ nullptr };
 
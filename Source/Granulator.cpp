@@ -29,6 +29,11 @@
 #include "ChannelBuffer.h"
 #include "juce_dsp/maths/juce_FastMathApproximations.h"
 
+namespace
+{
+   const int kRenderChunkSize = 64;
+}
+
 Granulator::Granulator()
 {
    Reset();
@@ -56,23 +61,144 @@ void Granulator::Reset()
 
 void Granulator::ProcessFrame(double time, ChannelBuffer* buffer, int bufferLength, double offset, float* output)
 {
-   if (time + gInvSampleRateMs >= mNextGrainSpawnMs)
+   float* outputs[ChannelBuffer::kMaxNumChannels];
+   for (int ch = 0; ch < ChannelBuffer::kMaxNumChannels; ++ch)
+      outputs[ch] = &output[ch];
+   Render(time, buffer, bufferLength, offset, 0, outputs, 1);
+}
+
+void Granulator::ProcessBlock(double time, ChannelBuffer* buffer, int bufferLength, double offset, double offsetIncrement, ChannelBuffer* output, int size)
+{
+   assert(size <= output->BufferSize());
+
+   float* outputs[ChannelBuffer::kMaxNumChannels];
+   for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
+      outputs[ch] = output->GetChannel(ch);
+   Render(time, buffer, bufferLength, offset, offsetIncrement, outputs, size);
+}
+
+void Granulator::Render(double time, ChannelBuffer* buffer, int bufferLength, double offset, double offsetIncrement, float* const* output, int size)
+{
+   int numChannels = buffer->NumActiveChannels();
+   for (int ch = 0; ch < numChannels; ++ch)
+      Clear(output[ch], size);
+
+   //grains are rendered in segments, split wherever a new grain spawns
+   int segmentStart = 0;
+   for (int i = 0; i < size; ++i)
    {
-      double startFromMs = mNextGrainSpawnMs;
-      if (startFromMs < time - 1000) //must have recently started processing, reset
-         startFromMs = time;
-      SpawnGrain(mNextGrainSpawnMs, offset, buffer->NumActiveChannels() == 2 ? mWidth : 0);
-      mNextGrainSpawnMs = startFromMs + mGrainLengthMs * 1 / mGrainOverlap * ofRandom(1 - mSpacingRandomize / 2, 1 + mSpacingRandomize / 2);
+      double sampleTime = time + i * gInvSampleRateMs;
+      if (sampleTime + gInvSampleRateMs >= mNextGrainSpawnMs)
+      {
+         RenderGrains(time, segmentStart, i, buffer, bufferLength, output);
+         segmentStart = i;
+
+         double startFromMs = mNextGrainSpawnMs;
+         if (startFromMs < sampleTime - 1000) //must have recently started processing, reset
+            startFromMs = sampleTime;
+         SpawnGrain(mNextGrainSpawnMs, offset + i * offsetIncrement, numChannels == 2 ? mWidth : 0);
+         mNextGrainSpawnMs = startFromMs + mGrainLengthMs * 1 / mGrainOverlap * ofRandom(1 - mSpacingRandomize / 2, 1 + mSpacingRandomize / 2);
+      }
    }
+   RenderGrains(time, segmentStart, size, buffer, bufferLength, output);
 
-   for (int i = 0; i < MAX_GRAINS; ++i)
-      mGrains[i].Process(time, buffer, bufferLength, output);
+   float overlapGain = 1;
+   if (mGrainOverlap > 4)
+      overlapGain = ofMap(MIN(mGrainOverlap, MAX_GRAINS), MAX_GRAINS, 4, .5f, 1); //lower volume on dense granulation, starting at 4 overlap
+   if (mGrainOverlap > MAX_GRAINS)
+      overlapGain *= sqrtf(MAX_GRAINS / mGrainOverlap); //denser than that, compensate for summing uncorrelated grains
 
-   for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
+   for (int ch = 0; ch < numChannels; ++ch)
    {
-      if (mGrainOverlap > 4)
-         output[ch] *= ofMap(mGrainOverlap, MAX_GRAINS, 4, .5f, 1); //lower volume on dense granulation, starting at 4 overlap
-      output[ch] = mBiquad[ch].Filter(output[ch]);
+      if (overlapGain != 1)
+         Mult(output[ch], overlapGain, size);
+      mBiquad[ch].Filter(output[ch], size);
+   }
+}
+
+void Granulator::RenderGrains(double time, int start, int end, ChannelBuffer* buffer, int bufferLength, float* const* output)
+{
+   if (start >= end || bufferLength <= 0)
+      return;
+
+   int numChannels = buffer->NumActiveChannels();
+   bool stereoSource = numChannels == 2;
+   const float* src0 = buffer->GetChannel(0);
+   const float* src1 = stereoSource ? buffer->GetChannel(1) : src0;
+   double segmentStartTime = time + start * gInvSampleRateMs;
+   double segmentEndTime = time + end * gInvSampleRateMs;
+
+   int g = 0;
+   while (g < mNumActiveGrains)
+   {
+      //range of samples in this segment where the grain is sounding
+      int first = start;
+      if (mGrainStartTime[g] > segmentStartTime)
+         first = start + (int)ceil((mGrainStartTime[g] - segmentStartTime) * gSampleRateMs);
+      int last = end;
+      if (mGrainEndTime[g] < segmentEndTime)
+         last = MIN(end, start + (int)floor((mGrainEndTime[g] - segmentStartTime) * gSampleRateMs) + 1);
+
+      if (first < last)
+      {
+         const double posIncrement = mGrainSpeedMult[g] * mSpeed;
+         const float phaseIncrement = gInvSampleRateMs * mGrainStartToEndInv[g];
+         const float vol = mGrainVol[g];
+         float blend[ChannelBuffer::kMaxNumChannels];
+         float panGain[ChannelBuffer::kMaxNumChannels];
+         for (int ch = 0; ch < numChannels; ++ch)
+         {
+            blend[ch] = std::clamp(ch + mGrainStereoPosition[g], 0.f, 1.f);
+            panGain[ch] = vol * (1 + (ch == 0 ? mGrainStereoPosition[g] : -mGrainStereoPosition[g]));
+         }
+
+         double readPos = mGrainPos[g];
+         FloatWrap(readPos, bufferLength);
+         float phase = (time + first * gInvSampleRateMs - mGrainStartTime[g]) * mGrainStartToEndInv[g];
+
+         for (int chunkStart = first; chunkStart < last; chunkStart += kRenderChunkSize)
+         {
+            int chunkSize = MIN(kRenderChunkSize, last - chunkStart);
+            float window[kRenderChunkSize];
+            float sample0[kRenderChunkSize];
+            float sample1[kRenderChunkSize];
+
+            //hann window, with the cosine approximation kept to the -pi..pi range where it is accurate
+            for (int k = 0; k < chunkSize; ++k)
+               window[k] = .5f * (1 + juce::dsp::FastMathApproximations::cos<float>((phase + k * phaseIncrement) * FTWO_PI - FPI));
+            phase += chunkSize * phaseIncrement;
+
+            for (int k = 0; k < chunkSize; ++k)
+            {
+               readPos += posIncrement;
+               if (readPos >= bufferLength)
+                  readPos -= bufferLength;
+               else if (readPos < 0)
+                  readPos += bufferLength;
+               int pos = int(readPos);
+               int posNext = pos + 1 < bufferLength ? pos + 1 : 0;
+               float a = readPos - pos;
+               sample0[k] = src0[pos] + a * (src0[posNext] - src0[pos]);
+               sample1[k] = src1[pos] + a * (src1[posNext] - src1[pos]);
+            }
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+               float* out = output[ch] + chunkStart;
+               const float b = blend[ch];
+               const float gain = panGain[ch];
+               for (int k = 0; k < chunkSize; ++k)
+                  out[k] += (sample0[k] + b * (sample1[k] - sample0[k])) * window[k] * gain;
+            }
+         }
+
+         mGrainPos[g] += (last - first) * posIncrement;
+      }
+
+      if (mGrainEndTime[g] < segmentEndTime)
+         RemoveGrain(g); //moves the last active grain into this slot, so don't advance
+      else
+         ++g;
    }
 }
 
@@ -104,67 +230,70 @@ void Granulator::SpawnGrain(double time, double offset, float width)
       }
    }
    offset += ofRandom(-mPosRandomizeMs, mPosRandomizeMs) / gInvSampleRateMs;
-   mGrains[mNextGrainIdx].Spawn(this, time, offset, speedMult, mGrainLengthMs, vol, width);
 
-   mNextGrainIdx = (mNextGrainIdx + 1) % MAX_GRAINS;
-}
+   int idx = mNumActiveGrains;
+   if (idx == kMaxGrains) //all in use, steal the oldest
+   {
+      idx = 0;
+      for (int i = 1; i < mNumActiveGrains; ++i)
+      {
+         if (mGrainStartTime[i] < mGrainStartTime[idx])
+            idx = i;
+      }
+   }
+   else
+   {
+      ++mNumActiveGrains;
+   }
 
-void Granulator::Draw(float x, float y, float w, float h, int bufferStart, int viewLength, int bufferLength)
-{
-   for (int i = 0; i < MAX_GRAINS; ++i)
-      mGrains[i].DrawGrain(i, x, y, w, h, bufferStart, viewLength, bufferLength);
+   mGrainPos[idx] = offset;
+   mGrainSpeedMult[idx] = speedMult;
+   mGrainStartTime[idx] = time;
+   mGrainEndTime[idx] = time + mGrainLengthMs;
+   mGrainStartToEndInv[idx] = 1.0 / (mGrainEndTime[idx] - mGrainStartTime[idx]);
+   mGrainVol[idx] = vol;
+   mGrainStereoPosition[idx] = ofRandom(-width, width);
+   mGrainDrawPos[idx] = ofRandom(1);
 }
 
-void Granulator::ClearGrains()
+void Granulator::RemoveGrain(int idx)
 {
-   for (int i = 0; i < MAX_GRAINS; ++i)
-      mGrains[i].Clear();
+   int last = mNumActiveGrains - 1;
+   mGrainPos[idx] = mGrainPos[last];
+   mGrainSpeedMult[idx] = mGrainSpeedMult[last];
+   mGrainStartTime[idx] = mGrainStartTime[last];
+   mGrainEndTime[idx] = mGrainEndTime[last];
+   mGrainStartToEndInv[idx] = mGrainStartToEndInv[last];
+   mGrainVol[idx] = mGrainVol[last];
+   mGrainStereoPosition[idx] = mGrainStereoPosition[last];
+   mGrainDrawPos[idx] = mGrainDrawPos[last];
+   mNumActiveGrains = last;
 }
 
-void Grain::Spawn(Granulator* owner, double time, double pos, float speedMult, float lengthInMs, float vol, float width)
+double Granulator::GetWindow(int idx, double time) const
 {
-   mOwner = owner;
-   mPos = pos;
-   mSpeedMult = speedMult;
-   mStartTime = time;
-   mEndTime = time + lengthInMs;
-   mStartToEnd = mEndTime - mStartTime;
-   mStartToEndInv = 1.0 / mStartToEnd;
-   mVol = vol;
-   mStereoPosition = ofRandom(-width, width);
-   mDrawPos = ofRandom(1);
+   double phase = (time - mGrainStartTime[idx]) * mGrainStartToEndInv[idx];
+   return .5 * (1 - cos(phase * TWO_PI));
 }
 
-
-inline double Grain::GetWindow(double time)
-{
-   double phase = (time - mStartTime) * mStartToEndInv;
-   return .5 * (1 - juce::dsp::FastMathApproximations::cos<double>(phase * TWO_PI));
-}
-
-void Grain::Process(double time, ChannelBuffer* buffer, int bufferLength, float* output)
+void Granulator::Draw(float x, float y, float w, float h, int bufferStart, int viewLength, int bufferLength)
 {
-   if (time >= mStartTime && time <= mEndTime && mVol != 0)
+   ofPushStyle();
+   ofFill();
+   int numGrains = mNumActiveGrains;
+   for (int i = 0; i < numGrains; ++i)
    {
-      mPos += mSpeedMult * mOwner->mSpeed;
-      float window = GetWindow(time);
-      for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
-      {
-         float sample = GetInterpolatedSample(mPos, buffer, bufferLength, std::clamp(ch + mStereoPosition, 0.f, 1.f));
-         output[ch] += sample * window * mVol * (1 + (ch == 0 ? mStereoPosition : -mStereoPosition));
-      }
+      float a = fmod((mGrainPos[i] - bufferStart), bufferLength) / viewLength;
+      if (a < 0 || a > 1)
+         continue;
+      float alpha = GetWindow(i, std::clamp(gTime, mGrainStartTime[i], mGrainEndTime[i]));
+      ofSetColor(255, 0, 0, alpha * 255);
+      ofCircle(x + a * w, y + mGrainDrawPos[i] * h, MAX(3, h / MAX_GRAINS / 2));
    }
+   ofPopStyle();
 }
 
-void Grain::DrawGrain(int idx, float x, float y, float w, float h, int bufferStart, int viewLength, int bufferLength)
+void Granulator::ClearGrains()
 {
-   float a = fmod((mPos - bufferStart), bufferLength) / viewLength;
-   if (a < 0 || a > 1)
-      return;
-   ofPushStyle();
-   ofFill();
-   float alpha = GetWindow(std::clamp(gTime, mStartTime, mEndTime));
-   ofSetColor(255, 0, 0, alpha * 255);
-   ofCircle(x + a * w, y + mDrawPos * h, MAX(3, h / MAX_GRAINS / 2));
-   ofPopStyle();
+   mNumActiveGrains = 0;
 }
@@ -31,41 +31,22 @@
 #include "BiquadFilter.h"
 #include "ChannelBuffer.h"
 
-#define MAX_GRAINS 32
-
-class Granulator;
-
-class Grain
-{
-public:
-   void Spawn(Granulator* owner, double time, double pos, float speedMult, float lengthInMs, float vol, float width);
-   void Process(double time, ChannelBuffer* buffer, int bufferLength, float* output);
-   void DrawGrain(int idx, float x, float y, float w, float h, int bufferStart, int viewLength, int bufferLength);
-   void Clear() { mVol = 0; }
-
-private:
-   double GetWindow(double time);
-   double mPos{ 0 };
-   float mSpeedMult{ 1 };
-   double mStartTime{ 0 };
-   double mEndTime{ 1 };
-   double mStartToEnd{ 1 }, mStartToEndInv{ 1 };
-   float mVol{ 0 };
-   float mStereoPosition{ 0 };
-   float mDrawPos{ .5 };
-   Granulator* mOwner{ nullptr };
-};
+#define MAX_GRAINS 32 //overlap range of the standard granulator controls
 
 class Granulator
 {
 public:
    Granulator();
    void ProcessFrame(double time, ChannelBuffer* buffer, int bufferLength, double offset, float* output);
+   //renders a block of grains into output (overwriting it), for each channel in the source buffer. offset moves by offsetIncrement per sample
+   void ProcessBlock(double time, ChannelBuffer* buffer, int bufferLength, double offset, double offsetIncrement, ChannelBuffer* output, int size);
    void Draw(float x, float y, float w, float h, int bufferStart, int viewLength, int bufferLength);
    void Reset();
    void ClearGrains();
    void SetLiveMode(bool live) { mLiveMode = live; }
 
+   static const int kMaxGrains = 256;
+
    float mSpeed{ 1 };
    float mGrainLengthMs{ 60 };
    float mGrainOverlap{ 10 };
@@ -76,13 +57,26 @@ public:
    float mWidth{ 1 };
 
 private:
+   void Render(double time, ChannelBuffer* buffer, int bufferLength, double offset, double offsetIncrement, float* const* output, int size);
+   void RenderGrains(double time, int start, int end, ChannelBuffer* buffer, int bufferLength, float* const* output);
    void SpawnGrain(double time, double offset, float width);
+   void RemoveGrain(int idx);
+   double GetWindow(int idx, double time) const;
 
    double mNextGrainSpawnMs{ 0 };
-   int mNextGrainIdx{ 0 };
-   Grain mGrains[MAX_GRAINS]{};
    bool mLiveMode{ false };
    BiquadFilter mBiquad[ChannelBuffer::kMaxNumChannels]{};
+
+   //grain state is kept as parallel arrays, with the active grains packed at the front
+   int mNumActiveGrains{ 0 };
+   double mGrainPos[kMaxGrains]{};
+   float mGrainSpeedMult[kMaxGrains]{};
+   double mGrainStartTime[kMaxGrains]{};
+   double mGrainEndTime[kMaxGrains]{};
+   double mGrainStartToEndInv[kMaxGrains]{};
+   float mGrainVol[kMaxGrains]{};
+   float mGrainStereoPosition[kMaxGrains]{};
+   float mGrainDrawPos[kMaxGrains]{};
 };
 
 #endif /* defined(__modularSynth__Granulator__) */
@@ -36,6 +36,7 @@ public:
    virtual void ProcessAudio(double time, ChannelBuffer* buffer) = 0;
    void SetEnabled(bool enabled) override = 0;
    virtual float GetEffectAmount() { return 0; }
+   virtual float GetTailLengthMs() { return -1; } //how long the effect's state outlasts silent input, so an effect chain knows when it can sleep. -1 if it can make sound on its own
    virtual std::string GetType() = 0;
    bool CanMinimize() override { return false; }
    bool IsSaveable() override { return false; }
@@ -26,6 +26,12 @@
 */
 
 #include "IAudioProcessor.h"
+#include "UserPrefs.h"
+
+namespace
+{
+   const float kSilenceThreshold = 1e-6f; //-120dB
+}
 
 void IAudioProcessor::SyncBuffers(int overrideNumOutputChannels)
 {
@@ -37,3 +43,52 @@ void IAudioProcessor::SyncBuffers(int overrideNumOutputChannels)
 
    SyncOutputBuffer(numOutputChannels);
 }
+
+void IAudioProcessor::ProcessOrSleep(double time)
+{
+   if (!UserPrefs.sleep_silent_modules.Get())
+   {
+      mSleeping = false;
+      Process(time);
+      return;
+   }
+
+   //upstream sources have already summed into our input by now, so this is the whole block we're about to process
+   bool inputSilent = IsSilent(GetBuffer());
+
+   if (mSleeping)
+   {
+      if (inputSilent)
+      {
+         GetBuffer()->Reset(); //consume anything under the threshold, like Process() would have
+         return;
+      }
+      mSleeping = false;
+   }
+
+   Process(time);
+
+   float tailMs = GetSilenceTailMs();
+   if (tailMs >= 0 && inputSilent && IsOutputSilent())
+   {
+      mSilentSamples += GetBuffer()->BufferSize();
+      //also stay awake until Process() has flushed the viz buffer with silence, or cables keep drawing the last audio
+      if (mSilentSamples >= std::max(tailMs * gSampleRateMs, double(GetVizBuffer()->Size())))
+         mSleeping = true;
+   }
+   else
+   {
+      mSilentSamples = 0;
+   }
+}
+
+//static
+bool IAudioProcessor::IsSilent(ChannelBuffer* buffer)
+{
+   for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
+   {
+      if (GetPeakLevel(buffer->GetChannel(ch), buffer->BufferSize()) >= kSilenceThreshold)
+         return false;
+   }
+   return true;
+}
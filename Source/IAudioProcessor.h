@@ -37,6 +37,18 @@ public:
    : IAudioReceiver(bufferSize)
    {}
 
+   //silence sleeping: processors that only make sound in response to their input can return how long their state lasts (a delay's buffer, a reverb's tail)
+   //once their input and output have both been silent that long, the graph skips Process() (and summing into the target) until non-silent input shows up
+   virtual float GetSilenceTailMs() { return -1; } //-1 means never sleep
+   virtual bool IsOutputSilent() { return true; } //processors that can see their own output report it, so a long tail isn't cut off while it's still ringing
+   bool IsSleeping() const { return mSleeping; }
+   void ProcessOrSleep(double time) override;
+
 protected:
    void SyncBuffers(int overrideNumOutputChannels = -1);
+   static bool IsSilent(ChannelBuffer* buffer);
+
+private:
+   bool mSleeping{ false };
+   int mSilentSamples{ 0 };
 };
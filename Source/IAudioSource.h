@@ -42,6 +42,7 @@ public:
    {}
    virtual ~IAudioSource() {}
    virtual void Process(double time) = 0;
+   virtual void ProcessOrSleep(double time) { Process(time); } //what the audio graph calls. see IAudioProcessor
    IAudioReceiver* GetTarget(int index = 0);
    virtual int GetNumTargets() { return 1; }
    RollingBuffer* GetVizBuffer() { return &mVizBuffer; }
@@ -32,6 +32,7 @@
 
 std::string IClickable::sPathLoadContext = "";
 std::string IClickable::sPathSaveContext = "";
+std::atomic<int> IClickable::sPathGeneration{ 0 };
 
 IClickable::IClickable()
 {
@@ -144,11 +145,7 @@ std::string IClickable::Path(bool ignoreContext, bool useDisplayName)
    if (mName[0] == 0) //must have a name
       return "";
 
-   std::string name = useDisplayName ? GetDisplayName() : mName;
-
-   std::string path = name;
-   if (mParent != nullptr)
-      path = mParent->Path(true) + "~" + name;
+   std::string path = GetCachedPath(useDisplayName)->mPath;
 
    if (!ignoreContext)
    {
@@ -177,6 +174,28 @@ std::string IClickable::Path(bool ignoreContext, bool useDisplayName)
    return path;
 }
 
+std::shared_ptr<const IClickable::CachedPath> IClickable::GetCachedPath(bool useDisplayName)
+{
+   int generation = sPathGeneration;
+   std::shared_ptr<const CachedPath>& slot = mCachedPath[useDisplayName ? 1 : 0];
+   std::shared_ptr<const CachedPath> cached = std::atomic_load(&slot);
+   if (cached != nullptr && cached->mGeneration == generation)
+      return cached;
+
+   //if the generation moves on while we're building this, it'll just be rebuilt on the next call
+   auto rebuilt = std::make_shared<CachedPath>();
+   rebuilt->mGeneration = generation;
+   std::string name = useDisplayName ? GetDisplayName() : mName;
+   if (mParent != nullptr)
+      rebuilt->mPath = mParent->Path(true) + "~" + name;
+   else
+      rebuilt->mPath = name;
+
+   cached = rebuilt;
+   std::atomic_store(&slot, cached);
+   return cached;
+}
+
 bool IClickable::CheckNeedsDraw()
 {
    return mShowing;
@@ -26,6 +26,8 @@
 #ifndef __modularSynth__IClickable__
 #define __modularSynth__IClickable__
 
+#include <atomic>
+#include <memory>
 #include "SynthGlobals.h"
 
 //TODO(Ryan) factor Transformable stuff out of here
@@ -43,6 +45,7 @@ public:
    {
       mX = x;
       mY = y;
+      OnPositionChanged();
    }
    void GetPosition(float& x, float& y, bool local = false) const;
    ofVec2f GetPosition(bool local = false) const;
@@ -50,10 +53,18 @@ public:
    {
       mX += moveX;
       mY += moveY;
+      OnPositionChanged();
    }
    virtual bool TestClick(float x, float y, bool right, bool testOnly = false);
    IClickable* GetParent() const { return mParent; }
-   void SetParent(IClickable* parent) { mParent = parent; }
+   void SetParent(IClickable* parent)
+   {
+      if (mParent != parent)
+      {
+         mParent = parent;
+         ++sPathGeneration;
+      }
+   }
    bool NotifyMouseMoved(float x, float y);
    bool NotifyMouseScrolled(float x, float y, float scrollX, float scrollY, bool isSmoothScroll, bool isInvertedScroll);
    virtual void MouseReleased() {}
@@ -66,11 +77,14 @@ public:
    ofRectangle GetRect(bool local = false);
    void SetName(const char* name)
    {
-      if (mName != name)
+      if (mName != name && strcmp(mName, name) != 0)
+      {
          StringCopy(mName, name, MAX_TEXTENTRY_LENGTH);
+         ++sPathGeneration;
+      }
    }
    const char* Name() const { return mName; }
-   char* NameMutable() { return mName; }
+   char* NameMutable() { return mName; } //writes through this don't invalidate cached paths, commit them with SetName()
    std::string Path(bool ignoreContext = false, bool useDisplayName = false);
    virtual bool CheckNeedsDraw();
    virtual void SetShowing(bool showing) { mShowing = showing; }
@@ -84,6 +98,7 @@ public:
    {
       mHasOverrideDisplayName = true;
       mOverrideDisplayName = name;
+      ++sPathGeneration;
    }
    std::string GetDisplayName()
    {
@@ -97,11 +112,14 @@ public:
 
    static std::string sPathLoadContext;
    static std::string sPathSaveContext;
+   //bumped whenever a name or parent changes, or a module is deleted, so anything holding on to resolved paths (including Path()'s own cache) can tell they might be stale
+   static std::atomic<int> sPathGeneration;
 
 protected:
    virtual void OnClicked(float x, float y, bool right) {}
    virtual bool MouseMoved(float x, float y) { return false; }
    virtual bool MouseScrolled(float x, float y, float scrollX, float scrollY, bool isSmoothScroll, bool isInvertedScroll) { return false; }
+   virtual void OnPositionChanged() {}
 
    float mX{ 0 };
    float mY{ 0 };
@@ -109,7 +127,17 @@ protected:
    bool mShowing{ true };
 
 private:
+   struct CachedPath
+   {
+      int mGeneration{ -1 };
+      std::string mPath;
+   };
+   std::shared_ptr<const CachedPath> GetCachedPath(bool useDisplayName);
+
    char mName[MAX_TEXTENTRY_LENGTH]{};
+   //full path before any load/save context is applied, by name [0] and by display name [1]
+   //Path() is called from the audio thread too, so these are swapped atomically rather than rebuilt in place
+   std::shared_ptr<const CachedPath> mCachedPath[2];
    double mBeaconTime{ -999 };
    bool mHasOverrideDisplayName{ false };
    std::string mOverrideDisplayName{ "" };
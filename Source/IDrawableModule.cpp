@@ -174,6 +174,21 @@ bool IDrawableModule::IsVisible()
    return IsWithinRect(TheSynth->GetDrawRect());
 }
 
+void IDrawableModule::UpdateMinimizeAnimation()
+{
+   if (mMinimized)
+      mMinimizeAnimation += ofGetLastFrameTime() * 5;
+   else
+      mMinimizeAnimation -= ofGetLastFrameTime() * 5;
+   mMinimizeAnimation = ofClamp(mMinimizeAnimation, 0, 1);
+}
+
+void IDrawableModule::OnPositionChanged()
+{
+   if (mOwningContainer)
+      mOwningContainer->InvalidateSpatialIndex();
+}
+
 void IDrawableModule::DrawFrame(float w, float h, bool drawModule, float& titleBarHeight, float& highlight)
 {
    titleBarHeight = mTitleBarHeight;
@@ -193,15 +208,14 @@ void IDrawableModule::DrawFrame(float w, float h, bool drawModule, float& titleB
       {
          RollingBuffer* vizBuff = audioSource->GetVizBuffer();
          int numSamples = std::min(500, vizBuff->Size());
-         float sample;
          float mag = 0;
          for (int ch = 0; ch < vizBuff->NumChannels(); ++ch)
          {
-            for (int i = 0; i < numSamples; ++i)
-            {
-               sample = vizBuff->GetSample(i, ch);
-               mag += sample * sample;
-            }
+            WrappedSpan span = vizBuff->GetSpan(numSamples, 0, ch);
+            for (int i = 0; i < span.mFirstSize; ++i)
+               mag += span.mFirst[i] * span.mFirst[i];
+            for (int i = 0; i < span.mSecondSize; ++i)
+               mag += span.mSecond[i] * span.mSecond[i];
          }
          mag /= numSamples * vizBuff->NumChannels();
          mag = sqrtf(mag);
@@ -356,11 +370,7 @@ void IDrawableModule::Render()
 
    PreDrawModule();
 
-   if (mMinimized)
-      mMinimizeAnimation += ofGetLastFrameTime() * 5;
-   else
-      mMinimizeAnimation -= ofGetLastFrameTime() * 5;
-   mMinimizeAnimation = ofClamp(mMinimizeAnimation, 0, 1);
+   UpdateMinimizeAnimation();
 
    float w, h;
    GetDimensions(w, h);
@@ -1067,6 +1077,8 @@ void IDrawableModule::LoadLayoutBase(const ofxJSONElement& moduleInfo)
    {
       mModuleSaveData.LoadInt("transport_priority", moduleInfo, timeListener->mTransportPriority, -9999, 9999, K(isTextField));
       timeListener->mTransportPriority = mModuleSaveData.GetInt("transport_priority");
+      if (TheTransport)
+         TheTransport->OnListenerPriorityChanged();
    }
 }
 
@@ -1089,7 +1101,11 @@ void IDrawableModule::SetUpFromSaveDataBase()
 {
    ITimeListener* timeListener = dynamic_cast<ITimeListener*>(this);
    if (timeListener)
+   {
       timeListener->mTransportPriority = mModuleSaveData.GetInt("transport_priority");
+      if (TheTransport)
+         TheTransport->OnListenerPriorityChanged();
+   }
 
    SetUpFromSaveData();
 }
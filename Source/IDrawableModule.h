@@ -87,6 +87,7 @@ public:
       if (HasTitleBar())
          mMinimized = minimized;
    }
+   void UpdateMinimizeAnimation();
    virtual void KeyPressed(int key, bool isRepeat);
    virtual void KeyReleased(int key);
    void DrawConnection(IClickable* target);
@@ -210,6 +211,7 @@ protected:
    void Poll() override {}
    void OnClicked(float x, float y, bool right) override;
    bool MouseMoved(float x, float y) override;
+   void OnPositionChanged() override;
 
    ModuleSaveData mModuleSaveData;
    Checkbox* mEnabledCheckbox{ nullptr };
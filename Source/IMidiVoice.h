@@ -43,6 +43,7 @@ public:
    virtual void Stop(double time) = 0;
    virtual bool Process(double time, ChannelBuffer* out, int oversampling) = 0;
    virtual bool IsDone(double time) = 0;
+   virtual bool IsReleasedBelow(double time, float level) { return false; } //amplitude envelope is in its release and below level
    virtual void SetVoiceParams(IVoiceParams* params) = 0;
    void SetPan(float pan)
    {
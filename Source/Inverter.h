@@ -49,6 +49,9 @@ public:
    void Process(double time) override;
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
 
+   //IAudioProcessor
+   float GetSilenceTailMs() override { return 0; }
+
    virtual void LoadLayout(const ofxJSONElement& moduleInfo) override;
    virtual void SetUpFromSaveData() override;
 
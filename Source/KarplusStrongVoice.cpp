@@ -32,6 +32,7 @@
 #include "ChannelBuffer.h"
 #include "PolyphonyMgr.h"
 #include "SingleOscillatorVoice.h"
+#include "BufferArena.h"
 
 #include "juce_core/juce_core.h"
 
@@ -89,13 +90,26 @@ bool KarplusStrongVoice::Process(double time, ChannelBuffer* out, int oversampli
    float pitch;
    float oscPhaseInc;
 
+   //look up the whole block's frequencies at once
+   int numUpdates = mVoiceParams->mLiteCPUMode ? 1 : out->BufferSize();
+   ScratchBuffer pitchBuffer(numUpdates, 2);
+   float* pitches = pitchBuffer.Get(0);
+   float* freqs = pitchBuffer.Get(1);
+   for (int i = 0; i < numUpdates; ++i)
+   {
+      pitches[i] = GetPitch(i);
+      if (mVoiceParams->mInvert)
+         pitches[i] += 12; //inverting the pitch gives an octave down sound by halving the resonating frequency, so correct for that
+   }
+   TheScale->PitchToFreq(pitches, freqs, numUpdates);
+
    if (mVoiceParams->mLiteCPUMode)
-      DoParameterUpdate(0, oversampling, pitch, freq, filterRate, filterLerp, oscPhaseInc);
+      DoParameterUpdate(0, oversampling, pitches, freqs, pitch, freq, filterRate, filterLerp, oscPhaseInc);
 
    for (int pos = 0; pos < bufferSize; ++pos)
    {
       if (!mVoiceParams->mLiteCPUMode)
-         DoParameterUpdate(pos / oversampling, oversampling, pitch, freq, filterRate, filterLerp, oscPhaseInc);
+         DoParameterUpdate(pos / oversampling, oversampling, pitches, freqs, pitch, freq, filterRate, filterLerp, oscPhaseInc);
 
       if (mVoiceParams->mSourceType == kSourceTypeSaw)
          mOsc.SetType(kOsc_Saw);
@@ -183,6 +197,8 @@ bool KarplusStrongVoice::Process(double time, ChannelBuffer* out, int oversampli
 
 void KarplusStrongVoice::DoParameterUpdate(int samplesIn,
                                            int oversampling,
+                                           const float* pitches,
+                                           const float* freqs,
                                            float& pitch,
                                            float& freq,
                                            float& filterRate,
@@ -192,11 +208,8 @@ void KarplusStrongVoice::DoParameterUpdate(int samplesIn,
    if (mOwner)
       mOwner->ComputeSliders(samplesIn);
 
-   pitch = GetPitch(samplesIn);
-   if (mVoiceParams->mInvert)
-      pitch += 12; //inverting the pitch gives an octave down sound by halving the resonating frequency, so correct for that
-
-   freq = TheScale->PitchToFreq(pitch);
+   pitch = pitches[samplesIn];
+   freq = freqs[samplesIn];
    filterRate = mVoiceParams->mFilter * pow(freq / 300, exp2(mVoiceParams->mPitchTone)) * (1 + GetModWheel(samplesIn));
    filterLerp = ofClamp(exp2(-filterRate / oversampling), 0, 1);
 
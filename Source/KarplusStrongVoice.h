@@ -85,6 +85,8 @@ public:
 private:
    void DoParameterUpdate(int samplesIn,
                           int oversampling,
+                          const float* pitches,
+                          const float* freqs,
                           float& pitch,
                           float& freq,
                           float& filterRate,
@@ -97,36 +97,46 @@ void LiveGranulator::ProcessAudio(double time, ChannelBuffer* buffer)
 {
    PROFILER(LiveGranulator);
 
-   float bufferSize = buffer->BufferSize();
+   int bufferSize = buffer->BufferSize();
    mBuffer.SetNumChannels(buffer->NumActiveChannels());
 
-   for (int i = 0; i < bufferSize; ++i)
+   ComputeSliders(0);
+
+   mGranulator.SetLiveMode(!mFreeze);
+   int recordLength = 0;
+   if (!mFreeze)
+   {
+      recordLength = bufferSize;
+   }
+   else if (mFreezeExtraSamples < FREEZE_EXTRA_SAMPLES_COUNT)
    {
-      ComputeSliders(i);
+      recordLength = MIN(bufferSize, int(FREEZE_EXTRA_SAMPLES_COUNT - mFreezeExtraSamples));
+      mFreezeExtraSamples += recordLength;
+   }
+   if (recordLength > 0)
+   {
+      for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
+         mBuffer.WriteChunk(buffer->GetChannel(ch), recordLength, ch);
+   }
 
-      mGranulator.SetLiveMode(!mFreeze);
+   if (mEnabled)
+   {
+      //the whole block is recorded before the grains read it, so step the read offset back to where each sample was written
+      double offset = mBuffer.GetRawBufferOffset(0) - mFreezeExtraSamples - 1 + mPos;
+      double offsetIncrement = 0;
       if (!mFreeze)
       {
-         for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
-            mBuffer.Write(buffer->GetChannel(ch)[i], ch);
-      }
-      else if (mFreezeExtraSamples < FREEZE_EXTRA_SAMPLES_COUNT)
-      {
-         ++mFreezeExtraSamples;
-         for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
-            mBuffer.Write(buffer->GetChannel(ch)[i], ch);
+         offset -= bufferSize - 1;
+         offsetIncrement = 1;
       }
 
-      if (mEnabled)
+      gWorkChannelBuffer.SetNumActiveChannels(buffer->NumActiveChannels());
+      mGranulator.ProcessBlock(time, mBuffer.GetRawBuffer(), mBufferLength, offset, offsetIncrement, &gWorkChannelBuffer, bufferSize);
+      for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
       {
-         float sample[ChannelBuffer::kMaxNumChannels];
-         Clear(sample, ChannelBuffer::kMaxNumChannels);
-         mGranulator.ProcessFrame(time, mBuffer.GetRawBuffer(), mBufferLength, mBuffer.GetRawBufferOffset(0) - mFreezeExtraSamples - 1 + mPos, sample);
-         for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
-            buffer->GetChannel(ch)[i] = mDry * buffer->GetChannel(ch)[i] + sample[ch];
+         Mult(buffer->GetChannel(ch), mDry, bufferSize);
+         Add(buffer->GetChannel(ch), gWorkChannelBuffer.GetChannel(ch), bufferSize);
       }
-
-      time += gInvSampleRateMs;
    }
 }
 
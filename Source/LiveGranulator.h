@@ -55,6 +55,7 @@ public:
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
    float GetEffectAmount() override;
    std::string GetType() override { return "granulator"; }
+   float GetTailLengthMs() override { return mBufferLength * gInvSampleRateMs; }
 
    void OnTimeEvent(double time) override;
 
@@ -35,6 +35,7 @@
 #include "Rewriter.h"
 #include "FillSaveDropdown.h"
 #include "LooperGranulator.h"
+#include "BufferArena.h"
 
 float Looper::mBeatwheelPosRight = 0;
 float Looper::mBeatwheelDepthRight = 0;
@@ -49,15 +50,14 @@ Looper::Looper()
    //TODO(Ryan) buffer sizes
    mBuffer = new ChannelBuffer(MAX_BUFFER_SIZE);
    mUndoBuffer = new ChannelBuffer(MAX_BUFFER_SIZE);
+   mBuffer->EnablePeaks();
+   mUndoBuffer->EnablePeaks();
    Clear();
 
    mMuteRamp.SetValue(1);
 
    for (int i = 0; i < ChannelBuffer::kMaxNumChannels; ++i)
-   {
-      mPitchShifter[i] = new PitchShifter(1024);
       mLastInputSample[i] = 0;
-   }
 
    SetLoopLength(4 * 60.0f / TheTransport->GetTempo() * gSampleRate);
 }
@@ -136,8 +136,6 @@ Looper::~Looper()
 {
    delete mBuffer;
    delete mUndoBuffer;
-   for (int i = 0; i < ChannelBuffer::kMaxNumChannels; ++i)
-      delete mPitchShifter[i];
 }
 
 void Looper::Exit()
@@ -169,6 +167,7 @@ ChannelBuffer* Looper::GetLoopBuffer(int& loopLength)
 
 void Looper::SetLoopBuffer(ChannelBuffer* buffer)
 {
+   buffer->EnablePeaks();
    mQueuedNewBuffer = buffer;
 }
 
@@ -272,9 +271,11 @@ void Looper::Process(double time)
       mPitchShift = 1 / speed;
    int latencyOffset = 0;
    if (mPitchShift != 1)
-      latencyOffset = mPitchShifter[0]->GetLatency();
+      latencyOffset = mPitchShifter.GetLatency();
 
    double processStartTime = time;
+   float writeMin = FLT_MAX;
+   float writeMax = -FLT_MAX;
    for (int i = 0; i < bufferSize; ++i)
    {
       float smooth = .001f;
@@ -317,7 +318,11 @@ void Looper::Process(double time)
          //write one sample the past so we don't end up feeding into the next output
          float writeAmount = mWriteInputRamp.Value(time);
          if (writeAmount > 0)
+         {
             WriteInterpolatedSample(offset - 1, mBuffer->GetChannel(ch), mLoopLength, mLastInputSample[ch] * writeAmount);
+            writeMin = std::min(writeMin, offset - 1);
+            writeMax = std::max(writeMax, offset - 1);
+         }
          mLastInputSample[ch] = GetBuffer()->GetChannel(ch)[i];
 
          output[ch] = mSwitchAndRamp.Process(ch, output[ch] * volSq);
@@ -330,13 +335,16 @@ void Looper::Process(double time)
       time += gInvSampleRateMs;
    }
 
+   if (writeMin <= writeMax)
+      MarkLoopDirty(writeMin, writeMax);
+
    if (mPitchShift != 1)
    {
-      for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
-      {
-         mPitchShifter[ch]->SetRatio(mPitchShift);
-         mPitchShifter[ch]->Process(mWorkBuffer.GetChannel(ch), bufferSize);
-      }
+      mPitchShifter.SetRatio(mPitchShift);
+      if (mBuffer->NumActiveChannels() > 1)
+         mPitchShifter.Process(mWorkBuffer.GetChannel(0), mWorkBuffer.GetChannel(1), bufferSize);
+      else
+         mPitchShifter.Process(mWorkBuffer.GetChannel(0), bufferSize);
    }
 
    for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
@@ -407,6 +415,7 @@ void Looper::DoCommit(double time)
             mBuffer->GetChannel(ch)[pos] += mCommitBuffer->GetSample(ofClamp(commitLength - i + commitSamplesBack, 0, MAX_BUFFER_SIZE - 1), ch) * fade;
          }
       }
+      mBuffer->MarkDirty(0, mLoopLength);
    }
 
    mClearCommitBuffer = true;
@@ -581,6 +590,7 @@ void Looper::ResampleForSpeed(float speed)
       }
       delete[] oldBuffer;
    }
+   mBuffer->MarkDirty(0, mLoopLength);
 
    if (mKeepPitch)
    {
@@ -834,6 +844,7 @@ void Looper::BakeVolume()
    mUndoBuffer->CopyFrom(mBuffer, mLoopLength);
    for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
       Mult(mBuffer->GetChannel(ch), mVol * mVol, mLoopLength);
+   mBuffer->MarkDirty(0, mLoopLength);
    mVol = 1;
    mSmoothedVol = 1;
    mWantBakeVolume = false;
@@ -856,7 +867,26 @@ void Looper::UpdateNumBars(int oldNumBars)
          for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
             BufferCopy(mBuffer->GetChannel(ch) + oldLoopLength * i, mBuffer->GetChannel(ch), oldLoopLength);
       }
+      mBuffer->MarkDirty(0, mLoopLength);
+   }
+}
+
+//recording only touches a short stretch each buffer, so the waveform display just rescans that
+void Looper::MarkLoopDirty(float from, float to)
+{
+   //WriteInterpolatedSample() touches the samples on either side, and wraps around the loop
+   int start = (int)floor(from) - 1;
+   int length = (int)ceil(to) - start + 2;
+   if (length >= mLoopLength)
+   {
+      mBuffer->MarkDirty(0, mLoopLength);
+      return;
    }
+
+   start = ((start % mLoopLength) + mLoopLength) % mLoopLength;
+   mBuffer->MarkDirty(start, std::min(length, mLoopLength - start));
+   if (start + length > mLoopLength)
+      mBuffer->MarkDirty(0, start + length - mLoopLength);
 }
 
 void Looper::SetLoopLength(int length)
@@ -883,6 +913,7 @@ void Looper::MergeIn(Looper* otherLooper)
          Mult(otherLooper->mBuffer->GetChannel(ch), (otherLooper->mVol * otherLooper->mVol) / (mVol * mVol), mLoopLength); //keep other looper at same apparent volume
          Add(mBuffer->GetChannel(ch), otherLooper->mBuffer->GetChannel(ch), mLoopLength);
       }
+      mBuffer->MarkDirty(0, mLoopLength);
    }
    else //ours was silent, just replace it
    {
@@ -921,7 +952,7 @@ void Looper::CopyBuffer(Looper* sourceLooper)
    mNumBars = sourceLooper->mNumBars;
 }
 
-void Looper::Commit(RollingBuffer* commitBuffer /* = nullptr */)
+void Looper::Commit(DelayLine* commitBuffer /* = nullptr */)
 {
    if (mRecorder)
    {
@@ -958,6 +989,7 @@ void Looper::FilesDropped(std::vector<std::string> files, int x, int y)
 {
    Sample sample;
    sample.Read(files[0].c_str());
+   sample.WaitForSampleRateConversion();
    SampleDropped(x, y, &sample);
 }
 
@@ -980,6 +1012,7 @@ void Looper::SampleDropped(int x, int y, Sample* sample)
       for (int ch = 0; ch < sample->NumChannels(); ++ch)
          mBuffer->GetChannel(ch)[i] = GetInterpolatedSample(offset, sample->Data()->GetChannel(ch), numSamples);
    }
+   mBuffer->MarkDirty(0, mLoopLength);
 }
 
 void Looper::GetModuleDimensions(float& width, float& height)
@@ -1141,7 +1174,7 @@ void Looper::DoShiftMeasure()
    int measureSize = int(TheTransport->MsPerBar() * gSampleRate / 1000);
    for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
    {
-      float* newBuffer = new float[MAX_BUFFER_SIZE];
+      float* newBuffer = BufferArena::Allocate(MAX_BUFFER_SIZE);
       BufferCopy(newBuffer, mBuffer->GetChannel(ch) + measureSize, mLoopLength - measureSize);
       BufferCopy(newBuffer + mLoopLength - measureSize, mBuffer->GetChannel(ch), measureSize);
       mBufferMutex.lock();
@@ -1156,7 +1189,7 @@ void Looper::DoHalfShift()
    int halfMeasureSize = int(TheTransport->MsPerBar() * gSampleRate / 1000 / 2);
    for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
    {
-      float* newBuffer = new float[MAX_BUFFER_SIZE];
+      float* newBuffer = BufferArena::Allocate(MAX_BUFFER_SIZE);
       BufferCopy(newBuffer, mBuffer->GetChannel(ch) + halfMeasureSize, mLoopLength - halfMeasureSize);
       BufferCopy(newBuffer + mLoopLength - halfMeasureSize, mBuffer->GetChannel(ch), halfMeasureSize);
       mBufferMutex.lock();
@@ -1171,7 +1204,7 @@ void Looper::DoShiftDownbeat()
    int shift = int(mLoopPos);
    for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
    {
-      float* newBuffer = new float[MAX_BUFFER_SIZE];
+      float* newBuffer = BufferArena::Allocate(MAX_BUFFER_SIZE);
       BufferCopy(newBuffer, mBuffer->GetChannel(ch) + shift, mLoopLength - shift);
       BufferCopy(newBuffer + mLoopLength - shift, mBuffer->GetChannel(ch), shift);
       mBufferMutex.lock();
@@ -1188,7 +1221,7 @@ void Looper::DoShiftOffset()
    {
       for (int ch = 0; ch < mBuffer->NumActiveChannels(); ++ch)
       {
-         float* newBuffer = new float[MAX_BUFFER_SIZE];
+         float* newBuffer = BufferArena::Allocate(MAX_BUFFER_SIZE);
          BufferCopy(newBuffer, mBuffer->GetChannel(ch) + shift, mLoopLength - shift);
          BufferCopy(newBuffer + mLoopLength - shift, mBuffer->GetChannel(ch), shift);
          mBufferMutex.lock();
@@ -29,7 +29,7 @@
 #include <iostream>
 #include "IAudioProcessor.h"
 #include "IDrawableModule.h"
-#include "RollingBuffer.h"
+#include "DelayLine.h"
 #include "ClickButton.h"
 #include "RadioButton.h"
 #include "Slider.h"
@@ -62,7 +62,7 @@ public:
 
    void SetRecorder(LooperRecorder* recorder);
    void Clear();
-   void Commit(RollingBuffer* commitBuffer = nullptr);
+   void Commit(DelayLine* commitBuffer = nullptr);
    void Fill(ChannelBuffer* buffer, int length);
    void ResampleForSpeed(float speed);
    int NumBars() const { return mNumBars; }
@@ -135,6 +135,7 @@ private:
    void DoCommit(double time);
    void UpdateNumBars(int oldNumBars);
    void BakeVolume();
+   void MarkLoopDirty(float from, float to);
    void DoUndo();
    void ProcessFourTet(double time, int sampleIdx);
    void ProcessScratch();
@@ -158,7 +159,7 @@ private:
    ChannelBuffer mWorkBuffer;
    int mLoopLength{ -1 };
    float mLoopPos{ 0 };
-   RollingBuffer* mRecordBuffer{ nullptr };
+   DelayLine* mRecordBuffer{ nullptr };
    int mNumBars{ 1 };
    ClickButton* mClearButton{ nullptr };
    DropdownList* mNumBarsSelector{ nullptr };
@@ -170,7 +171,7 @@ private:
    ClickButton* mMergeButton{ nullptr };
    ClickButton* mSwapButton{ nullptr };
    ClickButton* mCopyButton{ nullptr };
-   RollingBuffer* mCommitBuffer{ nullptr }; //if this is set, a commit happens next audio frame
+   DelayLine* mCommitBuffer{ nullptr }; //if this is set, a commit happens next audio frame
    ClickButton* mVolumeBakeButton{ nullptr };
    bool mWantBakeVolume{ false };
    int mLastCommit{ 0 };
@@ -235,7 +236,7 @@ private:
    Checkbox* mBeatwheelSingleMeasureCheckbox{ nullptr };
 
    //pitch shifter
-   PitchShifter* mPitchShifter[ChannelBuffer::kMaxNumChannels];
+   PitchShifter mPitchShifter{ 1024 };
    float mPitchShift{ 1 };
    FloatSlider* mPitchShiftSlider{ nullptr };
    bool mKeepPitch{ false };
@@ -188,15 +188,12 @@ void LooperRecorder::Process(double time)
    if (loop)
    {
       int delaySamps = TheTransport->GetDuration(kInterval_1n) * NumBars() / gInvSampleRateMs;
-      delaySamps = MIN(delaySamps, MAX_BUFFER_SIZE - 1);
-      for (int i = 0; i < bufferSize; ++i)
+      delaySamps = ofClamp(delaySamps, bufferSize, MAX_BUFFER_SIZE - 1);
+      for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
       {
-         for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
-         {
-            float sample = mRecordBuffer.GetSample(delaySamps - i, ch);
-            mWriteBuffer.GetChannel(ch)[i] += sample;
-            GetBuffer()->GetChannel(ch)[i] += sample;
-         }
+         mRecordBuffer.ReadChunk(gWorkBuffer, bufferSize, delaySamps - bufferSize, ch);
+         Add(mWriteBuffer.GetChannel(ch), gWorkBuffer, bufferSize);
+         Add(GetBuffer()->GetChannel(ch), gWorkBuffer, bufferSize);
       }
    }
 
@@ -28,7 +28,7 @@
 
 #include <iostream>
 #include "IAudioProcessor.h"
-#include "RollingBuffer.h"
+#include "DelayLine.h"
 #include "RadioButton.h"
 #include "ClickButton.h"
 #include "Checkbox.h"
@@ -69,7 +69,7 @@ public:
    void SetOutputTarget(IAudioReceiver* target) { mOutputTarget = target; }
    void ResetSpeed();
    float GetCommitDelay() { return mCommitDelay; }
-   RollingBuffer* GetRecordBuffer() { return &mRecordBuffer; }
+   DelayLine* GetRecordBuffer() { return &mRecordBuffer; }
    Looper* GetNextCommitTarget() { return (mNextCommitTargetIndex < (int)mLoopers.size()) ? mLoopers[mNextCommitTargetIndex] : nullptr; }
 
    void StartFreeRecord(double time);
@@ -123,7 +123,7 @@ private:
    }
    float mWidth{ 235 };
    float mHeight{ 126 };
-   RollingBuffer mRecordBuffer;
+   DelayLine mRecordBuffer;
    std::vector<Looper*> mLoopers;
    int mNumBars{ 1 };
    DropdownList* mNumBarsSelector{ nullptr };
@@ -87,4 +87,12 @@ namespace MathUtils
       }
       return res;
    }
+
+   int NextPow2(int n)
+   {
+      int res = 1;
+      while (res < n)
+         res <<= 1;
+      return res;
+   }
 };
@@ -42,4 +42,5 @@ namespace MathUtils
    ofVec2f Normal(ofVec2f v);
    float Curve(float t, float curve);
    int HighestPow2(int n);
+   int NextPow2(int n);
 };
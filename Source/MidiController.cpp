@@ -299,71 +299,107 @@ void MidiController::OnTransportAdvanced(float amount)
 {
    PROFILER(MidiController);
 
-   mQueuedMessageMutex.lock();
+   UpdateClockOffset();
+
+   int start1, size1, start2, size2;
+   mQueuedMessageFifo.prepareToRead(mQueuedMessageFifo.getNumReady(), start1, size1, start2, size2);
 
-   double firstNoteTimestampMs = -1;
    double lastPlayTime = -1;
-   for (auto note = mQueuedNotes.begin(); note != mQueuedNotes.end(); ++note)
+   for (int idx = 0; idx < size1 + size2; ++idx)
    {
-      int voiceIdx = -1;
+      QueuedMidiMessage& message = mQueuedMessages[idx < size1 ? start1 + idx : start2 + idx - size1];
+      switch (message.mType)
+      {
+         case kMidiMessage_Note:
+         {
+            MidiNote& note = message.mNote;
+            int voiceIdx = -1;
 
-      if (mUseChannelAsVoice)
-         voiceIdx = note->mChannel - 1;
+            if (mUseChannelAsVoice)
+               voiceIdx = note.mChannel - 1;
 
-      //TODO(Ryan) how can I use note->mTimestamp to get more accurate timing for midi input?
-      //this here is not accurate, but prevents notes played within the same buffer from having the exact same time
-      double playTime;
-      if (firstNoteTimestampMs == -1) //this is the first note
-      {
-         firstNoteTimestampMs = note->mTimestampMs;
-         playTime = gTime;
-      }
-      else
-      {
-         playTime = gTime + (note->mTimestampMs - firstNoteTimestampMs);
-         if (playTime <= lastPlayTime)
-            playTime += .01; //hack to handle note on/off in the same frame
-      }
-      lastPlayTime = playTime;
-      PlayNoteOutput(playTime, note->mPitch + mNoteOffset, MIN(127, note->mVelocity * mVelocityMult), voiceIdx, ModulationParameters(mModulation.GetPitchBend(voiceIdx), mModulation.GetModWheel(voiceIdx), mModulation.GetPressure(voiceIdx), 0));
+            double playTime = GetPlayTime(note.mTimestampMs);
+            if (playTime <= lastPlayTime)
+               playTime = lastPlayTime + .01; //keep note on/off pairs in the order they arrived
+            lastPlayTime = playTime;
+            PlayNoteOutput(playTime, note.mPitch + mNoteOffset, MIN(127, note.mVelocity * mVelocityMult), voiceIdx, ModulationParameters(mModulation.GetPitchBend(voiceIdx), mModulation.GetModWheel(voiceIdx), mModulation.GetPressure(voiceIdx), 0));
 
-      for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
-         (*i)->OnMidiNote(*note);
-   }
-   mQueuedNotes.clear();
+            for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
+               (*i)->OnMidiNote(note);
+            break;
+         }
+         case kMidiMessage_Control:
+         {
+            MidiControl& ctrl = message.mControl;
+            if (mSendCCOutput)
+            {
+               int voiceIdx = -1;
 
-   for (auto ctrl = mQueuedControls.begin(); ctrl != mQueuedControls.end(); ++ctrl)
-   {
-      if (mSendCCOutput)
-      {
-         int voiceIdx = -1;
+               if (mUseChannelAsVoice)
+                  voiceIdx = ctrl.mChannel - 1;
 
-         if (mUseChannelAsVoice)
-            voiceIdx = ctrl->mChannel - 1;
+               SendCCOutput(ctrl.mControl, ctrl.mValue, voiceIdx);
+            }
 
-         SendCCOutput(ctrl->mControl, ctrl->mValue, voiceIdx);
+            for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
+               (*i)->OnMidiControl(ctrl);
+            break;
+         }
+         case kMidiMessage_Program:
+         {
+            for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
+               (*i)->OnMidiProgramChange(message.mProgramChange);
+            break;
+         }
+         case kMidiMessage_PitchBend:
+         {
+            for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
+               (*i)->OnMidiPitchBend(message.mPitchBend);
+            break;
+         }
       }
-
-      for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
-         (*i)->OnMidiControl(*ctrl);
    }
-   mQueuedControls.clear();
 
-   for (auto note = mQueuedProgramChanges.begin(); note != mQueuedProgramChanges.end(); ++note)
-   {
-      for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
-         (*i)->OnMidiProgramChange(*note);
-   }
-   mQueuedProgramChanges.clear();
+   mQueuedMessageFifo.finishedRead(size1 + size2);
+}
+
+namespace
+{
+   const double kClockSmoothing = .01;
+   const double kClockResyncMs = 50;
+}
+
+void MidiController::UpdateClockOffset()
+{
+   //input timestamps are on juce's millisecond counter. the audio callback wakes up with some jitter relative to that, so smooth our estimate of where gTime sits on it
+   //but snap to it after a big jump, like a dropout or the audio device restarting
+   double offset = juce::Time::getMillisecondCounterHiRes() - gTime;
+   if (!mHasClockOffset || fabs(offset - mClockOffsetMs) > kClockResyncMs)
+      mClockOffsetMs = offset;
+   else
+      mClockOffsetMs += (offset - mClockOffsetMs) * kClockSmoothing;
+   mHasClockOffset = true;
+}
 
-   for (auto note = mQueuedPitchBends.begin(); note != mQueuedPitchBends.end(); ++note)
+double MidiController::GetPlayTime(double timestampMs) const
+{
+   //messages that arrived during the last buffer play a buffer later, at the same spacing they arrived with
+   //this trades a fixed buffer of latency for the jitter of snapping everything to the start of the buffer
+   double playTime = timestampMs - mClockOffsetMs + gBufferSizeMs;
+   return std::clamp(playTime, gTime, gTime + gBufferSizeMs);
+}
+
+void MidiController::QueueMessage(const QueuedMidiMessage& message)
+{
+   mQueueWriteMutex.lock();
+   int start1, size1, start2, size2;
+   mQueuedMessageFifo.prepareToWrite(1, start1, size1, start2, size2);
+   if (size1 + size2 > 0) //otherwise the audio thread has stalled and we're full, drop it rather than wait
    {
-      for (auto i = mListeners[mControllerPage].begin(); i != mListeners[mControllerPage].end(); ++i)
-         (*i)->OnMidiPitchBend(*note);
+      mQueuedMessages[size1 > 0 ? start1 : start2] = message;
+      mQueuedMessageFifo.finishedWrite(1);
    }
-   mQueuedPitchBends.clear();
-
-   mQueuedMessageMutex.unlock();
+   mQueueWriteMutex.unlock();
 }
 
 void MidiController::OnMidiNote(MidiNote& note)
@@ -379,9 +415,12 @@ void MidiController::OnMidiNote(MidiNote& note)
 
    MidiReceived(kMidiMessage_Note, note.mPitch, note.mVelocity / 127.0f, note.mVelocity, note.mChannel);
 
-   mQueuedMessageMutex.lock();
-   mQueuedNotes.push_back(note);
-   mQueuedMessageMutex.unlock();
+   QueuedMidiMessage message;
+   message.mType = kMidiMessage_Note;
+   message.mNote = note;
+   if (message.mNote.mTimestampMs == 0) //not from a midi device, so it's arriving now
+      message.mNote.mTimestampMs = juce::Time::getMillisecondCounterHiRes();
+   QueueMessage(message);
 
    if (mPrintInput)
       ofLog() << Name() << " note: " << note.mPitch << ", " << note.mVelocity;
@@ -407,9 +446,10 @@ void MidiController::OnMidiControl(MidiControl& control)
 
    MidiReceived(kMidiMessage_Control, control.mControl, control.mValue / 127.0f, control.mValue, control.mChannel);
 
-   mQueuedMessageMutex.lock();
-   mQueuedControls.push_back(control);
-   mQueuedMessageMutex.unlock();
+   QueuedMidiMessage message;
+   message.mType = kMidiMessage_Control;
+   message.mControl = control;
+   QueueMessage(message);
 
    if (mPrintInput)
       ofLog() << Name() << " control: " << control.mControl << ", " << control.mValue;
@@ -437,9 +477,10 @@ void MidiController::OnMidiProgramChange(MidiProgramChange& program)
 
    MidiReceived(kMidiMessage_Program, program.mProgram, 1, 1, program.mChannel);
 
-   mQueuedMessageMutex.lock();
-   mQueuedProgramChanges.push_back(program);
-   mQueuedMessageMutex.unlock();
+   QueuedMidiMessage message;
+   message.mType = kMidiMessage_Program;
+   message.mProgramChange = program;
+   QueueMessage(message);
 
    if (mPrintInput)
       ofLog() << Name() << " program change: " << program.mProgram;
@@ -463,9 +504,10 @@ void MidiController::OnMidiPitchBend(MidiPitchBend& pitchBend)
 
    MidiReceived(kMidiMessage_PitchBend, MIDI_PITCH_BEND_CONTROL_NUM, pitchBend.mValue / 16383.0f, pitchBend.mValue, pitchBend.mChannel); //16383 = max pitch bend
 
-   mQueuedMessageMutex.lock();
-   mQueuedPitchBends.push_back(pitchBend);
-   mQueuedMessageMutex.unlock();
+   QueuedMidiMessage message;
+   message.mType = kMidiMessage_PitchBend;
+   message.mPitchBend = pitchBend;
+   QueueMessage(message);
 
    if (mPrintInput)
       ofLog() << Name() << " pitch bend: " << pitchBend.mValue;
@@ -355,6 +355,15 @@ private:
       kLayout
    };
 
+   struct QueuedMidiMessage
+   {
+      MidiMessageType mType{ kMidiMessage_Note };
+      MidiNote mNote;
+      MidiControl mControl;
+      MidiProgramChange mProgramChange;
+      MidiPitchBend mPitchBend;
+   };
+
    //IDrawableModule
    void DrawModule() override;
    void DrawModuleUnclipped() override;
@@ -363,6 +372,9 @@ private:
    bool MouseMoved(float x, float y) override;
 
    void ConnectDevice();
+   void QueueMessage(const QueuedMidiMessage& message);
+   void UpdateClockOffset();
+   double GetPlayTime(double timestampMs) const;
    void MidiReceived(MidiMessageType messageType, int control, float scaledValue, int rawValue, int channel);
    void RemoveConnection(int control, MidiMessageType messageType, int channel, int page);
    void ResyncTwoWay();
@@ -407,10 +419,6 @@ private:
    bool mSendTwoWayOnChange{ true };
    bool mResendFeedbackOnRelease{ false };
    ClickButton* mAddConnectionButton{ nullptr };
-   std::list<MidiNote> mQueuedNotes;
-   std::list<MidiControl> mQueuedControls;
-   std::list<MidiProgramChange> mQueuedProgramChanges;
-   std::list<MidiPitchBend> mQueuedPitchBends;
    DropdownList* mControllerList{ nullptr };
    Checkbox* mDrawCablesCheckbox{ nullptr };
    MappingDisplayMode mMappingDisplayMode{ MappingDisplayMode::kHide };
@@ -449,7 +457,13 @@ private:
    int mLayoutHeight{ 0 };
    std::vector<GridLayout*> mGrids;
 
-   ofMutex mQueuedMessageMutex;
+   //messages from the input thread(s), drained on the audio thread in OnTransportAdvanced()
+   static const int kMessageQueueSize = 1024;
+   std::array<QueuedMidiMessage, kMessageQueueSize> mQueuedMessages;
+   juce::AbstractFifo mQueuedMessageFifo{ kMessageQueueSize };
+   ofMutex mQueueWriteMutex; //only serializes producers (midi, osc, monome threads), the audio thread never takes it
+   double mClockOffsetMs{ 0 }; //smoothed difference between the midi timestamp clock and gTime
+   bool mHasClockOffset{ false };
 };
 
 #endif /* defined(__modularSynth__MidiController__) */
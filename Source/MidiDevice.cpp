@@ -40,8 +40,7 @@ MidiDevice::~MidiDevice()
 {
    auto& deviceManager = TheSynth->GetAudioDeviceManager();
    deviceManager.removeMidiInputCallback(mDeviceNameIn, this);
-   if (mMidiOut.get())
-      mMidiOut->stopBackgroundThread();
+   mOutputScheduler.Stop();
 }
 
 bool MidiDevice::ConnectInput(const char* name)
@@ -92,11 +91,12 @@ bool MidiDevice::ConnectOutput(const char* name, int channel /*= 1*/)
 
 bool MidiDevice::ConnectOutput(int index, int channel /*= 1*/)
 {
+   mOutputScheduler.Stop();
    mMidiOut.reset();
    mMidiOut = MidiOutput::openDevice(index);
    if (mMidiOut)
    {
-      mMidiOut->startBackgroundThread();
+      mOutputScheduler.Start(mMidiOut.get());
       mDeviceNameOut = mMidiOut->getName();
 
       assert(channel > 0 && channel <= 16);
@@ -116,8 +116,7 @@ void MidiDevice::DisconnectInput()
 
 void MidiDevice::DisconnectOutput()
 {
-   if (mMidiOut)
-      mMidiOut->stopBackgroundThread();
+   mOutputScheduler.Stop();
    mMidiOut.reset();
    mMidiOut = nullptr;
    mDeviceNameOut = "";
@@ -178,16 +177,10 @@ void MidiDevice::SendNote(double time, int pitch, int velocity, bool forceNoteOn
       if (channel == -1)
          channel = mOutputChannel;
 
-      int sampleNumber = (time - gTime) * gSampleRateMs;
-
-      juce::MidiBuffer midiBuffer;
-
       if (velocity > 0 || forceNoteOn)
-         midiBuffer.addEvent(MidiMessage::noteOn(channel, pitch, (uint8)velocity), sampleNumber);
+         mOutputScheduler.Schedule(MidiMessage::noteOn(channel, pitch, (uint8)velocity), GetOutputTimeMs(time));
       else
-         midiBuffer.addEvent(MidiMessage::noteOff(channel, pitch), sampleNumber);
-
-      mMidiOut->sendBlockOfMessages(midiBuffer, Time::getMillisecondCounter(), gSampleRate);
+         mOutputScheduler.Schedule(MidiMessage::noteOff(channel, pitch), GetOutputTimeMs(time));
    }
 }
 
@@ -198,7 +191,7 @@ void MidiDevice::SendCC(int ctl, int value, int channel /* = -1*/)
       if (channel == -1)
          channel = mOutputChannel;
 
-      mMidiOut->sendMessageNow(MidiMessage::controllerEvent(channel, ctl, value));
+      mOutputScheduler.Schedule(MidiMessage::controllerEvent(channel, ctl, value), Time::getMillisecondCounterHiRes());
    }
 }
 
@@ -210,7 +203,7 @@ void MidiDevice::SendAftertouch(int pressure, int channel /* = -1*/)
          channel = mOutputChannel;
 
       //TODO_PORT(Ryan) pitch number?
-      mMidiOut->sendMessageNow(MidiMessage::aftertouchChange(channel, 0, pressure));
+      mOutputScheduler.Schedule(MidiMessage::aftertouchChange(channel, 0, pressure), Time::getMillisecondCounterHiRes());
    }
 }
 
@@ -221,7 +214,7 @@ void MidiDevice::SendProgramChange(int program, int channel /* = -1*/)
       if (channel == -1)
          channel = mOutputChannel;
 
-      mMidiOut->sendMessageNow(MidiMessage::programChange(channel, program));
+      mOutputScheduler.Schedule(MidiMessage::programChange(channel, program), Time::getMillisecondCounterHiRes());
    }
 }
 
@@ -232,7 +225,7 @@ void MidiDevice::SendPitchBend(int bend, int channel /* = -1*/)
       if (channel == -1)
          channel = mOutputChannel;
 
-      mMidiOut->sendMessageNow(MidiMessage::pitchWheel(channel, bend));
+      mOutputScheduler.Schedule(MidiMessage::pitchWheel(channel, bend), Time::getMillisecondCounterHiRes());
    }
 }
 
@@ -240,7 +233,7 @@ void MidiDevice::SendSysEx(std::string data)
 {
    if (mMidiOut)
    {
-      mMidiOut->sendMessageNow(MidiMessage::createSysExMessage(data.c_str(), data.length()));
+      mOutputScheduler.Schedule(MidiMessage::createSysExMessage(data.c_str(), data.length()), Time::getMillisecondCounterHiRes());
    }
 }
 
@@ -248,21 +241,20 @@ void MidiDevice::SendData(unsigned char a, unsigned char b, unsigned char c)
 {
    if (mMidiOut)
    {
-      mMidiOut->sendMessageNow(MidiMessage(a, b, c));
+      mOutputScheduler.Schedule(MidiMessage(a, b, c), Time::getMillisecondCounterHiRes());
    }
 }
 
 void MidiDevice::SendMessage(double time, juce::MidiMessage message)
 {
    if (mMidiOut)
-   {
-      int sampleNumber = (time - gTime) * gSampleRateMs;
-
-      juce::MidiBuffer midiBuffer;
-      midiBuffer.addEvent(message, sampleNumber);
+      mOutputScheduler.Schedule(message, GetOutputTimeMs(time));
+}
 
-      mMidiOut->sendBlockOfMessages(midiBuffer, Time::getMillisecondCounter(), gSampleRate);
-   }
+//maps a time on the gTime timeline to the wall-clock time the scheduler sends at
+double MidiDevice::GetOutputTimeMs(double time) const
+{
+   return Time::getMillisecondCounterHiRes() + (time - gTime);
 }
 
 void MidiDevice::handleIncomingMidiMessage(MidiInput* source, const MidiMessage& message)
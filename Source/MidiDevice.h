@@ -28,6 +28,7 @@
 
 #include "OpenFrameworksPort.h"
 #include "ModularSynth.h"
+#include "MidiOutputScheduler.h"
 
 #include "juce_audio_devices/juce_audio_devices.h"
 
@@ -115,11 +116,13 @@ public:
 
 private:
    void handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message) override;
+   double GetOutputTimeMs(double time) const;
 
    juce::String mDeviceNameIn;
    juce::String mDeviceNameOut;
 
    std::unique_ptr<juce::MidiOutput> mMidiOut{ nullptr };
+   MidiOutputScheduler mOutputScheduler; //after mMidiOut, so it stops before the output is destroyed
    MidiDeviceListener* mListener{ nullptr };
    int mOutputChannel{ 1 };
    bool mIsInputEnabled{ false };
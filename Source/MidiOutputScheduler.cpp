@@ -0,0 +1,175 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    MidiOutputScheduler.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "MidiOutputScheduler.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace
+{
+   const int kPollIntervalMs = 1;
+   const double kSendToleranceMs = .5; //send anything due before the next wakeup would be later than this
+}
+
+MidiOutputScheduler::MidiOutputScheduler()
+: juce::Thread("MidiOutputScheduler")
+, mQueue(kQueueSize)
+, mCoalesceSeen(kNumCoalesceKeys, false)
+{
+   mPending.reserve(kQueueSize);
+}
+
+MidiOutputScheduler::~MidiOutputScheduler()
+{
+   Stop();
+}
+
+void MidiOutputScheduler::Start(juce::MidiOutput* output)
+{
+   Stop();
+
+   mOutput = output;
+   mFifo.reset();
+   mPending.clear();
+   mDroppedMessages = 0;
+   startThread();
+}
+
+void MidiOutputScheduler::Stop()
+{
+   if (mOutput == nullptr)
+      return;
+
+   stopThread(1000);
+   Drain();
+   SendDue(std::numeric_limits<double>::max());
+   mOutput = nullptr;
+}
+
+void MidiOutputScheduler::Schedule(const juce::MidiMessage& message, double timeMs)
+{
+   //sysex goes on the heap, so copy it before taking the lock. short messages are stored inline
+   juce::MidiMessage copy(message);
+
+   {
+      const juce::SpinLock::ScopedLockType lock(mWriteLock);
+
+      int start1, size1, start2, size2;
+      mFifo.prepareToWrite(1, start1, size1, start2, size2);
+      if (size1 + size2 == 0) //the sending thread is stuck behind the driver, drop rather than wait for it
+      {
+         ++mDroppedMessages;
+         return;
+      }
+
+      Event& event = mQueue[size1 > 0 ? start1 : start2];
+      event.mTimeMs = timeMs;
+      std::swap(event.mMessage, copy); //whatever was left in the slot is freed with copy, outside the lock
+      mFifo.finishedWrite(1);
+   }
+}
+
+void MidiOutputScheduler::run()
+{
+   while (!threadShouldExit())
+   {
+      Drain();
+      SendDue(juce::Time::getMillisecondCounterHiRes() + kSendToleranceMs);
+      wait(kPollIntervalMs);
+   }
+}
+
+void MidiOutputScheduler::Drain()
+{
+   int start1, size1, start2, size2;
+   mFifo.prepareToRead(mFifo.getNumReady(), start1, size1, start2, size2);
+   for (int i = 0; i < size1 + size2; ++i)
+   {
+      const Event& event = mQueue[i < size1 ? start1 + i : start2 + i - size1];
+      //upper_bound keeps events with the same time in the order they were sent
+      auto insertAt = std::upper_bound(mPending.begin(), mPending.end(), event.mTimeMs, [](double time, const Event& other)
+                                       { return time < other.mTimeMs; });
+      mPending.insert(insertAt, event);
+   }
+   mFifo.finishedRead(size1 + size2);
+}
+
+void MidiOutputScheduler::SendDue(double nowMs)
+{
+   int numDue = 0;
+   while (numDue < (int)mPending.size() && mPending[numDue].mTimeMs <= nowMs)
+      ++numDue;
+
+   if (numDue == 0)
+      return;
+
+   //dense automation can stack up several values for the same controller in one wakeup, only the newest one matters
+   //walk backwards so the last value for each key is the one that survives
+   std::vector<bool> redundant(numDue, false);
+   for (int i = numDue - 1; i >= 0; --i)
+   {
+      int key = GetCoalesceKey(mPending[i].mMessage);
+      if (key == -1)
+         continue;
+      if (mCoalesceSeen[key])
+         redundant[i] = true;
+      mCoalesceSeen[key] = true;
+   }
+
+   for (int i = 0; i < numDue; ++i)
+   {
+      int key = GetCoalesceKey(mPending[i].mMessage);
+      if (key != -1)
+         mCoalesceSeen[key] = false;
+      if (!redundant[i])
+         mOutput->sendMessageNow(mPending[i].mMessage);
+   }
+
+   mPending.erase(mPending.begin(), mPending.begin() + numDue);
+}
+
+//static
+int MidiOutputScheduler::GetCoalesceKey(const juce::MidiMessage& message)
+{
+   int channel = message.getChannel() - 1;
+   if (channel < 0)
+      return -1;
+   if (message.isController())
+   {
+      int cc = message.getControllerNumber();
+      //these are parts of multi-message sequences (bank select, rpn/nrpn and their data entry) or mode messages, every one of them has to go out in order
+      if (cc == 0 || cc == 6 || cc == 32 || cc == 38 || (cc >= 96 && cc <= 101) || cc >= 120)
+         return -1;
+      return channel * 128 + cc;
+   }
+   if (message.isPitchWheel())
+      return 16 * 128 + channel;
+   if (message.isChannelPressure())
+      return 16 * 128 + 16 + channel;
+   return -1;
+}
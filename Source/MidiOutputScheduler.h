@@ -0,0 +1,73 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    MidiOutputScheduler.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include "juce_audio_devices/juce_audio_devices.h"
+
+//sends midi to an output device from its own thread, at the wall-clock time each message was scheduled for
+//senders (usually the audio thread) only copy into a preallocated ring, so a slow driver can't stall them
+class MidiOutputScheduler : public juce::Thread
+{
+public:
+   MidiOutputScheduler();
+   ~MidiOutputScheduler();
+
+   void Start(juce::MidiOutput* output);
+   void Stop(); //sends whatever is still pending, so note offs aren't lost
+
+   //timeMs is on juce::Time::getMillisecondCounterHiRes()
+   void Schedule(const juce::MidiMessage& message, double timeMs);
+   int GetDroppedMessages() const { return mDroppedMessages; }
+
+private:
+   struct Event
+   {
+      double mTimeMs{ 0 };
+      juce::MidiMessage mMessage;
+   };
+
+   void run() override;
+   void Drain();
+   void SendDue(double nowMs);
+   static int GetCoalesceKey(const juce::MidiMessage& message);
+
+   static const int kQueueSize = 4096;
+   static const int kNumCoalesceKeys = 16 * 128 + 16 + 16; //cc per channel, pitch bend per channel, channel pressure per channel
+
+   juce::MidiOutput* mOutput{ nullptr };
+
+   std::vector<Event> mQueue;
+   juce::AbstractFifo mFifo{ kQueueSize };
+   juce::SpinLock mWriteLock; //only serializes senders, held just long enough to swap one message into the queue
+   std::atomic<int> mDroppedMessages{ 0 };
+
+   //only touched by the sending thread
+   std::vector<Event> mPending; //sorted by time
+   std::vector<bool> mCoalesceSeen;
+};
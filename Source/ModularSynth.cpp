@@ -38,6 +38,7 @@
 #include "ClickButton.h"
 #include "UserPrefs.h"
 #include "NoteOutputQueue.h"
+#include "SaveStateIndex.h"
 
 #include "juce_audio_processors/juce_audio_processors.h"
 #include "juce_audio_formats/juce_audio_formats.h"
@@ -95,8 +96,23 @@ ModularSynth::ModularSynth()
 ModularSynth::~ModularSynth()
 {
    DeleteAllModules();
+   mSampleLibraryIndex.Stop();
 
-   delete mGlobalRecordBuffer;
+   for (auto* spooler : mOutputSpoolers)
+   {
+      if (spooler != nullptr && spooler->IsOpen())
+      {
+         spooler->Close();
+         juce::File(spooler->GetPath()).deleteFile();
+      }
+      delete spooler;
+   }
+   if (!mPreviousOutputSpoolPath.empty())
+      juce::File(mPreviousOutputSpoolPath).deleteFile();
+   if (!mSpoolDirectory.empty())
+      juce::File(mSpoolDirectory).deleteRecursively();
+   mSpoolLock.reset();
+   delete mLissajousBuffer;
    mAudioPluginFormatManager.reset();
    mKnownPluginList.reset();
 
@@ -234,8 +250,8 @@ void ModularSynth::Setup(juce::AudioDeviceManager* globalAudioDeviceManager, juc
 
    mIOBufferSize = gBufferSize;
 
-   mGlobalRecordBuffer = new RollingBuffer(UserPrefs.record_buffer_length_minutes.Get() * 60 * gSampleRate);
-   mGlobalRecordBuffer->SetNumChannels(2);
+   mLissajousBuffer = new RollingBuffer(gSampleRate / 10);
+   mLissajousBuffer->SetNumChannels(2);
 
    juce::File(ofToDataPath("savestate")).createDirectory();
    juce::File(ofToDataPath("savestate/autosave")).createDirectory();
@@ -245,8 +261,37 @@ void ModularSynth::Setup(juce::AudioDeviceManager* globalAudioDeviceManager, juc
    juce::File(ofToDataPath("internal")).createDirectory();
    juce::File(ofToDataPath("vst")).createDirectory();
 
+   //each running instance spools into its own directory, and holds a lock named after it for as long as it runs
+   //a directory whose lock we can take was left behind by an instance that crashed, so clean it up
+   juce::File spoolRoot(ofToDataPath(UserPrefs.recordings_path.Get() + "spool"));
+   for (const auto& instanceDir : spoolRoot.findChildFiles(juce::File::findDirectories, false))
+   {
+      juce::InterProcessLock instanceLock("bespoke_spool_" + instanceDir.getFileName());
+      if (instanceLock.enter(0))
+      {
+         instanceDir.deleteRecursively();
+         instanceLock.exit();
+      }
+   }
+   juce::String instanceId = juce::String::toHexString(juce::Random::getSystemRandom().nextInt64());
+   mSpoolLock = std::make_unique<juce::InterProcessLock>("bespoke_spool_" + instanceId);
+   mSpoolLock->enter(0);
+   juce::File spoolDir = spoolRoot.getChildFile(instanceId);
+   spoolDir.createDirectory();
+   mSpoolDirectory = spoolDir.getFullPathName().toStdString();
+
+   if (UserPrefs.record_output.Get())
+   {
+      for (int i = 0; i < 2; ++i)
+         mOutputSpoolers[i] = new RecordingSpooler(gSampleRate * 5);
+      long long unused;
+      SwitchOutputSpoolFile(unused);
+   }
+
    SynthInit();
 
+   mSampleLibraryIndex.Start(mGlobalAudioFormatManager);
+
    new Transport();
    new Scale();
    TheScale->CreateUIControls();
@@ -428,6 +473,14 @@ void ModularSynth::Poll()
       mArrangeDependenciesWhenLoadCompletes = false;
    }
 
+   long long maxRecordingLength = UserPrefs.record_buffer_length_minutes.Get() * 60 * gSampleRate;
+   if (mOutputSpoolers[mActiveOutputSpooler] != nullptr && mOutputSpoolers[mActiveOutputSpooler]->GetLength() >= maxRecordingLength)
+   {
+      if (!mPreviousOutputSpoolPath.empty())
+         juce::File(mPreviousOutputSpoolPath).deleteFile();
+      mPreviousOutputSpoolPath = SwitchOutputSpoolFile(mPreviousOutputSpoolLength);
+   }
+
    ++sFrameCount;
 }
 
@@ -508,7 +561,7 @@ void ModularSynth::Draw(void* vg)
    }
 
    if (UserPrefs.draw_background_lissajous.Get())
-      DrawLissajous(mGlobalRecordBuffer, 0, 0, ofGetWidth(), ofGetHeight(), sBackgroundLissajousR, sBackgroundLissajousG, sBackgroundLissajousB);
+      DrawLissajous(mLissajousBuffer, 0, 0, ofGetWidth(), ofGetHeight(), sBackgroundLissajousR, sBackgroundLissajousG, sBackgroundLissajousB);
 
    if (gTime == 1 && mFatalError == "")
    {
@@ -924,6 +977,7 @@ void ModularSynth::Exit()
    mAudioThreadMutex.Unlock();
    mModuleContainer.Exit();
    DeleteAllModules();
+   mSampleLibraryIndex.Stop();
    ofExit();
 }
 
@@ -1840,6 +1894,7 @@ void ModularSynth::OnModuleDeleted(IDrawableModule* module)
       return;
 
    mDeletedModules.push_back(module);
+   ++IClickable::sPathGeneration;
 
    mAudioThreadMutex.Lock("delete");
 
@@ -1964,6 +2019,13 @@ void ModularSynth::AudioOut(float** output, int bufferSize, int nChannels)
 
    ScopedMutex mutex(&mAudioThreadMutex, "audioOut()");
 
+   if (mAudioPaused) //paused (to load a layout, for instance) while we were waiting on the lock
+   {
+      for (int ch = 0; ch < nChannels; ++ch)
+         Clear(output[ch], bufferSize);
+      return;
+   }
+
    /////////// AUDIO PROCESSING STARTS HERE /////////////
    mNoteOutputQueue->Process();
 
@@ -1985,7 +2047,7 @@ void ModularSynth::AudioOut(float** output, int bufferSize, int nChannels)
 
       //process all audio
       for (int i = 0; i < mSources.size(); ++i)
-         mSources[i]->Process(gTime);
+         mSources[i]->ProcessOrSleep(gTime);
 
       //put it into speakers
       for (int i = 0; i < nChannels; ++i)
@@ -2021,11 +2083,11 @@ void ModularSynth::AudioOut(float** output, int bufferSize, int nChannels)
    }
    /////////// AUDIO PROCESSING ENDS HERE /////////////
    if (nChannels >= 1)
-      mGlobalRecordBuffer->WriteChunk(output[0], bufferSize, 0);
+      mLissajousBuffer->WriteChunk(output[0], bufferSize, 0);
    if (nChannels >= 2)
-      mGlobalRecordBuffer->WriteChunk(output[1], bufferSize, 1);
-   mRecordingLength += bufferSize;
-   mRecordingLength = MIN(mRecordingLength, mGlobalRecordBuffer->Size());
+      mLissajousBuffer->WriteChunk(output[1], bufferSize, 1);
+   if (mOutputSpoolers[mActiveOutputSpooler] != nullptr)
+      mOutputSpoolers[mActiveOutputSpooler]->Write(output, MIN(nChannels, 2), bufferSize);
 
    Profiler::PrintCounters();
 }
@@ -2037,6 +2099,9 @@ void ModularSynth::AudioIn(const float** input, int bufferSize, int nChannels)
 
    ScopedMutex mutex(&mAudioThreadMutex, "audioIn()");
 
+   if (mAudioPaused)
+      return;
+
    int oversampling = UserPrefs.oversampling.Get();
 
    assert(bufferSize * oversampling == mIOBufferSize);
@@ -2451,18 +2516,31 @@ void ModularSynth::LoadLayout(ofxJSONElement json)
 
    //ofLoadURLAsync("http://bespoke.com/telemetry/"+jsonFile);
 
-   ScopedMutex mutex(&mAudioThreadMutex, "LoadLayout()");
-   std::lock_guard<std::recursive_mutex> renderLock(mRenderLock);
+   //pause audio rather than holding the audio mutex for the whole load. building a large layout can take a while,
+   //and the audio callback should keep returning silence in the meantime instead of blocking the device.
+   //taking the lock to flip the flag guarantees the callback isn't partway through processing the old layout
+   mAudioThreadMutex.Lock("LoadLayout()");
+   bool wasPaused = mAudioPaused;
+   mAudioPaused = true;
+   mAudioThreadMutex.Unlock();
 
-   ResetLayout();
+   {
+      std::lock_guard<std::recursive_mutex> renderLock(mRenderLock);
 
-   mModuleContainer.LoadModules(json["modules"]);
-   mUILayerModuleContainer.LoadModules(json["ui_modules"]);
+      ResetLayout();
 
-   //timer.PrintCosts();
+      mModuleContainer.LoadModules(json["modules"]);
+      mUILayerModuleContainer.LoadModules(json["ui_modules"]);
 
-   mZoomer.LoadFromSaveData(json["zoomlocations"]);
-   ArrangeAudioSourceDependencies();
+      //timer.PrintCosts();
+
+      mZoomer.LoadFromSaveData(json["zoomlocations"]);
+      ArrangeAudioSourceDependencies();
+   }
+
+   mAudioThreadMutex.Lock("LoadLayout()");
+   mAudioPaused = wasPaused;
+   mAudioThreadMutex.Unlock();
 }
 
 void ModularSynth::UpdateUserPrefsLayout()
@@ -2647,6 +2725,7 @@ void ModularSynth::GrabSample(std::string filePath)
    delete mHeldSample;
    mHeldSample = new Sample();
    mHeldSample->Read(filePath.c_str());
+   mHeldSample->WaitForSampleRateConversion();
 }
 
 void ModularSynth::ClearHeldSample()
@@ -2796,8 +2875,10 @@ void ModularSynth::SaveState(std::string file, bool autosave)
 
    mZoomer.WriteCurrentLocation(-1);
    out << GetLayout().getRawString(true);
-   mModuleContainer.SaveState(out);
-   mUILayerModuleContainer.SaveState(out);
+   SaveStateIndex index;
+   mModuleContainer.SaveState(out, &index);
+   mUILayerModuleContainer.SaveState(out, &index);
+   index.Write(out);
 
    mAudioThreadMutex.Unlock();
 }
@@ -2843,6 +2924,9 @@ void ModularSynth::LoadState(std::string file)
    if (firstLength[0] >= FileStreamIn::sMaxStringLength)
       FileStreamIn::s32BitMode = true;
 
+   SaveStateIndex index;
+   bool hasIndex = index.Read(in);
+
    std::string jsonString;
    in >> jsonString;
    bool layoutLoaded = LoadLayoutFromString(jsonString);
@@ -2850,9 +2934,9 @@ void ModularSynth::LoadState(std::string file)
    if (layoutLoaded)
    {
       mIsLoadingModule = true;
-      mModuleContainer.LoadState(in);
+      mModuleContainer.LoadState(in, hasIndex ? &index : nullptr);
       if (ModularSynth::sLastLoadedFileSaveStateRev >= 424)
-         mUILayerModuleContainer.LoadState(in);
+         mUILayerModuleContainer.LoadState(in, hasIndex ? &index : nullptr);
       mIsLoadingModule = false;
 
       TheTransport->Reset();
@@ -3211,9 +3295,34 @@ void ModularSynth::ReconnectMidiDevices()
       mMidiDevices[i]->Reconnect();
 }
 
+std::string ModularSynth::SwitchOutputSpoolFile(long long& oldFileLength)
+{
+   int newIndex = 1 - mActiveOutputSpooler;
+   RecordingSpooler* newSpooler = mOutputSpoolers[newIndex];
+   RecordingSpooler* oldSpooler = mOutputSpoolers[mActiveOutputSpooler];
+
+   newSpooler->Open(juce::File(mSpoolDirectory).getNonexistentChildFile("output", ".wav").getFullPathName().toStdString());
+
+   {
+      ScopedMutex mutex(&mAudioThreadMutex, "SwitchOutputSpoolFile()");
+      mActiveOutputSpooler = newIndex;
+   }
+
+   oldFileLength = 0;
+   if (!oldSpooler->IsOpen())
+      return "";
+   oldFileLength = oldSpooler->GetLength();
+   oldSpooler->Close();
+   return oldSpooler->GetPath();
+}
+
 void ModularSynth::SaveOutput()
 {
-   ScopedMutex mutex(&mAudioThreadMutex, "SaveOutput()");
+   if (mOutputSpoolers[mActiveOutputSpooler] == nullptr)
+   {
+      LogEvent("output recording is disabled, enable record_output in the settings to use this", kLogEventType_Error);
+      return;
+   }
 
    std::string save_prefix = "recording_";
    if (!mCurrentSaveStatePath.empty())
@@ -3226,7 +3335,12 @@ void ModularSynth::SaveOutput()
    std::string filename = ofGetTimestampString(UserPrefs.recordings_path.Get() + save_prefix + "%Y-%m-%d_%H-%M.wav");
    //string filenamePos = ofGetTimestampString("recordings/pos_%Y-%m-%d_%H-%M.wav");
 
-   assert(mRecordingLength <= mGlobalRecordBuffer->Size());
+   //start a new spool file, and assemble the recording from the ones we have so far without holding up the audio thread
+   long long currentFileLength;
+   std::string currentPath = SwitchOutputSpoolFile(currentFileLength);
+   long long maxRecordingLength = UserPrefs.record_buffer_length_minutes.Get() * 60 * gSampleRate;
+   long long currentLength = std::min(currentFileLength, maxRecordingLength);
+   long long previousLength = std::clamp(maxRecordingLength - currentLength, 0LL, mPreviousOutputSpoolLength);
 
    int channels = 2;
    auto wavFormat = std::make_unique<juce::WavAudioFormat>();
@@ -3237,25 +3351,23 @@ void ModularSynth::SaveOutput()
    bool b1{ false };
    auto writer = std::unique_ptr<juce::AudioFormatWriter>(wavFormat->createWriterFor(outputTo.release(), gSampleRate, channels, 16, b1, 0));
 
-   long long samplesRemaining = mRecordingLength;
-   const int chunkSize = 256;
-   float leftChannel[chunkSize];
-   float rightChannel[chunkSize];
-   float* chunk[2]{ leftChannel, rightChannel };
-   while (samplesRemaining > 0)
+   auto appendFromSpoolFile = [&](const std::string& path, long long fileLength, long long length)
    {
-      int numSamples = MIN(chunkSize, samplesRemaining);
-      for (int i = 0; i < numSamples; ++i)
-      {
-         chunk[0][i] = mGlobalRecordBuffer->GetSample(samplesRemaining - 1, 0);
-         chunk[1][i] = mGlobalRecordBuffer->GetSample(samplesRemaining - 1, 1);
-         --samplesRemaining;
-      }
-      writer->writeFromFloatArrays(chunk, channels, numSamples);
-   }
-
-   mGlobalRecordBuffer->ClearBuffer();
-   mRecordingLength = 0;
+      if (path.empty() || length <= 0)
+         return;
+      std::unique_ptr<juce::AudioFormatReader> reader(wavFormat->createReaderFor(new juce::FileInputStream(juce::File(path)), true));
+      if (reader != nullptr)
+         writer->writeFromAudioReader(*reader, fileLength - length, length);
+   };
+   appendFromSpoolFile(mPreviousOutputSpoolPath, mPreviousOutputSpoolLength, previousLength);
+   appendFromSpoolFile(currentPath, currentFileLength, currentLength);
+
+   if (!mPreviousOutputSpoolPath.empty())
+      juce::File(mPreviousOutputSpoolPath).deleteFile();
+   if (!currentPath.empty())
+      juce::File(currentPath).deleteFile();
+   mPreviousOutputSpoolPath = "";
+   mPreviousOutputSpoolLength = 0;
 }
 
 const String& ModularSynth::GetTextFromClipboard() const
@@ -8,6 +8,8 @@
 #include "IDrawableModule.h"
 #include "TextEntry.h"
 #include "RollingBuffer.h"
+#include "RecordingSpooler.h"
+#include "SampleLibraryIndex.h"
 #include "NamedMutex.h"
 #include "ofxJSONElement.h"
 #include "ModuleFactory.h"
@@ -202,6 +204,7 @@ public:
    ModuleFactory* GetModuleFactory() { return &mModuleFactory; }
    juce::AudioDeviceManager& GetAudioDeviceManager() { return *mGlobalAudioDeviceManager; }
    juce::AudioFormatManager& GetAudioFormatManager() { return *mGlobalAudioFormatManager; }
+   SampleLibraryIndex* GetSampleLibraryIndex() { return &mSampleLibraryIndex; }
    juce::AudioPluginFormatManager& GetAudioPluginFormatManager() { return *mAudioPluginFormatManager.get(); }
    juce::KnownPluginList& GetKnownPluginList() { return *mKnownPluginList.get(); }
    juce::Component* GetMainComponent() { return mMainComponent; }
@@ -235,6 +238,7 @@ public:
    float GetFrameRate() const { return mFrameRate; }
    std::recursive_mutex& GetRenderLock() { return mRenderLock; }
    NamedMutex* GetAudioMutex() { return &mAudioThreadMutex; }
+   const std::string& GetSpoolDirectory() const { return mSpoolDirectory; } //where this instance keeps recordings in progress
    static std::thread::id GetAudioThreadID() { return sAudioThreadId; }
    NoteOutputQueue* GetNoteOutputQueue() { return mNoteOutputQueue; }
 
@@ -347,8 +351,17 @@ private:
    std::unique_ptr<Minimap> mMinimap{ nullptr };
    UserPrefsEditor* mUserPrefsEditor{ nullptr };
 
-   RollingBuffer* mGlobalRecordBuffer{ nullptr };
-   long long mRecordingLength{ 0 };
+   //the output is spooled to disk in segments of record_buffer_length_minutes, keeping the previous segment around so we always have that much to save
+   std::string SwitchOutputSpoolFile(long long& oldFileLength);
+   RollingBuffer* mLissajousBuffer{ nullptr };
+   RecordingSpooler* mOutputSpoolers[2]{};
+   std::atomic<int> mActiveOutputSpooler{ 0 };
+   std::string mPreviousOutputSpoolPath;
+   long long mPreviousOutputSpoolLength{ 0 };
+   std::string mSpoolDirectory;
+   std::unique_ptr<juce::InterProcessLock> mSpoolLock; //held while we run, so other instances leave mSpoolDirectory alone
+
+   SampleLibraryIndex mSampleLibraryIndex;
 
    struct LogEventItem
    {
@@ -35,6 +35,7 @@
 #include "SynthGlobals.h"
 #include "QuickSpawnMenu.h"
 #include "Prefab.h"
+#include "SaveStateIndex.h"
 
 #include "juce_core/juce_core.h"
 
@@ -61,10 +62,37 @@ void ModuleContainer::GetAllModules(std::vector<IDrawableModule*>& out)
 
 void ModuleContainer::Draw()
 {
-   for (int i = (int)mModules.size() - 1; i >= 0; --i)
+   if (mOwner == nullptr)
+      mSpatialIndex.Refresh(mModules);
+
+   if (this == TheSynth->GetRootContainer())
    {
-      if (!mModules[i]->AlwaysOnTop())
-         mModules[i]->Draw();
+      //only draw what's on screen. always-on-top modules are few and tend to be pinned to the view, so they skip the culling
+      ofRectangle drawRect = TheSynth->GetDrawRect();
+      mSpatialIndex.Query(mModules, drawRect, mVisibleModules);
+      for (int i = (int)mVisibleModules.size() - 1; i >= 0; --i)
+      {
+         if (!mVisibleModules[i]->AlwaysOnTop())
+            mVisibleModules[i]->Draw();
+      }
+
+      //the query comes back in container order, so the skipped modules are the gaps between matches
+      size_t visibleIndex = 0;
+      for (auto* module : mModules)
+      {
+         if (visibleIndex < mVisibleModules.size() && mVisibleModules[visibleIndex] == module)
+            ++visibleIndex;
+         else if (!module->AlwaysOnTop())
+            module->UpdateMinimizeAnimation(); //keep the size current for cables and the index while it's offscreen
+      }
+   }
+   else
+   {
+      for (int i = (int)mModules.size() - 1; i >= 0; --i)
+      {
+         if (!mModules[i]->AlwaysOnTop())
+            mModules[i]->Draw();
+      }
    }
 
    for (int i = (int)mModules.size() - 1; i >= 0; --i)
@@ -135,6 +163,7 @@ void ModuleContainer::Clear()
       }
    }
    mModules.clear();
+   mSpatialIndex.Invalidate();
 }
 
 void ModuleContainer::Exit()
@@ -214,11 +243,19 @@ IDrawableModule* ModuleContainer::GetModuleAt(float x, float y)
          return modalItems[i];
    }
 
-   for (int i = 0; i < mModules.size(); ++i)
+   //only test the modules that could be under the point
+   const std::vector<IDrawableModule*>* candidates = &mModules;
+   if (mOwner == nullptr)
+   {
+      mSpatialIndex.Query(mModules, x, y, mModulesUnderPoint);
+      candidates = &mModulesUnderPoint;
+   }
+
+   for (auto* module : *candidates)
    {
-      if (mModules[i]->AlwaysOnTop() && mModules[i]->TestClick(x, y, false, true))
+      if (module->AlwaysOnTop() && module->TestClick(x, y, false, true))
       {
-         ModuleContainer* subcontainer = mModules[i]->GetContainer();
+         ModuleContainer* subcontainer = module->GetContainer();
          if (subcontainer)
          {
             IDrawableModule* contained = subcontainer->GetModuleAt(x - subcontainer->GetOwnerPosition().x, y - subcontainer->GetOwnerPosition().y);
@@ -227,14 +264,14 @@ IDrawableModule* ModuleContainer::GetModuleAt(float x, float y)
                return contained;
             }
          }
-         return mModules[i];
+         return module;
       }
    }
-   for (int i = 0; i < mModules.size(); ++i)
+   for (auto* module : *candidates)
    {
-      if (!mModules[i]->AlwaysOnTop() && mModules[i]->TestClick(x, y, false, true))
+      if (!module->AlwaysOnTop() && module->TestClick(x, y, false, true))
       {
-         ModuleContainer* subcontainer = mModules[i]->GetContainer();
+         ModuleContainer* subcontainer = module->GetContainer();
          if (subcontainer)
          {
             IDrawableModule* contained = subcontainer->GetModuleAt(x, y);
@@ -243,7 +280,7 @@ IDrawableModule* ModuleContainer::GetModuleAt(float x, float y)
                return contained;
             }
          }
-         return mModules[i];
+         return module;
       }
    }
    return nullptr;
@@ -285,6 +322,7 @@ void ModuleContainer::MoveToFront(IDrawableModule* module)
          for (int j = i; j > 0; --j)
             mModules[j] = mModules[j - 1];
          mModules[0] = module;
+         mSpatialIndex.Invalidate();
 
          break;
       }
@@ -294,6 +332,7 @@ void ModuleContainer::MoveToFront(IDrawableModule* module)
 void ModuleContainer::AddModule(IDrawableModule* module)
 {
    mModules.push_back(module);
+   mSpatialIndex.Invalidate();
    MoveToFront(module);
    TheSynth->OnModuleAdded(module);
    module->SetOwningContainer(this);
@@ -308,10 +347,12 @@ void ModuleContainer::TakeModule(IDrawableModule* module)
    if (module->GetOwningContainer()->mOwner)
       module->GetOwningContainer()->mOwner->RemoveChild(module);
    RemoveFromVector(module, module->GetOwningContainer()->mModules);
+   module->GetOwningContainer()->mSpatialIndex.Invalidate();
 
    std::string newName = GetUniqueName(module->Name(), mModules);
 
    mModules.push_back(module);
+   mSpatialIndex.Invalidate();
    MoveToFront(module);
 
    ofVec2f offset = oldOwnerPos - GetOwnerPosition();
@@ -333,6 +374,7 @@ void ModuleContainer::DeleteModule(IDrawableModule* module, bool fail /*= true*/
    {
       module->DoSpecialDelete();
       RemoveFromVector(module, mModules, fail);
+      mSpatialIndex.Invalidate();
       return;
    }
 
@@ -340,6 +382,7 @@ void ModuleContainer::DeleteModule(IDrawableModule* module, bool fail /*= true*/
       module->GetParent()->GetModuleParent()->RemoveChild(module);
 
    RemoveFromVector(module, mModules, fail);
+   mSpatialIndex.Invalidate();
    for (const auto iter : mModules)
    {
       if (iter->GetPatchCableSource())
@@ -406,11 +449,12 @@ IDrawableModule* ModuleContainer::FindModule(std::string name, bool fail)
    if (name == "")
       return nullptr;
 
+   //split once up front, every reference in a layout gets resolved through here while loading
+   std::vector<std::string> tokens = ofSplitString(name, "~");
    for (int i = 0; i < mModules.size(); ++i)
    {
       if (name == mModules[i]->Name())
          return mModules[i];
-      std::vector<std::string> tokens = ofSplitString(name, "~");
       if (mModules[i]->GetContainer())
       {
          if (tokens[0] == mModules[i]->Name())
@@ -597,7 +641,7 @@ ofxJSONElement ModuleContainer::WriteModules()
    return modules;
 }
 
-void ModuleContainer::SaveState(FileStreamOut& out)
+void ModuleContainer::SaveState(FileStreamOut& out, SaveStateIndex* index /*= nullptr*/)
 {
    out << ModularSynth::kSaveStateRev;
 
@@ -618,17 +662,20 @@ void ModuleContainer::SaveState(FileStreamOut& out)
       if (module->IsSaveable())
       {
          //ofLog() << "Saving " << module->Name();
+         std::int64_t sectionStart = out.GetPosition();
          out << std::string(module->Name());
          module->SaveState(out);
          for (int i = 0; i < GetModuleSeparatorLength(); ++i)
             out << GetModuleSeparator()[i];
+         if (index)
+            index->AddSection(module->Name(), sectionStart, out.GetPosition());
       }
    }
 
    IClickable::ClearSaveContext();
 }
 
-void ModuleContainer::LoadState(FileStreamIn& in)
+void ModuleContainer::LoadState(FileStreamIn& in, const SaveStateIndex* index /*= nullptr*/)
 {
    Prefab::sLastLoadWasPrefab = Prefab::sLoadingPrefab;
 
@@ -652,8 +699,11 @@ void ModuleContainer::LoadState(FileStreamIn& in)
 
    for (int i = 0; i < savedModules; ++i)
    {
+      const SaveStateIndex::Section* section = index ? index->FindSection(in.GetPosition()) : nullptr;
       std::string moduleName;
       in >> moduleName;
+      if (section && section->mModule != moduleName)
+         section = nullptr;
       //ofLog() << "Loading " << moduleName;
       IDrawableModule* module = FindModule(moduleName, false);
       try
@@ -689,6 +739,13 @@ void ModuleContainer::LoadState(FileStreamIn& in)
       {
          TheSynth->LogEvent("Error loading state for module \"" + moduleName + "\"", kLogEventType_Error);
 
+         if (section)
+         {
+            //we know exactly where the next module starts
+            in.Seek(section->mEnd);
+            continue;
+         }
+
          //read through the rest of the module until we find the spacer, so we can continue loading the next module
          int separatorProgress = 0;
          juce::uint64 safetyCheck = 0;
@@ -31,6 +31,9 @@
 #include "OpenFrameworksPort.h"
 #include "IDrawableModule.h"
 #include "ofxJSONElement.h"
+#include "ModuleSpatialIndex.h"
+
+class SaveStateIndex;
 
 class ModuleContainer
 {
@@ -69,6 +72,7 @@ public:
    IUIControl* FindUIControl(std::string path);
    bool IsHigherThan(IDrawableModule* checkFor, IDrawableModule* checkAgainst) const;
    void GetAllModules(std::vector<IDrawableModule*>& out);
+   void InvalidateSpatialIndex() { mSpatialIndex.Invalidate(); }
 
    template <class T>
    std::vector<std::string> GetModuleNames()
@@ -84,8 +88,8 @@ public:
 
    void LoadModules(const ofxJSONElement& modules);
    ofxJSONElement WriteModules();
-   void SaveState(FileStreamOut& out);
-   void LoadState(FileStreamIn& in);
+   void SaveState(FileStreamOut& out, SaveStateIndex* index = nullptr); //index collects where each module's state was written
+   void LoadState(FileStreamIn& in, const SaveStateIndex* index = nullptr); //with an index, a module that fails to load is skipped by seeking past it
 
    static constexpr int GetModuleSeparatorLength() { return 13; }
    static const char* GetModuleSeparator() { return "ryanchallinor"; }
@@ -94,6 +98,9 @@ public:
 private:
    std::vector<IDrawableModule*> mModules;
    IDrawableModule* mOwner{ nullptr };
+   ModuleSpatialIndex mSpatialIndex; //only maintained for top-level containers, prefabs and the like hold too few modules to bother
+   std::vector<IDrawableModule*> mVisibleModules;
+   std::vector<IDrawableModule*> mModulesUnderPoint;
 
    ofVec2f mDrawOffset;
    float mDrawScale{ 1 };
@@ -0,0 +1,201 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    ModuleSpatialIndex.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ModuleSpatialIndex.h"
+#include "IDrawableModule.h"
+
+#include <algorithm>
+#include <cmath>
+
+ofRectangle ModuleSpatialIndex::GetBounds(IDrawableModule* module)
+{
+   //same area as IDrawableModule::IsWithinRect() and IClickable::TestClick(), in the container's coordinates
+   float x, y;
+   module->GetPosition(x, y, true);
+   float w, h;
+   module->GetDimensions(w, h);
+
+   float titleBarHeight = module->HasTitleBar() ? IDrawableModule::TitleBarHeight() : 0;
+
+   ofRectangle bounds(x, y - titleBarHeight, w, h + titleBarHeight);
+   bounds.grow(kBoundsMargin);
+   return bounds;
+}
+
+void ModuleSpatialIndex::Refresh(const std::vector<IDrawableModule*>& modules)
+{
+   if (!mDirty)
+   {
+      if (modules.size() != mEntries.size())
+      {
+         mDirty = true;
+      }
+      else
+      {
+         for (size_t i = 0; i < modules.size(); ++i)
+         {
+            const Entry& entry = mEntries[i];
+            if (entry.mModule != modules[i] || entry.mShowing != modules[i]->IsShowing())
+            {
+               mDirty = true;
+               break;
+            }
+
+            ofRectangle bounds = GetBounds(modules[i]);
+            if (bounds.x != entry.mBounds.x || bounds.y != entry.mBounds.y ||
+                bounds.width != entry.mBounds.width || bounds.height != entry.mBounds.height)
+            {
+               mDirty = true;
+               break;
+            }
+         }
+      }
+   }
+
+   if (mDirty)
+      Rebuild(modules);
+}
+
+void ModuleSpatialIndex::Rebuild(const std::vector<IDrawableModule*>& modules)
+{
+   for (auto& cell : mCells)
+      cell.second.clear(); //keep the allocations around, the same cells tend to get used again
+
+   mEntries.resize(modules.size());
+   for (size_t i = 0; i < modules.size(); ++i)
+   {
+      Entry& entry = mEntries[i];
+      entry.mModule = modules[i];
+      entry.mShowing = modules[i]->IsShowing();
+      entry.mBounds = GetBounds(modules[i]);
+
+      if (!entry.mShowing)
+         continue;
+
+      int cellX0 = (int)floorf(entry.mBounds.x / kCellSize);
+      int cellY0 = (int)floorf(entry.mBounds.y / kCellSize);
+      int cellX1 = (int)floorf((entry.mBounds.x + entry.mBounds.width) / kCellSize);
+      int cellY1 = (int)floorf((entry.mBounds.y + entry.mBounds.height) / kCellSize);
+      for (int cellY = cellY0; cellY <= cellY1; ++cellY)
+      {
+         for (int cellX = cellX0; cellX <= cellX1; ++cellX)
+            mCells[GetCellKey(cellX, cellY)].push_back((int)i);
+      }
+   }
+
+   mQueryStamps.assign(mEntries.size(), 0);
+   mQueryStamp = 0;
+   mDirty = false;
+}
+
+void ModuleSpatialIndex::BeginQuery(std::vector<IDrawableModule*>& output)
+{
+   output.clear();
+   mQueryResult.clear();
+   ++mQueryStamp;
+   if (mQueryStamp == 0) //wrapped around
+   {
+      std::fill(mQueryStamps.begin(), mQueryStamps.end(), 0);
+      mQueryStamp = 1;
+   }
+}
+
+void ModuleSpatialIndex::Gather(const std::vector<int>& cell)
+{
+   for (int index : cell)
+   {
+      if (mQueryStamps[index] != mQueryStamp) //modules spanning several cells only get reported once
+      {
+         mQueryStamps[index] = mQueryStamp;
+         mQueryResult.push_back(index);
+      }
+   }
+}
+
+void ModuleSpatialIndex::EndQuery(std::vector<IDrawableModule*>& output)
+{
+   std::sort(mQueryResult.begin(), mQueryResult.end());
+   for (int index : mQueryResult)
+      output.push_back(mEntries[index].mModule);
+}
+
+void ModuleSpatialIndex::Query(const std::vector<IDrawableModule*>& modules, const ofRectangle& rect, std::vector<IDrawableModule*>& output)
+{
+   if (mDirty)
+      Rebuild(modules);
+
+   BeginQuery(output);
+
+   int cellX0 = (int)floorf(rect.x / kCellSize);
+   int cellY0 = (int)floorf(rect.y / kCellSize);
+   int cellX1 = (int)floorf((rect.x + rect.width) / kCellSize);
+   int cellY1 = (int)floorf((rect.y + rect.height) / kCellSize);
+   if ((long long)(cellX1 - cellX0 + 1) * (cellY1 - cellY0 + 1) > (long long)mCells.size())
+   {
+      //zoomed way out, it's cheaper to walk the occupied cells than the requested ones
+      for (const auto& cell : mCells)
+         Gather(cell.second);
+   }
+   else
+   {
+      for (int cellY = cellY0; cellY <= cellY1; ++cellY)
+      {
+         for (int cellX = cellX0; cellX <= cellX1; ++cellX)
+         {
+            auto iter = mCells.find(GetCellKey(cellX, cellY));
+            if (iter != mCells.end())
+               Gather(iter->second);
+         }
+      }
+   }
+
+   //cells are coarse, trim down to the modules that actually overlap
+   mQueryResult.erase(std::remove_if(mQueryResult.begin(), mQueryResult.end(), [this, &rect](int index)
+                                     { return !rect.intersects(mEntries[index].mBounds); }),
+                      mQueryResult.end());
+
+   EndQuery(output);
+}
+
+void ModuleSpatialIndex::Query(const std::vector<IDrawableModule*>& modules, float x, float y, std::vector<IDrawableModule*>& output)
+{
+   if (mDirty)
+      Rebuild(modules);
+
+   BeginQuery(output);
+
+   auto iter = mCells.find(GetCellKey((int)floorf(x / kCellSize), (int)floorf(y / kCellSize)));
+   if (iter != mCells.end())
+   {
+      for (int index : iter->second)
+      {
+         if (mEntries[index].mBounds.contains(x, y))
+            mQueryResult.push_back(index); //a point only falls in one cell, no need to dedupe
+      }
+   }
+
+   EndQuery(output);
+}
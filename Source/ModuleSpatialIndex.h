@@ -0,0 +1,72 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    ModuleSpatialIndex.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "OpenFrameworksPort.h"
+
+class IDrawableModule;
+
+//uniform grid over a container's modules, so drawing and hit-testing only have to look at the modules near the area of interest
+//module dimensions are computed on the fly rather than stored, so the owner calls Refresh() once per frame to pick up resizes. moves and add/remove/reorder invalidate it immediately
+class ModuleSpatialIndex
+{
+public:
+   void Invalidate() { mDirty = true; }
+   void Refresh(const std::vector<IDrawableModule*>& modules);
+
+   //modules whose bounds intersect rect, in container order (frontmost first)
+   void Query(const std::vector<IDrawableModule*>& modules, const ofRectangle& rect, std::vector<IDrawableModule*>& output);
+   //modules whose bounds contain the point, in container order (frontmost first)
+   void Query(const std::vector<IDrawableModule*>& modules, float x, float y, std::vector<IDrawableModule*>& output);
+
+private:
+   struct Entry
+   {
+      IDrawableModule* mModule{ nullptr };
+      ofRectangle mBounds;
+      bool mShowing{ false };
+   };
+
+   static ofRectangle GetBounds(IDrawableModule* module);
+   static unsigned long long GetCellKey(int cellX, int cellY) { return ((unsigned long long)(unsigned int)cellX << 32) | (unsigned int)cellY; }
+   void Rebuild(const std::vector<IDrawableModule*>& modules);
+   void BeginQuery(std::vector<IDrawableModule*>& output);
+   void Gather(const std::vector<int>& cell);
+   void EndQuery(std::vector<IDrawableModule*>& output);
+
+   static constexpr float kCellSize = 512;
+   static constexpr float kBoundsMargin = 20; //room for patch cable sources and the resize handle, which poke out of the module rect
+
+   std::vector<Entry> mEntries; //same order as the container
+   std::unordered_map<unsigned long long, std::vector<int>> mCells;
+   std::vector<int> mQueryResult;
+   std::vector<unsigned int> mQueryStamps;
+   unsigned int mQueryStamp{ 0 };
+   bool mDirty{ true };
+};
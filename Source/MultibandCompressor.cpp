@@ -33,6 +33,9 @@ MultibandCompressor::MultibandCompressor()
    mWorkBuffer = new float[GetBuffer()->BufferSize()];
    Clear(mWorkBuffer, GetBuffer()->BufferSize());
 
+   mBandBuffer = new float[GetBuffer()->BufferSize()];
+   Clear(mBandBuffer, GetBuffer()->BufferSize());
+
    mOutBuffer = new float[GetBuffer()->BufferSize()];
    Clear(mOutBuffer, GetBuffer()->BufferSize());
 
@@ -54,6 +57,7 @@ MultibandCompressor::~MultibandCompressor()
 {
    delete[] mOutBuffer;
    delete[] mWorkBuffer;
+   delete[] mBandBuffer;
 }
 
 void MultibandCompressor::Process(double time)
@@ -72,40 +76,22 @@ void MultibandCompressor::Process(double time)
    {
       Clear(mOutBuffer, bufferSize);
 
-      for (int i = 0; i < bufferSize; ++i)
+      //split off one band at a time across the whole block, passing what's left above it on to the next crossover
+      float* highLeftover = mWorkBuffer;
+      BufferCopy(highLeftover, GetBuffer()->GetChannel(0), bufferSize);
+      for (int j = 0; j < mNumBands; ++j)
       {
-         float lower;
-         float highLeftover = GetBuffer()->GetChannel(0)[i];
-         for (int j = 0; j < mNumBands; ++j)
-         {
-            mFilters[j].ProcessSample(highLeftover, lower, highLeftover);
-            mPeaks[j].Process(&lower, 1);
-            float compress = ofClamp(1 / mPeaks[i].GetPeak(), 0, 10);
-            mOutBuffer[i] += lower * compress;
-         }
-         mOutBuffer[i] += highLeftover;
-      }
+         mFilters[j].Process(highLeftover, mBandBuffer, bufferSize);
 
-      /*for (int i=0; i<mNumBands; ++i)
-      {
-         //get carrier band
-         BufferCopy(mWorkBuffer, mInputBuffer, bufferSize);
-         
-         mFilters[i].ProcessSample(const double &sample, double &lowOut, double &highOut)(mWorkBuffer, bufferSize);
-         
-         //calculate modulator band level
-         mPeaks[i].Process(mWorkBuffer, bufferSize);
-         
-         //multiply carrier band by modulator band level
-         if (mPeaks[i].GetPeak() > 0)
+         float decayScalar = mPeaks[j].GetDecayScalar();
+         for (int i = 0; i < bufferSize; ++i)
          {
-            float compress = ofClamp(1/mPeaks[i].GetPeak(), 0, 10);
-            Mult(mWorkBuffer, compress, bufferSize);
+            float peak = mPeaks[j].ProcessSample(mBandBuffer[i], decayScalar);
+            float compress = ofClamp(1 / peak, 0, 10);
+            mOutBuffer[i] += mBandBuffer[i] * compress;
          }
-         
-         //accumulate output band into total output
-         Add(mOutBuffer, mWorkBuffer, bufferSize);
-      }*/
+      }
+      Add(mOutBuffer, highLeftover, bufferSize);
 
       Mult(GetBuffer()->GetChannel(0), (1 - mDryWet), bufferSize);
       Mult(mOutBuffer, mDryWet, bufferSize);
@@ -76,6 +76,7 @@ private:
    void CalcFilters();
 
    float* mWorkBuffer{ nullptr };
+   float* mBandBuffer{ nullptr };
    float* mOutBuffer{ nullptr };
 
    float mDryWet{ 1 };
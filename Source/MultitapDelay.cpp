@@ -98,17 +98,52 @@ void MultitapDelay::Process(double time)
       mDelayBuffer.WriteChunk(GetBuffer()->GetChannel(ch), bufferSize, ch);
    }
 
+   //gather the per-sample tap parameters, so the taps can be processed in blocks
+   bool anyFeedback = false;
    for (int i = 0; i < bufferSize; ++i)
    {
       ComputeSliders(i);
 
+      for (int t = 0; t < mNumTaps; ++t)
+      {
+         DelayTap& tap = mTaps[t];
+         tap.mSamplesAgoBuffer[i] = ofClamp(tap.mDelayMs / gInvSampleRateMs - i, 0.1f, mDelayBuffer.Size() - 2);
+         tap.mGainBuffer[i] = tap.mGain;
+         tap.mFeedbackBuffer[i] = tap.mFeedback;
+         tap.mPanBuffer[i] = tap.mPan;
+         if (tap.mGain > 0 && tap.mFeedback > 0)
+            anyFeedback = true;
+      }
+   }
+
+   int chunkStart = 0;
+   while (chunkStart < bufferSize)
+   {
+      int chunkSize = bufferSize - chunkStart;
+      if (anyFeedback)
+      {
+         //taps feed back into this buffer, so stop the chunk when a read would land on a sample that an earlier part of this chunk feeds into
+         int minSafeSamplesAgo = bufferSize - chunkStart + 1;
+         for (chunkSize = 1; chunkStart + chunkSize < bufferSize; ++chunkSize)
+         {
+            bool safe = true;
+            for (int t = 0; t < mNumTaps; ++t)
+            {
+               if (int(mTaps[t].mSamplesAgoBuffer[chunkStart + chunkSize]) < minSafeSamplesAgo)
+                  safe = false;
+            }
+            if (!safe)
+               break;
+         }
+      }
+
       for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
       {
          for (int t = 0; t < mNumTaps; ++t)
-            mTaps[t].Process(&mWriteBuffer.GetChannel(ch)[i], i, ch);
-         for (int t = 0; t < kNumMPETaps; ++t)
-            mMPETaps[t].Process(&mWriteBuffer.GetChannel(ch)[i], i, ch);
+            mTaps[t].Process(mWriteBuffer.GetChannel(ch), chunkStart, chunkSize, ch);
       }
+
+      chunkStart += chunkSize;
    }
 
    for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
@@ -242,45 +277,6 @@ void MultitapDelay::LoadState(FileStreamIn& in, int rev)
    mDelayBuffer.LoadState(in);
 }
 
-
-void MultitapDelay::DelayMPETap::Process(float* sampleOut, int offset, int ch)
-{
-   /*if (!mADSR.IsDone(gTime) && sampleLength > 0)
-   {
-      double time = gTime;
-      for (int i=0; i<outLength; ++i)
-      {
-         float pitchBend = mPitchBend ? mPitchBend->GetValue(i) : 0;
-         float pressure = mPressure ? mPressure->GetValue(i) : 0;
-         float modwheel = mModWheel ? mModWheel->GetValue(i) : 0;
-         if (pressure > 0)
-         {
-            mGranulator.mGrainOverlap = ofMap(pressure * pressure, 0, 1, 3, MAX_GRAINS);
-            mGranulator.mPosRandomizeMs = ofMap(pressure * pressure, 0, 1, 100, .03f);
-         }
-         mGranulator.mGrainLengthMs = ofMap(modwheel, -1, 1, 150-140, 150+140);
-         
-         float blend = .0005f;
-         mGain = mGain * (1-blend) + pressure * blend;
-         
-         ChannelBuffer temp(sample, sampleLength);
-         float outSample[1];
-         outSample[0] = 0;
-         float pos = (mPitch + pitchBend + MIN(.125f, mPlay) - mOwner->mKeyboardBasePitch) / mOwner->mKeyboardNumPitches;
-         mGranulator.Process(time, &temp, sampleLength, ofLerp(mOwner->mDisplayStartSamples, mOwner->mDisplayEndSamples, pos), outSample);
-         outSample[0] *= sqrtf(mGain);
-         outSample[0] *= mADSR.Value(time);
-         out[i] += outSample[0];
-         time += gInvSampleRateMs;
-         mPlay += .001f;
-      }
-   }
-   else
-   {
-      mGranulator.ClearGrains();
-   }*/
-}
-
 void MultitapDelay::DelayMPETap::Draw(float w, float h)
 {
    /*if (!mADSR.IsDone(gTime))
@@ -311,30 +307,47 @@ void MultitapDelay::DelayMPETap::Draw(float w, float h)
 MultitapDelay::DelayTap::DelayTap()
 : mTapBuffer(gBufferSize)
 {
+   mSamplesAgoBuffer.resize(gBufferSize);
+   mGainBuffer.resize(gBufferSize);
+   mFeedbackBuffer.resize(gBufferSize);
+   mPanBuffer.resize(gBufferSize);
 }
 
-void MultitapDelay::DelayTap::Process(float* sampleOut, int offset, int ch)
+void MultitapDelay::DelayTap::Process(float* out, int start, int length, int ch)
 {
-   if (mGain > 0)
+   bool active = false;
+   for (int i = start; i < start + length; ++i)
    {
-      float delaySamps = mDelayMs / gInvSampleRateMs;
-      delaySamps = ofClamp(delaySamps - offset, 0.1f, mOwner->mDelayBuffer.Size() - 2);
-
-      int sampsAgoA = int(delaySamps);
-      int sampsAgoB = sampsAgoA + 1;
-
-      float sample = mOwner->mDelayBuffer.GetSample(sampsAgoA, ch);
-      float nextSample = mOwner->mDelayBuffer.GetSample(sampsAgoB, ch);
-      float a = delaySamps - sampsAgoA;
-      float delayedSample = (1 - a) * sample + a * nextSample; //interpolate
+      if (mGainBuffer[i] > 0)
+         active = true;
+   }
+   if (!active)
+      return;
 
-      float outputSample = delayedSample * mGain;
-      mTapBuffer.GetChannel(ch)[offset] = outputSample;
+   float* tapOut = mTapBuffer.GetChannel(ch) + start;
+   mOwner->mDelayBuffer.ReadInterpolated(tapOut, length, mSamplesAgoBuffer.data() + start, ch);
+   Mult(tapOut, mGainBuffer.data() + start, length);
+   Add(out + start, tapOut, length);
 
-      *sampleOut += outputSample;
-      float panGain = ch == 0 ? GetLeftPanGain(mPan) : GetRightPanGain(mPan);
-      mOwner->mDelayBuffer.Accum(gBufferSize - offset, outputSample * mFeedback * panGain, ch);
+   //scale the tap down to its feedback in place (it's already been mixed into the output), then add it back into the history it came from
+   for (int i = 0; i < length; ++i)
+   {
+      float feedback = mFeedbackBuffer[start + i];
+      if (feedback > 0)
+      {
+         float pan = mPanBuffer[start + i];
+         float panGain = ch == 0 ? GetLeftPanGain(pan) : GetRightPanGain(pan);
+         tapOut[i] *= feedback * panGain;
+      }
+      else
+      {
+         tapOut[i] = 0;
+      }
    }
+
+   WrappedSpan history = mOwner->mDelayBuffer.GetSpan(length, gBufferSize - (start + length), ch);
+   Add(history.mFirst, tapOut, history.mFirstSize);
+   Add(history.mSecond, tapOut + history.mFirstSize, history.mSecondSize);
 }
 
 void MultitapDelay::DelayTap::Draw(float w, float h)
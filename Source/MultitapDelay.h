@@ -37,6 +37,7 @@
 #include "INoteReceiver.h"
 #include "Granulator.h"
 #include "ADSR.h"
+#include "DelayLine.h"
 
 class Sample;
 
@@ -93,7 +94,7 @@ private:
    struct DelayTap
    {
       DelayTap();
-      void Process(float* sampleOut, int offset, int ch);
+      void Process(float* out, int start, int length, int ch);
       void Draw(float w, float h);
 
       float mDelayMs{ 100 };
@@ -109,11 +110,14 @@ private:
       FloatSlider* mPanSlider{ nullptr };
 
       ChannelBuffer mTapBuffer;
+      std::vector<float> mSamplesAgoBuffer;
+      std::vector<float> mGainBuffer;
+      std::vector<float> mFeedbackBuffer;
+      std::vector<float> mPanBuffer;
    };
 
    struct DelayMPETap
    {
-      void Process(float* sampleOut, int offset, int ch);
       void Draw(float w, float h);
 
       float mPitch{ 0 };
@@ -136,5 +140,5 @@ private:
    float mDryAmount{ 1 };
    FloatSlider* mDisplayLengthSlider{ nullptr };
    float mDisplayLength{ 10 };
-   RollingBuffer mDelayBuffer;
+   DelayLine mDelayBuffer;
 };
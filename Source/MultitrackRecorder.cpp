@@ -28,7 +28,6 @@
 #include "Profiler.h"
 #include "SynthGlobals.h"
 #include "Transport.h"
-#include "Sample.h"
 #include "UIControlMacros.h"
 #include "PatchCableSource.h"
 #include "UserPrefs.h"
@@ -147,14 +146,9 @@ void MultitrackRecorder::ButtonClicked(ClickButton* button, double time)
       int numFiles = 0;
       for (int i = 0; i < (int)mTracks.size(); ++i)
       {
-         Sample* sample = mTracks[i]->BounceRecording();
-
-         if (sample)
-         {
-            std::string filename = filenamePrefix + ofToString(i + 1) + ".wav";
-            sample->Write(filename.c_str());
+         std::string filename = filenamePrefix + ofToString(i + 1) + ".wav";
+         if (mTracks[i]->BounceRecording(filename))
             ++numFiles;
-         }
       }
 
       if (numFiles > 0)
@@ -267,17 +261,20 @@ void MultitrackRecorder::LoadState(FileStreamIn& in, int rev)
 
 namespace
 {
-   const int kRecordingChunkSize = 48000 * 5;
-   const int kMinRecordingChunks = 2;
+   const int kDisplayChunkSize = 48000 * 5; //the drawn timeline grows in steps of this
+   const int kSpoolRingSeconds = 5;
 };
 
 MultitrackRecorderTrack::MultitrackRecorderTrack()
 : IAudioProcessor(gBufferSize)
+, mSpooler(gSampleRate * kSpoolRingSeconds)
 {
 }
 
 MultitrackRecorderTrack::~MultitrackRecorderTrack()
 {
+   mDoRecording = false;
+   Clear();
 }
 
 void MultitrackRecorderTrack::CreateUIControls()
@@ -293,29 +290,13 @@ void MultitrackRecorderTrack::CreateUIControls()
 
 void MultitrackRecorderTrack::Process(double time)
 {
-   int numChannels = GetBuffer()->NumActiveChannels();
-   for (size_t i = 0; i < mRecordChunks.size(); ++i)
-   {
-      if (mRecordChunks[i]->NumActiveChannels() > numChannels)
-         numChannels = mRecordChunks[i]->NumActiveChannels();
-   }
-
    ComputeSliders(0);
-   SyncBuffers(numChannels);
+   SyncBuffers();
 
    if (mDoRecording)
    {
-      for (size_t i = 0; i < mRecordChunks.size(); ++i)
-         mRecordChunks[i]->SetNumActiveChannels(numChannels);
-
-      for (int i = 0; i < GetBuffer()->BufferSize(); ++i)
-      {
-         int chunkIndex = mRecordingLength / kRecordingChunkSize;
-         int chunkPos = mRecordingLength % kRecordingChunkSize;
-         for (int ch = 0; ch < numChannels; ++ch)
-            mRecordChunks[chunkIndex]->GetChannel(ch)[chunkPos] = GetBuffer()->GetChannel(MIN(ch, GetBuffer()->NumActiveChannels() - 1))[i];
-         ++mRecordingLength;
-      }
+      mSpooler.Write(GetBuffer(), GetBuffer()->BufferSize());
+      mRecordingLength += GetBuffer()->BufferSize();
    }
 
    if (GetTarget())
@@ -331,18 +312,6 @@ void MultitrackRecorderTrack::Process(double time)
    GetBuffer()->Reset();
 }
 
-void MultitrackRecorderTrack::Poll()
-{
-   IDrawableModule::Poll();
-
-   int chunkIndex = mRecordingLength / kRecordingChunkSize;
-   if (chunkIndex >= (int)mRecordChunks.size() - 1)
-   {
-      mRecordChunks.push_back(new ChannelBuffer(kRecordingChunkSize));
-      mRecordChunks[mRecordChunks.size() - 1]->GetChannel(0); //set up buffer
-   }
-}
-
 void MultitrackRecorderTrack::DrawModule()
 {
    mDeleteButton->Draw();
@@ -365,16 +334,8 @@ void MultitrackRecorderTrack::DrawModule()
       ofRect(0, 0, sampleWidth, height - 6);
    }
 
-   ofPushMatrix();
-   int numChunks = mRecordingLength / kRecordingChunkSize + 1;
-   float chunkWidth = sampleWidth / numChunks;
-   for (int i = 0; i < numChunks; ++i)
-   {
-      if (i < (int)mRecordChunks.size())
-         DrawAudioBuffer(chunkWidth, height - 6, mRecordChunks[i], 0, kRecordingChunkSize, -1);
-      ofTranslate(chunkWidth, 0);
-   }
-   ofPopMatrix();
+   int numChunks = mRecordingLength / kDisplayChunkSize + 1;
+   mSpooler.DrawOverview(sampleWidth, height - 6, (long long)numChunks * kDisplayChunkSize);
 
    ofPopMatrix();
 }
@@ -389,18 +350,13 @@ void MultitrackRecorderTrack::SetRecording(bool record)
 {
    if (record)
    {
-      if (mRecordingLength == 0)
+      if (!mSpooler.IsOpen())
       {
-         mRecordingLength = 0;
-
-         for (size_t i = mRecordChunks.size(); i < kMinRecordingChunks; ++i)
-         {
-            mRecordChunks.push_back(new ChannelBuffer(kRecordingChunkSize));
-            mRecordChunks[i]->GetChannel(0); //set up buffer
-         }
-
-         for (size_t i = 0; i < mRecordChunks.size(); ++i)
-            mRecordChunks[i]->Clear();
+         //spool to disk as we go, padded with silence to line up with the tracks that started earlier
+         juce::File spoolDir(TheSynth->GetSpoolDirectory());
+         std::string path = spoolDir.getNonexistentChildFile("multitrack_" + std::string(Name()), ".wav").getFullPathName().toStdString();
+         if (!mSpooler.Open(path, mRecordingLength))
+            return;
       }
 
       mDoRecording = true;
@@ -411,40 +367,27 @@ void MultitrackRecorderTrack::SetRecording(bool record)
    }
 }
 
-Sample* MultitrackRecorderTrack::BounceRecording()
+bool MultitrackRecorderTrack::BounceRecording(const std::string& path)
 {
-   Sample* sample = nullptr;
-   if (mRecordingLength > 0)
-   {
-      sample = new Sample();
-      sample->Create(mRecordingLength);
-      ChannelBuffer* data = sample->Data();
-      int channelCount = mRecordChunks[0]->NumActiveChannels();
-      data->SetNumActiveChannels(channelCount);
-
-      int numChunks = mRecordingLength / kRecordingChunkSize + 1;
-      for (int i = 0; i < numChunks; ++i)
-      {
-         int samplesLeftToRecord = mRecordingLength - i * kRecordingChunkSize;
-         int samplesToCopy;
-         if (samplesLeftToRecord > kRecordingChunkSize)
-            samplesToCopy = kRecordingChunkSize;
-         else
-            samplesToCopy = samplesLeftToRecord;
-         for (int ch = 0; ch < channelCount; ++ch)
-            BufferCopy(data->GetChannel(ch) + i * kRecordingChunkSize, mRecordChunks[i]->GetChannel(ch), samplesToCopy);
-      }
-   }
+   if (mRecordingLength == 0)
+      return false;
 
-   return sample;
+   return mSpooler.CopyTo(ofToDataPath(path));
 }
 
 void MultitrackRecorderTrack::Clear()
 {
-   for (auto* recordChunk : mRecordChunks)
-      delete recordChunk;
-   mRecordChunks.clear();
+   bool wasRecording = mDoRecording;
+   mDoRecording = false;
+   if (mSpooler.IsOpen())
+   {
+      mSpooler.Close();
+      juce::File(mSpooler.GetPath()).deleteFile();
+   }
    mRecordingLength = 0;
+
+   if (wasRecording)
+      SetRecording(true); //start over in a fresh file
 }
 
 void MultitrackRecorderTrack::FloatSliderUpdated(FloatSlider* slider, float oldVal, double time)
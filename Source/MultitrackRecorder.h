@@ -33,6 +33,7 @@
 #include "Checkbox.h"
 #include "IAudioProcessor.h"
 #include "ModuleContainer.h"
+#include "RecordingSpooler.h"
 
 class MultitrackRecorderTrack;
 
@@ -104,12 +105,11 @@ public:
    void CreateUIControls() override;
    bool HasTitleBar() const override { return false; }
 
-   void Poll() override;
    void Process(double time) override;
 
    void Setup(MultitrackRecorder* recorder, int minLength);
    void SetRecording(bool record);
-   Sample* BounceRecording();
+   bool BounceRecording(const std::string& path);
    void Clear();
    int GetRecordingLength() const { return mRecordingLength; }
 
@@ -127,7 +127,7 @@ private:
 
    MultitrackRecorder* mRecorder{ nullptr };
 
-   std::vector<ChannelBuffer*> mRecordChunks;
+   RecordingSpooler mSpooler;
    bool mDoRecording{ false };
    int mRecordingLength{ 0 };
    ClickButton* mDeleteButton{ nullptr };
@@ -48,7 +48,8 @@ void OSCOutput::Init()
 {
    IDrawableModule::Init();
 
-   mOscOut.connect(mOscOutAddress, mOscOutPort);
+   mOscOut.SetMaxSendRate(mMaxSendRate);
+   mOscOut.Connect(mOscOutAddress, mOscOutPort);
 }
 
 void OSCOutput::CreateUIControls()
@@ -60,6 +61,8 @@ void OSCOutput::CreateUIControls()
    UIBLOCK_SHIFTRIGHT();
    TEXTENTRY_NUM(mOscOutPortEntry, "osc out port", 6, &mOscOutPort, 0, 99999);
    UIBLOCK_NEWLINE();
+   TEXTENTRY_NUM(mMaxSendRateEntry, "max sends per second", 4, &mMaxSendRate, 1, 1000);
+   UIBLOCK_NEWLINE();
    UIBLOCK_SHIFTY(5);
    for (int i = 0; i < 8; ++i)
    {
@@ -83,6 +86,7 @@ void OSCOutput::CreateUIControls()
 void OSCOutput::Poll()
 {
    ComputeSliders(0);
+   mOscOut.LogRejectedMessages();
 }
 
 void OSCOutput::DrawModule()
@@ -92,6 +96,7 @@ void OSCOutput::DrawModule()
 
    mOscOutAddressEntry->Draw();
    mOscOutPortEntry->Draw();
+   mMaxSendRateEntry->Draw();
 
    for (auto* entry : mLabelEntry)
       entry->Draw();
@@ -105,35 +110,28 @@ void OSCOutput::PlayNote(double time, int pitch, int velocity, int voiceIdx, Mod
 {
    if (mNoteOutLabel.size() > 0)
    {
-      juce::OSCMessage msg(("/bespoke/" + mNoteOutLabel).c_str());
+      std::string address = "/bespoke/" + mNoteOutLabel;
       float pitchOut = pitch;
       if (modulation.pitchBend != nullptr)
          pitchOut += modulation.pitchBend->GetValue(0);
-      msg.addFloat32(pitchOut);
-      msg.addFloat32(velocity);
-      mOscOut.send(msg);
+      float args[] = { pitchOut, (float)velocity };
+      mOscOut.SendEvent(address.c_str(), args, 2);
    }
 }
 
 void OSCOutput::SendFloat(std::string address, float val)
 {
-   juce::OSCMessage msg(address.c_str());
-   msg.addFloat32(val);
-   mOscOut.send(msg);
+   mOscOut.SendFloat(address.c_str(), val);
 }
 
 void OSCOutput::SendInt(std::string address, int val)
 {
-   juce::OSCMessage msg(address.c_str());
-   msg.addInt32(val);
-   mOscOut.send(msg);
+   mOscOut.SendInt(address.c_str(), val);
 }
 
 void OSCOutput::SendString(std::string address, std::string val)
 {
-   juce::OSCMessage msg(address.c_str());
-   msg.addString(val);
-   mOscOut.send(msg);
+   mOscOut.SendString(address.c_str(), val.c_str());
 }
 
 void OSCOutput::GetModuleDimensions(float& w, float& h)
@@ -148,9 +146,7 @@ void OSCOutput::FloatSliderUpdated(FloatSlider* slider, float oldVal, double tim
    address[0] = 0;
    strcat(address, "/bespoke/");
    strcat(address, slider->Name());
-   juce::OSCMessage msg(address);
-   msg.addFloat32(slider->GetValue());
-   mOscOut.send(msg);
+   mOscOut.SendFloat(address, slider->GetValue());
 }
 
 void OSCOutput::TextEntryComplete(TextEntry* entry)
@@ -168,10 +164,10 @@ void OSCOutput::TextEntryComplete(TextEntry* entry)
    }
 
    if (entry == mOscOutAddressEntry || entry == mOscOutPortEntry)
-   {
-      mOscOut.disconnect();
-      mOscOut.connect(mOscOutAddress, mOscOutPort);
-   }
+      mOscOut.Connect(mOscOutAddress, mOscOutPort);
+
+   if (entry == mMaxSendRateEntry)
+      mOscOut.SetMaxSendRate(mMaxSendRate);
 }
 
 void OSCOutput::LoadLayout(const ofxJSONElement& moduleInfo)
@@ -181,6 +177,7 @@ void OSCOutput::LoadLayout(const ofxJSONElement& moduleInfo)
 
 void OSCOutput::SetUpFromSaveData()
 {
+   mOscOut.SetMaxSendRate(mMaxSendRate);
 }
 
 void OSCOutput::SaveLayout(ofxJSONElement& moduleInfo)
@@ -33,8 +33,7 @@
 #include "TextEntry.h"
 #include "Slider.h"
 #include "INoteReceiver.h"
-
-#include "juce_osc/juce_osc.h"
+#include "OscSendQueue.h"
 
 #define OSC_OUTPUT_MAX_PARAMS 50
 
@@ -84,11 +83,13 @@ private:
    TextEntry* mOscOutAddressEntry{ nullptr };
    int mOscOutPort{ 7000 };
    TextEntry* mOscOutPortEntry{ nullptr };
+   int mMaxSendRate{ 100 };
+   TextEntry* mMaxSendRateEntry{ nullptr };
 
    std::string mNoteOutLabel{ "note" };
    TextEntry* mNoteOutLabelEntry{ nullptr };
 
-   juce::OSCSender mOscOut;
+   OscSendQueue mOscOut;
 
    float mWidth{ 200 };
    float mHeight{ 20 };
@@ -42,6 +42,11 @@ OscController::~OscController()
    OSCReceiver::disconnect();
 }
 
+void OscController::Poll()
+{
+   mOscOut.LogRejectedMessages();
+}
+
 void OscController::Connect()
 {
    try
@@ -64,7 +69,7 @@ void OscController::ConnectOutput()
 {
    if (mOutAddress != "" && mOutPort > 0)
    {
-      mOutputConnected = mOscOut.connect(mOutAddress, mOutPort);
+      mOutputConnected = mOscOut.Connect(mOutAddress, mOutPort);
    }
 }
 
@@ -96,21 +101,20 @@ void OscController::SendValue(int page, int control, float value, bool forceNote
    {
       if (control == mOscMap[i].mControl) // && mOscMap[i].mLastChangedTime + 50 < gTime)
       {
-         juce::OSCMessage msg(juce::URL::addEscapeChars(mOscMap[i].mAddress.c_str(), true, true));
+         juce::String address = juce::URL::addEscapeChars(mOscMap[i].mAddress.c_str(), true, true);
 
          if (mOscMap[i].mIsFloat)
          {
             mOscMap[i].mFloatValue = value;
-            msg.addFloat32(mOscMap[i].mFloatValue);
+            if (mOutputConnected)
+               mOscOut.SendFloat(address.toRawUTF8(), mOscMap[i].mFloatValue);
          }
          else
          {
             mOscMap[i].mIntValue = value * 127;
-            msg.addInt32(mOscMap[i].mIntValue);
+            if (mOutputConnected)
+               mOscOut.SendInt(address.toRawUTF8(), mOscMap[i].mIntValue);
          }
-
-         if (mOutputConnected)
-            mOscOut.send(msg);
       }
    }
 }
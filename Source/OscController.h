@@ -30,6 +30,7 @@
 #include "MidiDevice.h"
 #include "INonstandardController.h"
 #include "ofxJSONElement.h"
+#include "OscSendQueue.h"
 
 #include "juce_osc/juce_osc.h"
 
@@ -63,6 +64,7 @@ public:
       return mConnected;
    }
    bool SetInPort(int port);
+   void Poll() override;
    std::string GetControlTooltip(MidiMessageType type, int control) override;
 
    void SaveState(FileStreamOut& out) override;
@@ -77,7 +79,7 @@ private:
    std::string mOutAddress;
    int mOutPort{ 0 };
    int mInPort{ 0 };
-   juce::OSCSender mOscOut;
+   OscSendQueue mOscOut;
    bool mConnected{ false };
    bool mOutputConnected{ false };
 
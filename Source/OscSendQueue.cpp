@@ -0,0 +1,225 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    OscSendQueue.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "OscSendQueue.h"
+#include "ModularSynth.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace
+{
+   const int kPollIntervalMs = 1;
+   const int kMaxMessagesPerBundle = 32; //keeps each bundle comfortably inside one udp datagram
+}
+
+OscSendQueue::OscSendQueue()
+: juce::Thread("OscSendQueue")
+, mQueue(kQueueSize)
+{
+   mPendingEvents.reserve(kQueueSize);
+   mPendingValues.reserve(kQueueSize);
+}
+
+OscSendQueue::~OscSendQueue()
+{
+   Disconnect();
+}
+
+bool OscSendQueue::Connect(const std::string& address, int port)
+{
+   Disconnect();
+
+   if (!mSender.connect(address, port))
+      return false;
+
+   {
+      const juce::SpinLock::ScopedLockType lock(mWriteLock);
+      mFifo.reset();
+   }
+   mPendingEvents.clear();
+   mPendingValues.clear();
+   mPendingValueIndex.clear();
+   mDroppedMessages = 0;
+   mConnected = true;
+   startThread();
+   return true;
+}
+
+void OscSendQueue::Disconnect()
+{
+   mConnected = false;
+   stopThread(1000);
+   mSender.disconnect();
+}
+
+void OscSendQueue::Send(const char* address, const float* floats, const int* ints, int numArgs, const char* string, bool coalesce)
+{
+   if (!mConnected)
+      return;
+
+   if (numArgs > kMaxArgs || strlen(address) >= kMaxAddressLength || (string != nullptr && strlen(string) >= kMaxStringLength))
+   {
+      ++mRejectedMessages;
+      return;
+   }
+
+   const juce::SpinLock::ScopedLockType lock(mWriteLock);
+
+   int start1, size1, start2, size2;
+   mFifo.prepareToWrite(1, start1, size1, start2, size2);
+   if (size1 + size2 == 0) //the sending thread has fallen behind, drop rather than wait for it
+   {
+      ++mDroppedMessages;
+      return;
+   }
+
+   QueuedMessage& queued = mQueue[size1 > 0 ? start1 : start2];
+   queued.mTimeMs = (double)juce::Time::currentTimeMillis();
+   queued.mCoalesce = coalesce;
+   strcpy(queued.mAddress, address);
+   queued.mNumArgs = numArgs;
+   queued.mIsInt = ints != nullptr;
+   for (int i = 0; i < queued.mNumArgs; ++i)
+   {
+      if (ints != nullptr)
+         queued.mInts[i] = ints[i];
+      else
+         queued.mFloats[i] = floats[i];
+   }
+   queued.mHasString = string != nullptr;
+   if (string != nullptr)
+      strcpy(queued.mString, string);
+   mFifo.finishedWrite(1);
+}
+
+void OscSendQueue::LogRejectedMessages()
+{
+   int rejected = mRejectedMessages.exchange(0);
+   if (rejected > 0)
+      TheSynth->LogEvent("osc: dropped " + ofToString(rejected) + " message(s) with more than " + ofToString(kMaxArgs) + " values, or an address or string over " + ofToString(kMaxAddressLength - 1) + " characters", kLogEventType_Warning);
+}
+
+void OscSendQueue::run()
+{
+   while (!threadShouldExit())
+   {
+      Drain();
+
+      double now = juce::Time::getMillisecondCounterHiRes();
+      bool valuesDue = !mPendingValues.empty() && now - mLastValueFlushMs >= 1000 / std::max(mMaxSendRate.load(), .1f);
+      if (valuesDue)
+         mLastValueFlushMs = now;
+      if (valuesDue || !mPendingEvents.empty())
+         Flush(valuesDue);
+
+      wait(kPollIntervalMs);
+   }
+}
+
+void OscSendQueue::Drain()
+{
+   int start1, size1, start2, size2;
+   mFifo.prepareToRead(mFifo.getNumReady(), start1, size1, start2, size2);
+   for (int i = 0; i < size1 + size2; ++i)
+   {
+      const QueuedMessage& queued = mQueue[i < size1 ? start1 + i : start2 + i - size1];
+      if (!queued.mCoalesce)
+      {
+         mPendingEvents.push_back(queued);
+         continue;
+      }
+
+      auto existing = mPendingValueIndex.find(queued.mAddress);
+      if (existing != mPendingValueIndex.end())
+      {
+         mPendingValues[existing->second] = queued;
+      }
+      else
+      {
+         mPendingValueIndex[queued.mAddress] = (int)mPendingValues.size();
+         mPendingValues.push_back(queued);
+      }
+   }
+   mFifo.finishedRead(size1 + size2);
+}
+
+void OscSendQueue::Flush(bool includeValues)
+{
+   std::vector<const QueuedMessage*> toSend;
+   toSend.reserve(mPendingEvents.size() + mPendingValues.size());
+   for (const auto& queued : mPendingEvents)
+      toSend.push_back(&queued);
+   if (includeValues)
+   {
+      for (const auto& queued : mPendingValues)
+         toSend.push_back(&queued);
+   }
+
+   for (size_t start = 0; start < toSend.size(); start += kMaxMessagesPerBundle)
+   {
+      size_t end = std::min(start + kMaxMessagesPerBundle, toSend.size());
+      double newestMs = 0;
+      for (size_t i = start; i < end; ++i)
+         newestMs = std::max(newestMs, toSend[i]->mTimeMs);
+
+      juce::OSCBundle bundle(juce::OSCTimeTag(juce::Time((juce::int64)newestMs)));
+      for (size_t i = start; i < end; ++i)
+      {
+         try
+         {
+            bundle.addElement(MakeMessage(*toSend[i]));
+         }
+         catch (juce::OSCFormatError&) //invalid address, skip it like a failed send
+         {
+         }
+      }
+      if (!bundle.isEmpty())
+         mSender.send(bundle);
+   }
+
+   mPendingEvents.clear();
+   if (includeValues)
+   {
+      mPendingValues.clear();
+      mPendingValueIndex.clear();
+   }
+}
+
+juce::OSCMessage OscSendQueue::MakeMessage(const QueuedMessage& queued) const
+{
+   juce::OSCMessage msg{ juce::OSCAddressPattern(juce::String(queued.mAddress)) };
+   for (int i = 0; i < queued.mNumArgs; ++i)
+   {
+      if (queued.mIsInt)
+         msg.addInt32(queued.mInts[i]);
+      else
+         msg.addFloat32(queued.mFloats[i]);
+   }
+   if (queued.mHasString)
+      msg.addString(juce::String(queued.mString));
+   return msg;
+}
@@ -0,0 +1,103 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    OscSendQueue.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "juce_osc/juce_osc.h"
+
+//sends osc from a background thread, packed into timestamped bundles instead of a udp packet per value
+//senders (often the audio thread) only copy into a preallocated ring. values sent to the same address are
+//coalesced to the latest one and flushed at most mMaxSendRate times a second, events (like notes) are never coalesced
+//events go out on the next flush but values wait for the rate limit, so a value sent before an event can arrive after it,
+//only events are guaranteed to arrive in the order they were sent
+class OscSendQueue : public juce::Thread
+{
+public:
+   OscSendQueue();
+   ~OscSendQueue();
+
+   bool Connect(const std::string& address, int port);
+   void Disconnect();
+   bool IsConnected() const { return mConnected; }
+   void SetMaxSendRate(float sendsPerSecond) { mMaxSendRate = sendsPerSecond; }
+
+   //the latest value for an address wins
+   void SendFloat(const char* address, float value) { Send(address, &value, nullptr, 1, nullptr, true); }
+   void SendInt(const char* address, int value) { Send(address, nullptr, &value, 1, nullptr, true); }
+   void SendString(const char* address, const char* value) { Send(address, nullptr, nullptr, 0, value, true); }
+   //sent in order, every time
+   void SendEvent(const char* address, const float* values, int numValues) { Send(address, values, nullptr, numValues, nullptr, false); }
+
+   int GetDroppedMessages() const { return mDroppedMessages; }
+   void LogRejectedMessages(); //call from the main thread
+
+   //messages that don't fit are rejected rather than truncated, a truncated address would go somewhere else
+   static const int kMaxAddressLength = 128;
+   static const int kMaxStringLength = 128;
+   static const int kMaxArgs = 4;
+
+private:
+   struct QueuedMessage
+   {
+      double mTimeMs{ 0 };
+      bool mCoalesce{ false };
+      char mAddress[kMaxAddressLength]{};
+      int mNumArgs{ 0 };
+      bool mIsInt{ false };
+      float mFloats[kMaxArgs]{};
+      int mInts[kMaxArgs]{};
+      bool mHasString{ false };
+      char mString[kMaxStringLength]{};
+   };
+
+   void Send(const char* address, const float* floats, const int* ints, int numArgs, const char* string, bool coalesce);
+   void run() override;
+   void Drain();
+   void Flush(bool includeValues);
+   juce::OSCMessage MakeMessage(const QueuedMessage& queued) const;
+
+   static const int kQueueSize = 2048;
+
+   std::vector<QueuedMessage> mQueue;
+   juce::AbstractFifo mFifo{ kQueueSize };
+   juce::SpinLock mWriteLock; //only serializes senders, held just long enough to copy one message
+   std::atomic<int> mDroppedMessages{ 0 };
+   std::atomic<int> mRejectedMessages{ 0 };
+   std::atomic<float> mMaxSendRate{ 100 };
+   std::atomic<bool> mConnected{ false };
+
+   //only touched by the sending thread, or while it's stopped
+   juce::OSCSender mSender;
+   std::vector<QueuedMessage> mPendingEvents;
+   std::vector<QueuedMessage> mPendingValues;
+   std::unordered_map<std::string, int> mPendingValueIndex; //address -> index in mPendingValues
+   double mLastValueFlushMs{ 0 };
+};
@@ -54,6 +54,9 @@ public:
    void Process(double time) override;
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
 
+   //IAudioProcessor
+   float GetSilenceTailMs() override { return mWidenerBuffer.Size() * gInvSampleRateMs; }
+
    void FloatSliderUpdated(FloatSlider* slider, float oldVal, double time) override;
    void IntSliderUpdated(IntSlider* slider, int oldVal, double time) override;
    void ButtonClicked(ClickButton* button, double time) override;
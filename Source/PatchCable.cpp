@@ -62,11 +62,28 @@ void PatchCable::SetCableTarget(IClickable* target)
    mAudioReceiverTarget = dynamic_cast<IAudioReceiver*>(target);
 }
 
+bool PatchCable::IsOnScreen(const PatchCablePos& cable) const
+{
+   //the bezier stays inside the hull of its control points, which sit at most .15 * wireLength out from the ends
+   float wireLength = sqrtf((cable.plug - cable.start).lengthSquared());
+   float minX = std::min({ cable.start.x, cable.plug.x, cable.end.x });
+   float minY = std::min({ cable.start.y, cable.plug.y, cable.end.y });
+   float maxX = std::max({ cable.start.x, cable.plug.x, cable.end.x });
+   float maxY = std::max({ cable.start.y, cable.plug.y, cable.end.y });
+   ofRectangle bounds(minX, minY, maxX - minX, maxY - minY);
+   bounds.grow(wireLength * .15f + 20); //plus room for note pulses and the audio waveform
+   return bounds.intersects(TheSynth->GetDrawRect());
+}
+
 void PatchCable::Render()
 {
    PatchCablePos cable = GetPatchCablePos();
    mX = cable.start.x;
    mY = cable.start.y;
+
+   if (GetOwningModule()->GetOwningContainer() == TheSynth->GetRootContainer() && !IsOnScreen(cable))
+      return;
+
    ofVec2f cableFadeOut = cable.start * .47 + cable.end * .53f;
    ofVec2f cableFadeIn = cable.start * .53f + cable.end * .47f;
    float cableQuality = gDrawScale * UserPrefs.cable_quality.Get();
@@ -108,15 +125,14 @@ void PatchCable::Render()
             if (vizBuff == nullptr)
                vizBuff = audioSource->GetVizBuffer();
             assert(vizBuff);
-            int numSamples = vizBuff->Size();
             bool allZero = true;
-            for (int ch = 0; ch < vizBuff->NumChannels(); ++ch)
+            for (int ch = 0; ch < vizBuff->NumChannels() && allZero; ++ch)
             {
-               for (int i = 0; i < numSamples && allZero; ++i)
-               {
-                  if (vizBuff->GetSample(i, ch) != 0)
-                     allZero = false;
-               }
+               WrappedSpan span = vizBuff->GetSpan(vizBuff->Size(), 0, ch);
+               for (int i = 0; i < span.mFirstSize && allZero; ++i)
+                  allZero = span.mFirst[i] == 0;
+               for (int i = 0; i < span.mSecondSize && allZero; ++i)
+                  allZero = span.mSecond[i] == 0;
             }
 
             if (allZero)
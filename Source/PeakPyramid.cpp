@@ -0,0 +1,142 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    PeakPyramid.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PeakPyramid.h"
+
+#include <algorithm>
+#include <math.h>
+
+namespace
+{
+   float RawPeak(const float* data, int start, int end)
+   {
+      float peak = 0;
+      for (int i = start; i < end; ++i)
+         peak = std::max(peak, fabsf(data[i]));
+      return peak;
+   }
+}
+
+void PeakPyramid::Build(const float* data, int length)
+{
+   mLength = length;
+   mRefreshPos = 0;
+   mLevels.clear();
+
+   int numBlocks = (length + kBlockSize - 1) / kBlockSize;
+   while (true)
+   {
+      mLevels.emplace_back(numBlocks, 0.0f);
+      if (numBlocks <= 1)
+         break;
+      numBlocks = (numBlocks + kLevelFactor - 1) / kLevelFactor;
+   }
+
+   Update(data, 0, length);
+}
+
+void PeakPyramid::Update(const float* data, int start, int end)
+{
+   start = std::max(start, 0);
+   end = std::min(end, mLength);
+   if (start >= end || mLevels.empty())
+      return;
+
+   int first = start / kBlockSize;
+   int last = (end - 1) / kBlockSize;
+   std::vector<float>& blocks = mLevels[0];
+   for (int block = first; block <= last; ++block)
+   {
+      int blockStart = block * kBlockSize;
+      blocks[block] = RawPeak(data, blockStart, std::min(blockStart + kBlockSize, mLength));
+   }
+
+   for (size_t level = 1; level < mLevels.size(); ++level)
+   {
+      const std::vector<float>& below = mLevels[level - 1];
+      std::vector<float>& cur = mLevels[level];
+      first /= kLevelFactor;
+      last /= kLevelFactor;
+      for (int block = first; block <= last; ++block)
+      {
+         int childStart = block * kLevelFactor;
+         int childEnd = std::min(childStart + kLevelFactor, (int)below.size());
+         float peak = 0;
+         for (int child = childStart; child < childEnd; ++child)
+            peak = std::max(peak, below[child]);
+         cur[block] = peak;
+      }
+   }
+}
+
+void PeakPyramid::Refresh(const float* data, int numSamples)
+{
+   if (mLength == 0)
+      return;
+
+   numSamples = std::min(numSamples, mLength);
+   int end = mRefreshPos + numSamples;
+   Update(data, mRefreshPos, end);
+   if (end > mLength)
+      Update(data, 0, end - mLength);
+   mRefreshPos = end % mLength;
+}
+
+float PeakPyramid::GetPeak(const float* data, int start, int end) const
+{
+   start = std::max(start, 0);
+   end = std::min(end, mLength);
+   if (start >= end)
+      return 0;
+
+   int lo = (start + kBlockSize - 1) / kBlockSize; //first whole block
+   int hi = end / kBlockSize; //one past the last whole block
+   if (lo >= hi)
+      return RawPeak(data, start, end);
+
+   float peak = std::max(RawPeak(data, start, lo * kBlockSize), RawPeak(data, hi * kBlockSize, end));
+
+   //take the unaligned blocks at each edge from this level, then step up to the coarser level for the aligned middle
+   for (size_t level = 0; level < mLevels.size() && lo < hi; ++level)
+   {
+      const std::vector<float>& blocks = mLevels[level];
+      if (level + 1 == mLevels.size())
+      {
+         for (int block = lo; block < hi; ++block)
+            peak = std::max(peak, blocks[block]);
+         break;
+      }
+
+      while (lo < hi && lo % kLevelFactor != 0)
+         peak = std::max(peak, blocks[lo++]);
+      while (lo < hi && hi % kLevelFactor != 0)
+         peak = std::max(peak, blocks[--hi]);
+      lo /= kLevelFactor;
+      hi /= kLevelFactor;
+   }
+
+   return peak;
+}
@@ -0,0 +1,49 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    PeakPyramid.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <vector>
+
+//multi-resolution summary of a buffer's peak magnitudes, so the peak of any range can be found in roughly log(length) steps
+//level 0 holds the peak of each kBlockSize samples, and each level above holds the peak of kLevelFactor blocks of the one below
+class PeakPyramid
+{
+public:
+   void Build(const float* data, int length);
+   void Update(const float* data, int start, int end); //recompute the blocks covering [start, end)
+   void Refresh(const float* data, int numSamples); //recompute the next numSamples worth of blocks, wrapping around, to catch changes nobody told us about
+   float GetPeak(const float* data, int start, int end) const; //peak magnitude of [start, end). data is only read for the partial blocks at the edges
+   int Length() const { return mLength; }
+
+   static const int kBlockSize = 64;
+   static const int kLevelFactor = 4;
+
+private:
+   std::vector<std::vector<float>> mLevels;
+   int mLength{ 0 };
+   int mRefreshPos{ 0 };
+};
@@ -31,27 +31,7 @@ void PeakTracker::Process(float* buffer, int bufferSize)
 {
    PROFILER(PeakTracker);
 
+   float scalar = GetDecayScalar();
    for (int j = 0; j < bufferSize; ++j)
-   {
-      float scalar = powf(0.5f, 1.0f / (mDecayTime * gSampleRate));
-      float input = fabsf(buffer[j]);
-
-      if (input >= mPeak)
-      {
-         /* When we hit a peak, ride the peak to the top. */
-         mPeak = input;
-         if (mLimit != -1 && mPeak >= mLimit)
-         {
-            mPeak = mLimit;
-            mHitLimitTime = gTime;
-         }
-      }
-      else
-      {
-         /* Exponential decay of output when signal is low. */
-         mPeak = mPeak * scalar;
-         if (mPeak < FLT_EPSILON)
-            mPeak = 0.0;
-      }
-   }
+      ProcessSample(buffer[j], scalar);
 }
@@ -27,11 +27,16 @@
 #define __modularSynth__PeakTracker__
 
 #include <iostream>
+#include <cfloat>
+#include "SynthGlobals.h"
 
 class PeakTracker
 {
 public:
    void Process(float* buffer, int bufferSize);
+   //for callers that need the level at every sample, get decayScalar once per block with GetDecayScalar()
+   float ProcessSample(float sample, float decayScalar);
+   float GetDecayScalar() const { return powf(0.5f, 1.0f / (mDecayTime * gSampleRate)); }
    float GetPeak() const { return mPeak; }
    void SetDecayTime(float time) { mDecayTime = time; }
    void SetLimit(float limit) { mLimit = limit; }
@@ -45,4 +50,29 @@ private:
    double mHitLimitTime{ -9999 };
 };
 
+inline float PeakTracker::ProcessSample(float sample, float decayScalar)
+{
+   float input = fabsf(sample);
+
+   if (input >= mPeak)
+   {
+      /* When we hit a peak, ride the peak to the top. */
+      mPeak = input;
+      if (mLimit != -1 && mPeak >= mLimit)
+      {
+         mPeak = mLimit;
+         mHitLimitTime = gTime;
+      }
+   }
+   else
+   {
+      /* Exponential decay of output when signal is low. */
+      mPeak = mPeak * decayScalar;
+      if (mPeak < FLT_EPSILON)
+         mPeak = 0.0;
+   }
+
+   return mPeak;
+}
+
 #endif /* defined(__modularSynth__PeakTracker__) */
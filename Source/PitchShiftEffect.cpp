@@ -30,14 +30,10 @@
 
 PitchShiftEffect::PitchShiftEffect()
 {
-   for (int i = 0; i < ChannelBuffer::kMaxNumChannels; ++i)
-      mPitchShifter[i] = new PitchShifter(1024);
 }
 
 PitchShiftEffect::~PitchShiftEffect()
 {
-   for (int i = 0; i < ChannelBuffer::kMaxNumChannels; ++i)
-      delete mPitchShifter[i];
 }
 
 void PitchShiftEffect::CreateUIControls()
@@ -50,6 +46,11 @@ void PitchShiftEffect::CreateUIControls()
    mRatioSelector->AddLabel("1", 10);
    mRatioSelector->AddLabel("1.5", 15);
    mRatioSelector->AddLabel("2", 20);
+
+   mQualitySelector = new DropdownList(this, "quality", 5, 38, (int*)(&mQuality));
+   mQualitySelector->AddLabel("low", (int)PitchShifter::Quality::kLow);
+   mQualitySelector->AddLabel("medium", (int)PitchShifter::Quality::kMedium);
+   mQualitySelector->AddLabel("high", (int)PitchShifter::Quality::kHigh);
 }
 
 void PitchShiftEffect::ProcessAudio(double time, ChannelBuffer* buffer)
@@ -63,11 +64,12 @@ void PitchShiftEffect::ProcessAudio(double time, ChannelBuffer* buffer)
 
    ComputeSliders(0);
 
-   for (int ch = 0; ch < buffer->NumActiveChannels(); ++ch)
-   {
-      mPitchShifter[ch]->SetRatio(mRatio);
-      mPitchShifter[ch]->Process(buffer->GetChannel(ch), bufferSize);
-   }
+   mPitchShifter.SetRatio(mRatio);
+   mPitchShifter.SetQuality(mQuality);
+   if (buffer->NumActiveChannels() > 1)
+      mPitchShifter.Process(buffer->GetChannel(0), buffer->GetChannel(1), bufferSize);
+   else
+      mPitchShifter.Process(buffer->GetChannel(0), bufferSize);
 }
 
 void PitchShiftEffect::DrawModule()
@@ -77,6 +79,7 @@ void PitchShiftEffect::DrawModule()
 
    mRatioSlider->Draw();
    mRatioSelector->Draw();
+   mQualitySelector->Draw();
 }
 
 void PitchShiftEffect::GetModuleDimensions(float& width, float& height)
@@ -84,7 +87,7 @@ void PitchShiftEffect::GetModuleDimensions(float& width, float& height)
    if (mEnabled)
    {
       width = 105;
-      height = 39;
+      height = 57;
    }
    else
    {
@@ -115,3 +118,7 @@ void PitchShiftEffect::RadioButtonUpdated(RadioButton* radio, int oldVal, double
    if (radio == mRatioSelector)
       mRatio = mRatioSelection / 10.0f;
 }
+
+void PitchShiftEffect::DropdownUpdated(DropdownList* list, int oldVal, double time)
+{
+}
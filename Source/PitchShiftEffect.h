@@ -31,8 +31,9 @@
 #include "Slider.h"
 #include "PitchShifter.h"
 #include "RadioButton.h"
+#include "DropdownList.h"
 
-class PitchShiftEffect : public IAudioEffect, public IIntSliderListener, public IFloatSliderListener, public IRadioButtonListener
+class PitchShiftEffect : public IAudioEffect, public IIntSliderListener, public IFloatSliderListener, public IRadioButtonListener, public IDropdownListener
 {
 public:
    PitchShiftEffect();
@@ -48,10 +49,12 @@ public:
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
    float GetEffectAmount() override;
    std::string GetType() override { return "pitchshift"; }
+   float GetTailLengthMs() override { return 100; } //covers the fft window latency
 
    void IntSliderUpdated(IntSlider* slider, int oldVal, double time) override;
    void FloatSliderUpdated(FloatSlider* slider, float oldVal, double time) override;
    void RadioButtonUpdated(RadioButton* radio, int oldVal, double time) override;
+   void DropdownUpdated(DropdownList* list, int oldVal, double time) override;
 
    bool IsEnabled() const override { return mEnabled; }
 
@@ -64,7 +67,9 @@ private:
    FloatSlider* mRatioSlider{ nullptr };
    int mRatioSelection{ 10 };
    RadioButton* mRatioSelector{ nullptr };
-   PitchShifter* mPitchShifter[ChannelBuffer::kMaxNumChannels];
+   PitchShifter::Quality mQuality{ PitchShifter::Quality::kLow };
+   DropdownList* mQualitySelector{ nullptr };
+   PitchShifter mPitchShifter{ 1024 };
 };
 
 
@@ -27,232 +27,10 @@
 #include "SynthGlobals.h"
 #include "Profiler.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
-PitchShifter::PitchShifter(int fftBins)
-: mFFTBins(fftBins)
-, mFFT(mFFTBins)
-, mRollingInputBuffer(mFFTBins)
-, mRollingOutputBuffer(mFFTBins)
-, mFFTData(mFFTBins, mFFTBins / 2 + 1)
-{
-   // Generate a window with a single raised cosine from N/4 to 3N/4
-   mWindower = new float[mFFTBins];
-   for (int i = 0; i < mFFTBins; ++i)
-      mWindower[i] = -.5 * cos(FTWO_PI * i / mFFTBins) + .5;
-   mLastPhase = new float[mFFTBins / 2 + 1];
-   mSumPhase = new float[mFFTBins / 2 + 1];
-   mAnalysisMag = new float[mFFTBins];
-   mAnalysisFreq = new float[mFFTBins];
-   mSynthesisMag = new float[mFFTBins];
-   mSynthesisFreq = new float[mFFTBins];
-}
-
-PitchShifter::~PitchShifter()
-{
-   delete[] mLastPhase;
-   delete[] mSumPhase;
-   delete[] mWindower;
-   delete[] mAnalysisMag;
-   delete[] mAnalysisFreq;
-   delete[] mSynthesisMag;
-   delete[] mSynthesisFreq;
-}
-
-#define MY_PITCHSHIFTER 0
-
-#if MY_PITCHSHIFTER
-
-void PitchShifter::Process(float* buffer, int bufferSize)
-{
-   PROFILER(PitchShifter);
-
-   const int osamp = mOversampling;
-   const int stepSize = mFFTBins / osamp;
-   const double expct = 2. * M_PI * (double)stepSize / (double)mFFTBins;
-   const double freqPerBin = gSampleRate / (double)mFFTBins;
-
-   mLatency = mFFTBins - stepSize;
-
-   mRollingInputBuffer.WriteChunk(buffer, bufferSize, 0);
-
-   //copy rolling input buffer into working buffer and window it
-   mRollingInputBuffer.ReadChunk(mFFTData.mTimeDomain, mFFTBins, latency);
-   Mult(mFFTData.mTimeDomain, mWindower, mFFTBins);
-
-   mFFT.Forward(mFFTData.mTimeDomain,
-                mFFTData.mRealValues,
-                mFFTData.mImaginaryValues);
-
-   const int fftFrameSize2 = mFFTBins / 2;
-
-   // this is the analysis step
-   for (int k = 0; k <= fftFrameSize2; k++)
-   {
-      // de-interlace FFT buffer
-      float real = mFFTData.mRealValues[k];
-      float imag = mFFTData.mImaginaryValues[k];
-
-      // compute magnitude and phase
-      double mag = 2. * sqrt(real * real + imag * imag);
-      double phase = atan2(imag, real);
-
-      // compute phase difference
-      double diff = phase - mLastPhase[k];
-      mLastPhase[k] = phase;
-
-      // subtract expected phase difference
-      diff -= (double)k * expct;
-
-      // map delta phase into +/- Pi interval
-      long qpd = diff / M_PI;
-      if (qpd >= 0)
-         qpd += qpd & 1;
-      else
-         qpd -= qpd & 1;
-      diff -= M_PI * (double)qpd;
-
-      // get deviation from bin frequency from the +/- Pi interval
-      double deviation = osamp * diff / (2. * M_PI);
-
-      // compute the k-th partials' true frequency
-      double freq = (double)k * freqPerBin + deviation * freqPerBin;
-
-      // store magnitude and true frequency in analysis arrays
-      mAnalysisMag[k] = mag;
-      mAnalysisFreq[k] = freq;
-   }
-
-   // this does the actual pitch shifting
-   memset(mSynthesisMag, 0, mFFTBins * sizeof(float));
-   memset(mSynthesisFreq, 0, mFFTBins * sizeof(float));
-   for (int k = 0; k <= fftFrameSize2; k++)
-   {
-      int index = k * mRatio;
-      if (index <= fftFrameSize2)
-      {
-         mSynthesisMag[index] += mAnalysisMag[k];
-         mSynthesisFreq[index] = mAnalysisFreq[k] * mRatio;
-      }
-   }
-
-   // this is the synthesis step
-   for (int k = 0; k <= fftFrameSize2; k++)
-   {
-      // get magnitude and true frequency from synthesis arrays
-      double mag = mSynthesisMag[k];
-      double tmp = mSynthesisFreq[k];
-
-      // subtract bin mid frequency
-      tmp -= (double)k * freqPerBin;
-
-      // get bin deviation from freq deviation
-      tmp /= freqPerBin;
-
-      // take osamp into account
-      tmp = 2. * M_PI * tmp / osamp;
-
-      // add the overlap phase advance back in
-      tmp += (double)k * expct;
-
-      // accumulate delta phase to get bin phase
-      mSumPhase[k] += tmp;
-      double phase = mSumPhase[k];
-
-      // get real and imag part and re-interleave
-      mFFTData.mRealValues[k + 1] = mag * cos(phase);
-      mFFTData.mImaginaryValues[k + 1] = mag * sin(phase);
-   }
-
-   mFFT.Inverse(mFFTData.mRealValues,
-                mFFTData.mImaginaryValues,
-                mFFTData.mTimeDomain);
-
-   for (int i = 0; i < bufferSize; ++i)
-      mRollingOutputBuffer.Write(0);
-
-   //copy rolling input buffer into working buffer and window it
-   for (int i = 0; i < mFFTBins; ++i)
-      mRollingOutputBuffer.Accum(mFFTBins - i, mFFTData.mTimeDomain[i] * mWindower[i] * .0001f);
-
-   for (int i = 0; i < bufferSize; ++i)
-      buffer[i] = mRollingOutputBuffer.GetSample(latency - i);
-}
-
-#else
-
-void smbFft(float* fftBuffer, long fftFrameSize, long sign)
-/*
-	FFT routine, (C)1996 S.M.Bernsee. Sign = -1 is FFT, 1 is iFFT (inverse)
-	Fills fftBuffer[0...2*fftFrameSize-1] with the Fourier transform of the
-	time domain data in fftBuffer[0...2*fftFrameSize-1]. The FFT array takes
-	and returns the cosine and sine parts in an interleaved manner, ie.
-	fftBuffer[0] = cosPart[0], fftBuffer[1] = sinPart[0], asf. fftFrameSize
-	must be a power of 2. It expects a complex input signal (see footnote 2),
-	ie. when working with 'common' audio signals our input signal has to be
-	passed as {in[0],0.,in[1],0.,in[2],0.,...} asf. In that case, the transform
-	of the frequencies of interest is in fftBuffer[0...fftFrameSize].
- */
-{
-   float wr, wi, arg, *p1, *p2, temp;
-   float tr, ti, ur, ui, *p1r, *p1i, *p2r, *p2i;
-   long i, bitm, j, le, le2, k;
-
-   for (i = 2; i < 2 * fftFrameSize - 2; i += 2)
-   {
-      for (bitm = 2, j = 0; bitm < 2 * fftFrameSize; bitm <<= 1)
-      {
-         if (i & bitm)
-            j++;
-         j <<= 1;
-      }
-      if (i < j)
-      {
-         p1 = fftBuffer + i;
-         p2 = fftBuffer + j;
-         temp = *p1;
-         *(p1++) = *p2;
-         *(p2++) = temp;
-         temp = *p1;
-         *p1 = *p2;
-         *p2 = temp;
-      }
-   }
-   for (k = 0, le = 2; k < (long)(log(fftFrameSize) / log(2.) + .5); k++)
-   {
-      le <<= 1;
-      le2 = le >> 1;
-      ur = 1.0;
-      ui = 0.0;
-      arg = M_PI / (le2 >> 1);
-      wr = cos(arg);
-      wi = sign * sin(arg);
-      for (j = 0; j < le2; j += 2)
-      {
-         p1r = fftBuffer + j;
-         p1i = p1r + 1;
-         p2r = p1r + le2;
-         p2i = p2r + 1;
-         for (i = j; i < 2 * fftFrameSize; i += le)
-         {
-            tr = *p2r * ur - *p2i * ui;
-            ti = *p2r * ui + *p2i * ur;
-            *p2r = *p1r - tr;
-            *p2i = *p1i - ti;
-            *p1r += tr;
-            *p1i += ti;
-            p1r += le;
-            p1i += le;
-            p2r += le;
-            p2i += le;
-         }
-         tr = ur * wr - ui * wi;
-         ui = ur * wi + ui * wr;
-         ur = tr;
-      }
-   }
-}
-
 /****************************************************************************
  *
  * NAME: smbPitchShift.cpp
@@ -291,177 +69,383 @@ void smbFft(float* fftBuffer, long fftFrameSize, long sign)
  *
  *****************************************************************************/
 
-void PitchShifter::Process(float* buffer, int bufferSize)
+namespace
 {
-   PROFILER(PitchShifter);
+   const float kPi = 3.14159265358979f;
+   const float kHalfPi = kPi / 2;
+   const float kTwoPi = kPi * 2;
+   const float kInvTwoPi = 1 / kTwoPi;
 
-   const int fftFrameSize = mFFTBins;
-   const int sampleRate = gSampleRate;
-   const int osamp = mOversampling;
-   const int numSampsToProcess = bufferSize;
-   float* indata = buffer;
-   float* outdata = buffer;
-   const float pitchShift = mRatio;
-
-   double magn, phase, tmp, window, real, imag;
-   double freqPerBin, expct;
-   long i, k, qpd, index, inFifoLatency, stepSize, fftFrameSize2;
-
-   /* set up some handy variables */
-   fftFrameSize2 = fftFrameSize / 2;
-   stepSize = fftFrameSize / osamp;
-   freqPerBin = sampleRate / (double)fftFrameSize;
-   expct = 2. * M_PI * (double)stepSize / (double)fftFrameSize;
-   inFifoLatency = fftFrameSize - stepSize;
-   if (gRover == false)
-      gRover = inFifoLatency;
-
-   mLatency = inFifoLatency;
-
-   /* initialize our static arrays */
-   if (gInit == false)
+   //wrap into [-pi, pi]
+   inline float WrapPhase(float phase)
    {
-      memset(gInFIFO, 0, MAX_FRAME_LENGTH * sizeof(float));
-      memset(gOutFIFO, 0, MAX_FRAME_LENGTH * sizeof(float));
-      memset(gFFTworksp, 0, 2 * MAX_FRAME_LENGTH * sizeof(float));
-      memset(gLastPhase, 0, (MAX_FRAME_LENGTH / 2 + 1) * sizeof(float));
-      memset(gSumPhase, 0, (MAX_FRAME_LENGTH / 2 + 1) * sizeof(float));
-      memset(gOutputAccum, 0, 2 * MAX_FRAME_LENGTH * sizeof(float));
-      memset(gAnaFreq, 0, MAX_FRAME_LENGTH * sizeof(float));
-      memset(gAnaMagn, 0, MAX_FRAME_LENGTH * sizeof(float));
-      gInit = true;
+      return phase - kTwoPi * floorf(phase * kInvTwoPi + .5f);
    }
 
-   /* main processing loop */
-   for (i = 0; i < numSampsToProcess; i++)
+   //the approximations below are branchless so the loops over bins vectorize
+   //accurate to around 1e-5, which is well below what the phase vocoder's own smearing can resolve
+
+   //x in [-pi, pi]
+   inline float SinApprox(float x)
    {
-      /* As long as we have not yet collected enough data just read in */
-      gInFIFO[gRover] = indata[i];
-      outdata[i] = gOutFIFO[gRover - inFifoLatency];
-      gRover++;
+      x = x > kHalfPi ? kPi - x : x;
+      x = x < -kHalfPi ? -kPi - x : x;
+      float x2 = x * x;
+      return x * (1 + x2 * (-1.f / 6 + x2 * (1.f / 120 + x2 * (-1.f / 5040 + x2 * (1.f / 362880)))));
+   }
+
+   //x in [-pi, pi]
+   inline float CosApprox(float x)
+   {
+      return SinApprox(kHalfPi - fabsf(x));
+   }
 
-      /* now we have enough data for processing */
-      if (gRover >= fftFrameSize)
+   inline float Atan2Approx(float y, float x)
+   {
+      float ax = fabsf(x);
+      float ay = fabsf(y);
+      float lo = ax < ay ? ax : ay;
+      float hi = ax < ay ? ay : ax;
+      float a = lo / (hi + 1e-30f);
+      float s = a * a;
+      float r = a * (.99997726f + s * (-.33262347f + s * (.19354346f + s * (-.11643287f + s * (.05265332f + s * -.01172120f)))));
+      r = ay > ax ? kHalfPi - r : r;
+      r = x < 0 ? kPi - r : r;
+      return y < 0 ? -r : r;
+   }
+}
+
+PitchShifter::PitchShifter(int fftBins)
+: mFFTBins(fftBins)
+{
+   assert((fftBins & (fftBins - 1)) == 0);
+
+   const int halfBins = fftBins / 2;
+
+   mWindow.resize(fftBins);
+   for (int i = 0; i < fftBins; ++i)
+      mWindow[i] = -.5 * cos(2 * M_PI * i / fftBins) + .5;
+
+   mTwiddleCos.resize(halfBins);
+   mTwiddleSin.resize(halfBins);
+   for (int i = 0; i < halfBins; ++i)
+   {
+      mTwiddleCos[i] = cos(2 * M_PI * i / fftBins);
+      mTwiddleSin[i] = sin(2 * M_PI * i / fftBins);
+   }
+
+   int bits = 0;
+   while ((1 << bits) < fftBins)
+      ++bits;
+   mBitReverse.resize(fftBins);
+   for (int i = 0; i < fftBins; ++i)
+   {
+      int reversed = 0;
+      for (int b = 0; b < bits; ++b)
       {
-         gRover = inFifoLatency;
+         if (i & (1 << b))
+            reversed |= 1 << (bits - 1 - b);
+      }
+      mBitReverse[i] = reversed;
+   }
 
-         /* do windowing and re,im interleave */
-         for (k = 0; k < fftFrameSize; k++)
-         {
-            window = -.5 * cos(2. * M_PI * (double)k / (double)fftFrameSize) + .5;
-            gFFTworksp[2 * k] = gInFIFO[k] * window;
-            gFFTworksp[2 * k + 1] = 0.;
-         }
+   mReal.resize(fftBins);
+   mImag.resize(fftBins);
+   mMagnitude.resize(halfBins + 1);
+   mFrequency.resize(halfBins + 1);
+   mSynthesisMagnitude.resize(halfBins + 1);
+   mSynthesisFrequency.resize(halfBins + 1);
 
+   for (int ch = 0; ch < kMaxChannels; ++ch)
+   {
+      mSpectrumReal[ch].resize(halfBins + 1);
+      mSpectrumImag[ch].resize(halfBins + 1);
+
+      ChannelState& state = mChannels[ch];
+      state.mInFIFO.resize(fftBins);
+      state.mOutFIFO.resize(fftBins);
+      state.mOutputAccum.resize(fftBins * 2);
+      state.mLastPhase.resize(halfBins + 1);
+      state.mSumPhase.resize(halfBins + 1);
+   }
 
-         /* ***************** ANALYSIS ******************* */
-         /* do transform */
-         smbFft(gFFTworksp, fftFrameSize, -1);
+   Reset();
+}
 
-         /* this is the analysis step */
-         for (k = 0; k <= fftFrameSize2; k++)
-         {
-            /* de-interlace FFT buffer */
-            real = gFFTworksp[2 * k];
-            imag = gFFTworksp[2 * k + 1];
-
-            /* compute magnitude and phase */
-            magn = 2. * sqrt(real * real + imag * imag);
-            phase = atan2(imag, real);
-
-            /* compute phase difference */
-            tmp = phase - gLastPhase[k];
-            gLastPhase[k] = phase;
-
-            /* subtract expected phase difference */
-            tmp -= (double)k * expct;
-
-            /* map delta phase into +/- Pi interval */
-            qpd = tmp / M_PI;
-            if (qpd >= 0)
-               qpd += qpd & 1;
-            else
-               qpd -= qpd & 1;
-            tmp -= M_PI * (double)qpd;
-
-            /* get deviation from bin frequency from the +/- Pi interval */
-            tmp = osamp * tmp / (2. * M_PI);
-
-            /* compute the k-th partials' true frequency */
-            tmp = (double)k * freqPerBin + tmp * freqPerBin;
-
-            /* store magnitude and true frequency in analysis arrays */
-            gAnaMagn[k] = magn;
-            gAnaFreq[k] = tmp;
-         }
+int PitchShifter::GetOverlap(Quality quality)
+{
+   switch (quality)
+   {
+      case Quality::kLow: return 4;
+      case Quality::kMedium: return 8;
+      case Quality::kHigh: return 16;
+   }
+   return 4;
+}
 
-         /* ***************** PROCESSING ******************* */
-         /* this does the actual pitch shifting */
-         memset(gSynMagn, 0, fftFrameSize * sizeof(float));
-         memset(gSynFreq, 0, fftFrameSize * sizeof(float));
-         for (k = 0; k <= fftFrameSize2; k++)
-         {
-            index = k * pitchShift;
-            if (index <= fftFrameSize2)
-            {
-               gSynMagn[index] += gAnaMagn[k];
-               gSynFreq[index] = gAnaFreq[k] * pitchShift;
-            }
-         }
+void PitchShifter::Reset()
+{
+   mCurrentQuality = mQuality;
+   mOverlap = GetOverlap(mCurrentQuality);
+   mRover = mFFTBins - mFFTBins / mOverlap;
+   for (int ch = 0; ch < kMaxChannels; ++ch)
+      ClearChannel(mChannels[ch]);
+}
 
-         /* ***************** SYNTHESIS ******************* */
-         /* this is the synthesis step */
-         for (k = 0; k <= fftFrameSize2; k++)
-         {
-            /* get magnitude and true frequency from synthesis arrays */
-            magn = gSynMagn[k];
-            tmp = gSynFreq[k];
+void PitchShifter::ClearChannel(ChannelState& state)
+{
+   std::fill(state.mInFIFO.begin(), state.mInFIFO.end(), 0);
+   std::fill(state.mOutFIFO.begin(), state.mOutFIFO.end(), 0);
+   std::fill(state.mOutputAccum.begin(), state.mOutputAccum.end(), 0);
+   std::fill(state.mLastPhase.begin(), state.mLastPhase.end(), 0);
+   std::fill(state.mSumPhase.begin(), state.mSumPhase.end(), 0);
+}
 
-            /* subtract bin mid frequency */
-            tmp -= (double)k * freqPerBin;
+void PitchShifter::Process(float* buffer, int bufferSize)
+{
+   ProcessChannels(&buffer, 1, bufferSize);
+}
 
-            /* get bin deviation from freq deviation */
-            tmp /= freqPerBin;
+void PitchShifter::Process(float* left, float* right, int bufferSize)
+{
+   float* channels[kMaxChannels] = { left, right };
+   ProcessChannels(channels, kMaxChannels, bufferSize);
+}
 
-            /* take osamp into account */
-            tmp = 2. * M_PI * tmp / osamp;
+void PitchShifter::ProcessChannels(float** channels, int numChannels, int bufferSize)
+{
+   PROFILER(PitchShifter);
 
-            /* add the overlap phase advance back in */
-            tmp += (double)k * expct;
+   if (mQuality != mCurrentQuality)
+      Reset(); //the frame layout depends on the overlap, so start over
 
-            /* accumulate delta phase to get bin phase */
-            gSumPhase[k] += tmp;
-            phase = gSumPhase[k];
+   for (int ch = mNumChannels; ch < numChannels; ++ch)
+      ClearChannel(mChannels[ch]); //don't play out stale data from when this channel was last active
+   mNumChannels = numChannels;
 
-            /* get real and imag part and re-interleave */
-            gFFTworksp[2 * k] = magn * cos(phase);
-            gFFTworksp[2 * k + 1] = magn * sin(phase);
-         }
+   const int stepSize = mFFTBins / mOverlap;
+   const int latency = mFFTBins - stepSize;
 
-         /* zero negative frequencies */
-         for (k = fftFrameSize + 2; k < 2 * fftFrameSize; k++)
-            gFFTworksp[k] = 0.;
+   int i = 0;
+   while (i < bufferSize)
+   {
+      int count = MIN(bufferSize - i, mFFTBins - mRover);
+      for (int ch = 0; ch < numChannels; ++ch)
+      {
+         ChannelState& state = mChannels[ch];
+         BufferCopy(state.mInFIFO.data() + mRover, channels[ch] + i, count);
+         BufferCopy(channels[ch] + i, state.mOutFIFO.data() + mRover - latency, count);
+      }
+      mRover += count;
+      i += count;
 
-         /* do inverse transform */
-         smbFft(gFFTworksp, fftFrameSize, 1);
+      if (mRover >= mFFTBins)
+      {
+         ProcessFrame(numChannels);
+         mRover = latency;
+      }
+   }
+}
 
-         /* do windowing and add to output accumulator */
-         for (k = 0; k < fftFrameSize; k++)
-         {
-            window = -.5 * cos(2. * M_PI * (double)k / (double)fftFrameSize) + .5;
-            gOutputAccum[k] += 2. * window * gFFTworksp[2 * k] / (fftFrameSize2 * osamp);
-         }
-         for (k = 0; k < stepSize; k++)
-            gOutFIFO[k] = gOutputAccum[k];
+void PitchShifter::ProcessFrame(int numChannels)
+{
+   const int halfBins = mFFTBins / 2;
+   const int stepSize = mFFTBins / mOverlap;
+   const int latency = mFFTBins - stepSize;
+   const float* window = mWindow.data();
+   float* real = mReal.data();
+   float* imag = mImag.data();
+
+   //window, with the second channel (if any) packed into the imaginary part
+   const float* in0 = mChannels[0].mInFIFO.data();
+   for (int k = 0; k < mFFTBins; ++k)
+      real[k] = in0[k] * window[k];
+   if (numChannels > 1)
+   {
+      const float* in1 = mChannels[1].mInFIFO.data();
+      for (int k = 0; k < mFFTBins; ++k)
+         imag[k] = in1[k] * window[k];
+   }
+   else
+   {
+      Clear(imag, mFFTBins);
+   }
+
+   Transform(false);
+
+   //unpack the two real signals' spectra from the complex one
+   float* re0 = mSpectrumReal[0].data();
+   float* im0 = mSpectrumImag[0].data();
+   float* re1 = mSpectrumReal[1].data();
+   float* im1 = mSpectrumImag[1].data();
+   if (numChannels > 1)
+   {
+      for (int k = 0; k <= halfBins; ++k)
+      {
+         int n = (mFFTBins - k) & (mFFTBins - 1);
+         re0[k] = .5f * (real[k] + real[n]);
+         im0[k] = .5f * (imag[k] - imag[n]);
+         re1[k] = .5f * (imag[k] + imag[n]);
+         im1[k] = .5f * (real[n] - real[k]);
+      }
+   }
+   else
+   {
+      BufferCopy(re0, real, halfBins + 1);
+      BufferCopy(im0, imag, halfBins + 1);
+      Clear(re1, halfBins + 1);
+      Clear(im1, halfBins + 1);
+   }
+
+   for (int ch = 0; ch < numChannels; ++ch)
+      ShiftSpectrum(mChannels[ch], mSpectrumReal[ch].data(), mSpectrumImag[ch].data());
+
+   //the outputs have to be real, so DC and nyquist can't have an imaginary part
+   im0[0] = im0[halfBins] = 0;
+   im1[0] = im1[halfBins] = 0;
+
+   //repack as one complex spectrum, filling in the conjugate symmetric upper half of each
+   for (int k = 0; k <= halfBins; ++k)
+   {
+      real[k] = re0[k] - im1[k];
+      imag[k] = im0[k] + re1[k];
+   }
+   for (int k = halfBins + 1; k < mFFTBins; ++k)
+   {
+      int m = mFFTBins - k;
+      real[k] = re0[m] + im1[m];
+      imag[k] = re1[m] - im0[m];
+   }
+
+   Transform(true);
 
-         /* shift accumulator */
-         memmove(gOutputAccum, gOutputAccum + stepSize, fftFrameSize * sizeof(float));
+   //window and overlap-add
+   const float scale = 2.0f / (halfBins * mOverlap);
+   for (int ch = 0; ch < numChannels; ++ch)
+   {
+      ChannelState& state = mChannels[ch];
+      const float* output = (ch == 0) ? real : imag;
+      float* accum = state.mOutputAccum.data();
+      for (int k = 0; k < mFFTBins; ++k)
+         accum[k] += output[k] * window[k] * scale;
+
+      BufferCopy(state.mOutFIFO.data(), accum, stepSize);
+      memmove(accum, accum + stepSize, mFFTBins * sizeof(float));
+      memmove(state.mInFIFO.data(), state.mInFIFO.data() + stepSize, latency * sizeof(float));
+   }
+}
 
-         /* move input FIFO */
-         for (k = 0; k < inFifoLatency; k++)
-            gInFIFO[k] = gInFIFO[k + stepSize];
+void PitchShifter::ShiftSpectrum(ChannelState& state, float* real, float* imag)
+{
+   const int halfBins = mFFTBins / 2;
+   const int stepSize = mFFTBins / mOverlap;
+   const float binPhaseScale = kTwoPi / mFFTBins;
+   const bool approximate = mCurrentQuality != Quality::kHigh;
+   float* magnitude = mMagnitude.data();
+   float* frequency = mFrequency.data();
+   float* lastPhase = state.mLastPhase.data();
+   float* sumPhase = state.mSumPhase.data();
+
+   //analysis: magnitude, and each bin's true frequency (in bins) from its phase advance since the last frame
+   if (approximate)
+   {
+      for (int k = 0; k <= halfBins; ++k)
+         frequency[k] = Atan2Approx(imag[k], real[k]);
+   }
+   else
+   {
+      for (int k = 0; k <= halfBins; ++k)
+         frequency[k] = atan2f(imag[k], real[k]);
+   }
+   for (int k = 0; k <= halfBins; ++k)
+      magnitude[k] = sqrtf(real[k] * real[k] + imag[k] * imag[k]);
+   for (int k = 0; k <= halfBins; ++k)
+   {
+      float phase = frequency[k];
+      float expected = binPhaseScale * ((k * stepSize) & (mFFTBins - 1));
+      float deviation = WrapPhase(phase - lastPhase[k] - expected);
+      lastPhase[k] = phase;
+      frequency[k] = k + deviation * mOverlap * kInvTwoPi;
+   }
+
+   //move each partial to the bin nearest its shifted frequency
+   float* synthesisMagnitude = mSynthesisMagnitude.data();
+   float* synthesisFrequency = mSynthesisFrequency.data();
+   Clear(synthesisMagnitude, halfBins + 1);
+   Clear(synthesisFrequency, halfBins + 1);
+   for (int k = 0; k <= halfBins; ++k)
+   {
+      int index = int(k * mRatio);
+      if (index <= halfBins)
+      {
+         synthesisMagnitude[index] += magnitude[k];
+         synthesisFrequency[index] = frequency[k] * mRatio;
+      }
+   }
+
+   //synthesis: advance each bin's phase by its frequency, then back to rectangular
+   for (int k = 0; k <= halfBins; ++k)
+   {
+      float expected = binPhaseScale * ((k * stepSize) & (mFFTBins - 1));
+      float advance = (synthesisFrequency[k] - k) * kTwoPi / mOverlap + expected;
+      sumPhase[k] = WrapPhase(sumPhase[k] + advance);
+   }
+   if (approximate)
+   {
+      for (int k = 0; k <= halfBins; ++k)
+      {
+         real[k] = synthesisMagnitude[k] * CosApprox(sumPhase[k]);
+         imag[k] = synthesisMagnitude[k] * SinApprox(sumPhase[k]);
+      }
+   }
+   else
+   {
+      for (int k = 0; k <= halfBins; ++k)
+      {
+         real[k] = synthesisMagnitude[k] * cosf(sumPhase[k]);
+         imag[k] = synthesisMagnitude[k] * sinf(sumPhase[k]);
       }
    }
 }
 
-#endif
+//in-place radix-2 complex FFT on mReal/mImag, unnormalized
+void PitchShifter::Transform(bool inverse)
+{
+   float* real = mReal.data();
+   float* imag = mImag.data();
+
+   for (int i = 0; i < mFFTBins; ++i)
+   {
+      int j = mBitReverse[i];
+      if (i < j)
+      {
+         std::swap(real[i], real[j]);
+         std::swap(imag[i], imag[j]);
+      }
+   }
+
+   const float sign = inverse ? 1 : -1;
+   for (int size = 2; size <= mFFTBins; size <<= 1)
+   {
+      const int half = size >> 1;
+      const int tableStep = mFFTBins / size;
+      for (int start = 0; start < mFFTBins; start += size)
+      {
+         float* r0 = real + start;
+         float* i0 = imag + start;
+         float* r1 = r0 + half;
+         float* i1 = i0 + half;
+         for (int j = 0; j < half; ++j)
+         {
+            float wr = mTwiddleCos[j * tableStep];
+            float wi = sign * mTwiddleSin[j * tableStep];
+            float tr = r1[j] * wr - i1[j] * wi;
+            float ti = r1[j] * wi + i1[j] * wr;
+            r1[j] = r0[j] - tr;
+            i1[j] = i0[j] - ti;
+            r0[j] += tr;
+            i0[j] += ti;
+         }
+      }
+   }
+}
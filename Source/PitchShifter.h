@@ -26,56 +26,71 @@
 #ifndef __Bespoke__PitchShifter__
 #define __Bespoke__PitchShifter__
 
-#include <iostream>
-#include "FFT.h"
-#include "RollingBuffer.h"
-
-#define MAX_FRAME_LENGTH 8192
+#include <vector>
 
+//phase vocoder pitch shifter (after smbPitchShift)
+//can run on a stereo pair, in which case both channels are packed into a single complex FFT per frame
 class PitchShifter
 {
 public:
+   enum class Quality
+   {
+      kLow, //4x overlap, approximated trig
+      kMedium, //8x overlap, approximated trig
+      kHigh //16x overlap, exact trig
+   };
+
    PitchShifter(int fftBins);
-   virtual ~PitchShifter();
 
    void Process(float* buffer, int bufferSize);
+   void Process(float* left, float* right, int bufferSize);
    void SetRatio(float ratio) { mRatio = ratio; }
-   void SetOversampling(int oversampling) { mOversampling = oversampling; }
-   int GetLatency() const { return mLatency; }
+   void SetQuality(Quality quality) { mQuality = quality; }
+   int GetLatency() const { return mFFTBins - mFFTBins / GetOverlap(mQuality); }
 
 private:
-   int mFFTBins;
+   static const int kMaxChannels = 2;
 
-   FFTData mFFTData;
+   struct ChannelState
+   {
+      std::vector<float> mInFIFO;
+      std::vector<float> mOutFIFO;
+      std::vector<float> mOutputAccum;
+      std::vector<float> mLastPhase;
+      std::vector<float> mSumPhase;
+   };
 
-   float* mLastPhase{ nullptr };
-   float* mSumPhase{ nullptr };
-   float* mWindower{ nullptr };
-   float* mAnalysisMag{ nullptr };
-   float* mAnalysisFreq{ nullptr };
-   float* mSynthesisMag{ nullptr };
-   float* mSynthesisFreq{ nullptr };
-
-   ::FFT mFFT;
-   RollingBuffer mRollingInputBuffer;
-   RollingBuffer mRollingOutputBuffer;
+   static int GetOverlap(Quality quality);
+   void ProcessChannels(float** channels, int numChannels, int bufferSize);
+   void Reset();
+   void ClearChannel(ChannelState& state);
+   void ProcessFrame(int numChannels);
+   void Transform(bool inverse);
+   void ShiftSpectrum(ChannelState& state, float* real, float* imag);
 
+   int mFFTBins;
    float mRatio{ 1 };
-   int mOversampling{ 4 };
-   float mLatency{ 0 };
+   Quality mQuality{ Quality::kLow };
+   Quality mCurrentQuality{ Quality::kLow };
+   int mOverlap{ 4 };
+   int mRover{ 0 };
+   int mNumChannels{ 1 };
+
+   ChannelState mChannels[kMaxChannels];
 
-   float gInFIFO[MAX_FRAME_LENGTH]{};
-   float gOutFIFO[MAX_FRAME_LENGTH]{};
-   float gFFTworksp[2 * MAX_FRAME_LENGTH]{};
-   float gLastPhase[MAX_FRAME_LENGTH / 2 + 1]{};
-   float gSumPhase[MAX_FRAME_LENGTH / 2 + 1]{};
-   float gOutputAccum[2 * MAX_FRAME_LENGTH]{};
-   float gAnaFreq[MAX_FRAME_LENGTH]{};
-   float gAnaMagn[MAX_FRAME_LENGTH]{};
-   float gSynFreq[MAX_FRAME_LENGTH]{};
-   float gSynMagn[MAX_FRAME_LENGTH]{};
-   long gRover{ false };
-   long gInit{ false };
+   //FFT plan and workspace, shared by both channels
+   std::vector<float> mWindow;
+   std::vector<float> mTwiddleCos;
+   std::vector<float> mTwiddleSin;
+   std::vector<int> mBitReverse;
+   std::vector<float> mReal;
+   std::vector<float> mImag;
+   std::vector<float> mSpectrumReal[kMaxChannels];
+   std::vector<float> mSpectrumImag[kMaxChannels];
+   std::vector<float> mMagnitude;
+   std::vector<float> mFrequency;
+   std::vector<float> mSynthesisMagnitude;
+   std::vector<float> mSynthesisFrequency;
 };
 
 #endif /* defined(__Bespoke__PitchShifter__) */
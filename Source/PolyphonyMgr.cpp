@@ -37,12 +37,17 @@ ChannelBuffer gMidiVoiceWorkChannelBuffer(kWorkBufferSize);
 PolyphonyMgr::PolyphonyMgr(IDrawableModule* owner)
 : mOwner(owner)
 {
+   for (int i = 0; i < kNumVoices; ++i)
+      mVoiceOutputs[i] = new ChannelBuffer(gBufferSize);
 }
 
 PolyphonyMgr::~PolyphonyMgr()
 {
    for (int i = 0; i < kNumVoices; ++i)
+   {
       delete mVoices[i].mVoice;
+      delete mVoiceOutputs[i];
+   }
 }
 
 void PolyphonyMgr::Init(VoiceType type, IVoiceParams* params)
@@ -191,20 +196,40 @@ void PolyphonyMgr::Process(double time, ChannelBuffer* out, int bufferSize)
    mFadeOutBuffer.SetNumActiveChannels(out->NumActiveChannels());
    mFadeOutWorkBuffer.SetNumActiveChannels(out->NumActiveChannels());
 
-   float debugRef = 0;
+   if (mVoiceOutputs[0]->BufferSize() != out->BufferSize())
+   {
+      //the buffer size changed since the lanes were allocated
+      for (int i = 0; i < kNumVoices; ++i)
+         mVoiceOutputs[i]->Resize(out->BufferSize());
+   }
+
+   double blockEndTime = time + bufferSize * gInvSampleRateMs;
    for (int i = 0; i < mVoiceLimit; ++i)
    {
       if (mVoices[i].mPitch != -1)
       {
-         mVoices[i].mVoice->Process(time, out, mOversampling);
-
-         float testSample = out->GetChannel(0)[0];
-         mVoices[i].mActivity = testSample - debugRef;
+         ChannelBuffer* voiceOut = mVoiceOutputs[i];
+         voiceOut->SetNumActiveChannels(out->NumActiveChannels());
+         voiceOut->Clear();
+         mVoices[i].mVoice->Process(time, voiceOut, mOversampling);
 
-         if (!mVoices[i].mNoteOn && mVoices[i].mVoice->IsDone(time))
-            mVoices[i].mPitch = -1;
+         float peak = 0;
+         for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
+         {
+            const float* voiceChannel = voiceOut->GetChannel(ch);
+            for (int j = 0; j < bufferSize; ++j)
+               peak = MAX(peak, fabsf(voiceChannel[j]));
+            Add(out->GetChannel(ch), voiceChannel, bufferSize);
+         }
+         mVoices[i].mActivity = peak;
 
-         debugRef = testSample;
+         if (!mVoices[i].mNoteOn)
+         {
+            if (mVoices[i].mVoice->IsDone(time))
+               mVoices[i].mPitch = -1;
+            else if (mVoices[i].mVoice->IsReleasedBelow(blockEndTime, kVoiceSilenceThreshold))
+               RetireVoice(i); //envelope has released below audibility, don't keep running the rest of the tail
+         }
       }
    }
 
@@ -221,6 +246,12 @@ void PolyphonyMgr::Process(double time, ChannelBuffer* out, int bufferSize)
    mFadeOutBufferPos += bufferSize;
 }
 
+void PolyphonyMgr::RetireVoice(int voiceIdx)
+{
+   mVoices[voiceIdx].mVoice->ClearVoice();
+   mVoices[voiceIdx].mPitch = -1;
+}
+
 void PolyphonyMgr::DrawDebug(float x, float y)
 {
    ofPushMatrix();
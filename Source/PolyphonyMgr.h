@@ -32,6 +32,7 @@
 #include "ChannelBuffer.h"
 
 const int kVoiceFadeSamples = 50;
+const float kVoiceSilenceThreshold = .00001f; //-100dB
 
 extern ChannelBuffer gMidiVoiceWorkChannelBuffer;
 
@@ -75,7 +76,10 @@ public:
    void SetOversampling(int oversampling) { mOversampling = oversampling; }
 
 private:
+   void RetireVoice(int voiceIdx);
+
    VoiceInfo mVoices[kNumVoices];
+   ChannelBuffer* mVoiceOutputs[kNumVoices]{}; //each voice renders into its own buffer, so we can meter it on its own
    bool mAllowStealing{ true };
    int mLastVoice{ -1 };
    ChannelBuffer mFadeOutBuffer{ kVoiceFadeSamples };
@@ -34,6 +34,7 @@
 #include "Checkbox.h"
 #include "Slider.h"
 #include "ClickButton.h"
+#include "AdditiveOscillatorBank.h"
 
 #define NUM_PARTIALS 320
 #define VIZ_WIDTH 1000
@@ -79,7 +80,6 @@ public:
    bool IsEnabled() const override { return mEnabled; }
 
 private:
-   float SinSample(float phase); //phase 0-512
    void CalcAmp();
    void DrawViz();
 
@@ -95,7 +95,7 @@ private:
    float mPhase{ 0 };
    ::ADSR mAdsr[NUM_PARTIALS]{};
    float mAmp[NUM_PARTIALS]{};
-   float mPhases[NUM_PARTIALS]{};
+   AdditiveOscillatorBank mOscillators;
    float mDetune[NUM_PARTIALS]{};
 
    int mPitch{ -1 };
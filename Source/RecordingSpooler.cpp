@@ -0,0 +1,283 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    RecordingSpooler.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RecordingSpooler.h"
+#include "SynthGlobals.h"
+#include "ModularSynth.h"
+
+#include "juce_audio_formats/juce_audio_formats.h"
+
+namespace
+{
+   const int kSpoolIntervalMs = 20;
+   const int kBitDepth = 16;
+}
+
+RecordingSpooler::RecordingSpooler(int ringSizeInSamples)
+: juce::Thread("RecordingSpooler")
+, mFifo(ringSizeInSamples)
+, mRing(ringSizeInSamples)
+{
+   mRing.SetNumActiveChannels(kNumChannels);
+   mRing.Clear(); //allocate up front, not on the audio thread
+}
+
+RecordingSpooler::~RecordingSpooler()
+{
+   Close();
+}
+
+bool RecordingSpooler::Open(const std::string& path, long long leadingSilence /*= 0*/)
+{
+   Close();
+
+   juce::File file(path);
+   file.getParentDirectory().createDirectory();
+   file.deleteFile();
+   auto outputTo = file.createOutputStream();
+   if (outputTo == nullptr)
+   {
+      ofLog() << "couldn't open " << path << " for recording";
+      return false;
+   }
+
+   juce::WavAudioFormat wavFormat;
+   juce::OutputStream* stream = outputTo.release();
+   mWriter.reset(wavFormat.createWriterFor(stream, gSampleRate, kNumChannels, kBitDepth, {}, 0));
+   if (mWriter == nullptr)
+   {
+      delete stream; //the writer only takes ownership on success
+      return false;
+   }
+
+   mPath = path;
+   mFifo.reset();
+   mDroppedSamples = 0;
+   mPendingSilence = leadingSilence;
+   mLength = leadingSilence;
+   {
+      std::lock_guard<ofMutex> lock(mOverviewMutex);
+      for (int ch = 0; ch < kNumChannels; ++ch)
+      {
+         mOverview[ch].clear();
+         mOverview[ch].resize(leadingSilence / kOverviewBlockSize);
+         mOverviewPeak[ch] = 0;
+      }
+      mOverviewBlockPos = leadingSilence % kOverviewBlockSize;
+   }
+
+   mOpen = true;
+   startThread();
+   return true;
+}
+
+void RecordingSpooler::Close()
+{
+   if (!mOpen)
+      return;
+
+   {
+      //once this is released, the audio thread is out of Write() and won't go back in, so Open() is free to reset the fifo
+      ScopedMutex mutex(TheSynth->GetAudioMutex(), "RecordingSpooler::Close()");
+      mOpen = false;
+   }
+   stopThread(1000);
+
+   std::lock_guard<ofMutex> lock(mWriterMutex);
+   Drain();
+   mWriter.reset(); //finalizes the header
+
+   if (mDroppedSamples > 0)
+      ofLog() << "recording to " << mPath << " dropped " << mDroppedSamples << " samples, disk couldn't keep up";
+}
+
+void RecordingSpooler::Write(ChannelBuffer* buffer, int size)
+{
+   float* data[kNumChannels];
+   for (int ch = 0; ch < kNumChannels; ++ch)
+      data[ch] = buffer->GetChannel(MIN(ch, buffer->NumActiveChannels() - 1));
+   Write(data, kNumChannels, size);
+}
+
+void RecordingSpooler::Write(float* const* data, int numChannels, int size)
+{
+   if (!mOpen || numChannels <= 0)
+      return;
+
+   int start1, size1, start2, size2;
+   mFifo.prepareToWrite(size, start1, size1, start2, size2);
+   if (size1 + size2 < size)
+      mDroppedSamples += size - (size1 + size2);
+
+   for (int ch = 0; ch < kNumChannels; ++ch)
+   {
+      const float* src = data[MIN(ch, numChannels - 1)];
+      float* ring = mRing.GetChannel(ch);
+      if (size1 > 0)
+         BufferCopy(ring + start1, src, size1);
+      if (size2 > 0)
+         BufferCopy(ring + start2, src + size1, size2);
+   }
+   mFifo.finishedWrite(size1 + size2);
+   mLength += size1 + size2;
+}
+
+bool RecordingSpooler::CopyTo(const std::string& path)
+{
+   //flushing writes a header that matches what's in the file right now, so copy exactly that much
+   //anything the spooling thread appends after we let go of the lock lands past it, and leaves the part we're copying alone
+   juce::int64 length;
+   {
+      std::lock_guard<ofMutex> lock(mWriterMutex);
+      if (mWriter == nullptr)
+         return false;
+      Drain();
+      if (!mWriter->flush())
+         return false;
+      length = juce::File(mPath).getSize();
+   }
+
+   juce::File outputFile(path);
+   outputFile.getParentDirectory().createDirectory();
+   outputFile.deleteFile();
+   juce::FileInputStream input(juce::File(mPath));
+   std::unique_ptr<juce::FileOutputStream> output = outputFile.createOutputStream();
+   if (!input.openedOk() || output == nullptr)
+      return false;
+   return output->writeFromInputStream(input, length) == length;
+}
+
+void RecordingSpooler::run()
+{
+   while (!threadShouldExit())
+   {
+      {
+         std::lock_guard<ofMutex> lock(mWriterMutex);
+         Drain();
+      }
+      wait(kSpoolIntervalMs);
+   }
+}
+
+//call with mWriterMutex held
+void RecordingSpooler::Drain()
+{
+   if (mWriter == nullptr)
+      return;
+
+   if (mPendingSilence > 0)
+   {
+      const int kSilenceChunkSize = 4096;
+      float silence[kSilenceChunkSize]{};
+      const float* silenceChannels[kNumChannels];
+      for (int ch = 0; ch < kNumChannels; ++ch)
+         silenceChannels[ch] = silence;
+      while (mPendingSilence > 0)
+      {
+         int numSamples = (int)MIN(mPendingSilence, (long long)kSilenceChunkSize);
+         mWriter->writeFromFloatArrays(silenceChannels, kNumChannels, numSamples);
+         mPendingSilence -= numSamples;
+      }
+   }
+
+   int start1, size1, start2, size2;
+   mFifo.prepareToRead(mFifo.getNumReady(), start1, size1, start2, size2);
+   const float* channels[kNumChannels];
+   if (size1 > 0)
+   {
+      for (int ch = 0; ch < kNumChannels; ++ch)
+         channels[ch] = mRing.GetChannel(ch) + start1;
+      mWriter->writeFromFloatArrays(channels, kNumChannels, size1);
+      AddToOverview(channels, size1);
+   }
+   if (size2 > 0)
+   {
+      for (int ch = 0; ch < kNumChannels; ++ch)
+         channels[ch] = mRing.GetChannel(ch) + start2;
+      mWriter->writeFromFloatArrays(channels, kNumChannels, size2);
+      AddToOverview(channels, size2);
+   }
+   mFifo.finishedRead(size1 + size2);
+}
+
+void RecordingSpooler::AddToOverview(const float* const* data, int size)
+{
+   std::lock_guard<ofMutex> lock(mOverviewMutex);
+   int pos = 0;
+   for (int ch = 0; ch < kNumChannels; ++ch)
+   {
+      pos = mOverviewBlockPos;
+      for (int i = 0; i < size; ++i)
+      {
+         mOverviewPeak[ch] = MAX(mOverviewPeak[ch], fabsf(data[ch][i]));
+         if (++pos == kOverviewBlockSize)
+         {
+            mOverview[ch].push_back(mOverviewPeak[ch]);
+            mOverviewPeak[ch] = 0;
+            pos = 0;
+         }
+      }
+   }
+   mOverviewBlockPos = pos;
+}
+
+void RecordingSpooler::DrawOverview(float width, float height, long long displayLength)
+{
+   if (displayLength <= 0 || width <= 0)
+      return;
+
+   std::lock_guard<ofMutex> lock(mOverviewMutex);
+
+   ofPushStyle();
+   ofSetLineWidth(1);
+   ofSetColor(0, 0, 0);
+
+   const float kStepSize = 3;
+   float channelHeight = height / kNumChannels;
+   float blocksPerStep = float(displayLength) / kOverviewBlockSize / width * kStepSize;
+   for (int ch = 0; ch < kNumChannels; ++ch)
+   {
+      const std::vector<float>& overview = mOverview[ch];
+      float center = channelHeight * ch + channelHeight / 2;
+      for (float x = 0; x < width; x += kStepSize)
+      {
+         int start = int(x / kStepSize * blocksPerStep);
+         if (start >= (int)overview.size())
+            break;
+         int end = std::clamp(int((x / kStepSize + 1) * blocksPerStep), start + 1, (int)overview.size());
+
+         float mag = 0;
+         for (int i = start; i < end; ++i)
+            mag = MAX(mag, overview[i]);
+         mag = MIN(pow(mag, .25f) * channelHeight / 2, channelHeight / 2);
+         if (mag == 0)
+            mag = .1f;
+         ofLine(x, center - mag, x, center + mag);
+      }
+   }
+
+   ofPopStyle();
+}
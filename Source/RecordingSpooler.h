@@ -0,0 +1,87 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    RecordingSpooler.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ChannelBuffer.h"
+#include "OpenFrameworksPort.h"
+#include "juce_core/juce_core.h"
+
+namespace juce
+{
+   class AudioFormatWriter;
+}
+
+//streams audio to a wav file from a background thread, so long recordings don't have to live in memory
+//the audio thread only copies into a preallocated lock-free ring
+class RecordingSpooler : public juce::Thread
+{
+public:
+   RecordingSpooler(int ringSizeInSamples);
+   ~RecordingSpooler();
+
+   bool Open(const std::string& path, long long leadingSilence = 0);
+   void Close(); //finishes writing the file
+   bool IsOpen() const { return mOpen; }
+   const std::string& GetPath() const { return mPath; }
+
+   //audio thread. mono input is written to both channels
+   void Write(ChannelBuffer* buffer, int size);
+   void Write(float* const* data, int numChannels, int size);
+   long long GetLength() const { return mLength; } //includes leading silence
+   int GetDroppedSamples() const { return mDroppedSamples; }
+
+   bool CopyTo(const std::string& path); //a complete wav of everything recorded so far, recording carries on
+   void DrawOverview(float width, float height, long long displayLength);
+
+   static const int kNumChannels = ChannelBuffer::kMaxNumChannels;
+
+private:
+   void run() override;
+   void Drain();
+   void AddToOverview(const float* const* data, int size);
+
+   juce::AbstractFifo mFifo;
+   ChannelBuffer mRing;
+   std::atomic<bool> mOpen{ false };
+   std::atomic<long long> mLength{ 0 };
+   std::atomic<int> mDroppedSamples{ 0 };
+   std::string mPath;
+   long long mPendingSilence{ 0 };
+
+   ofMutex mWriterMutex;
+   std::unique_ptr<juce::AudioFormatWriter> mWriter;
+
+   static const int kOverviewBlockSize = 1024;
+   ofMutex mOverviewMutex;
+   std::vector<float> mOverview[kNumChannels]; //peak per block
+   float mOverviewPeak[kNumChannels]{};
+   int mOverviewBlockPos{ 0 };
+};
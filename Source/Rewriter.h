@@ -30,7 +30,7 @@
 #include "IAudioProcessor.h"
 #include "IDrawableModule.h"
 #include "ClickButton.h"
-#include "RollingBuffer.h"
+#include "DelayLine.h"
 #include "MidiDevice.h"
 #include "Checkbox.h"
 
@@ -83,7 +83,7 @@ private:
    ClickButton* mRewriteButton{ nullptr };
    ClickButton* mStartRecordTimeButton{ nullptr };
 
-   RollingBuffer mRecordBuffer;
+   DelayLine mRecordBuffer;
    Looper* mConnectedLooper{ nullptr };
 
    PatchCableSource* mLooperCable{ nullptr };
@@ -27,11 +27,11 @@
 #include "SynthGlobals.h"
 #include "ModularSynth.h"
 #include "Profiler.h"
+#include "BufferArena.h"
 #include "Scale.h"
 
 RingModulator::RingModulator()
 : IAudioProcessor(gBufferSize)
-, mDryBuffer(gBufferSize)
 {
    mModOsc.Start(gTime, 1);
    mFreqRamp.Start(gTime, 220, gTime + mGlideTime);
@@ -62,13 +62,14 @@ void RingModulator::Process(double time)
       return;
 
    SyncBuffers();
-   mDryBuffer.SetNumActiveChannels(GetBuffer()->NumActiveChannels());
 
    int bufferSize = target->GetBuffer()->BufferSize();
+   ScratchBuffer dryBuffer(GetBuffer()->BufferSize(), GetBuffer()->NumActiveChannels());
 
    if (mEnabled)
    {
-      mDryBuffer.CopyFrom(GetBuffer());
+      for (int ch = 0; ch < GetBuffer()->NumActiveChannels(); ++ch)
+         BufferCopy(dryBuffer.Get(ch), GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize());
 
       for (int i = 0; i < bufferSize; ++i)
       {
@@ -92,9 +93,9 @@ void RingModulator::Process(double time)
    {
       if (mEnabled)
       {
-         Mult(mDryBuffer.GetChannel(ch), (1 - mDryWet) * mVolume * mVolume, GetBuffer()->BufferSize());
+         Mult(dryBuffer.Get(ch), (1 - mDryWet) * mVolume * mVolume, GetBuffer()->BufferSize());
          Mult(GetBuffer()->GetChannel(ch), mDryWet * mVolume * mVolume, GetBuffer()->BufferSize());
-         Add(GetBuffer()->GetChannel(ch), mDryBuffer.GetChannel(ch), GetBuffer()->BufferSize());
+         Add(GetBuffer()->GetChannel(ch), dryBuffer.Get(ch), GetBuffer()->BufferSize());
       }
 
       Add(target->GetBuffer()->GetChannel(ch), GetBuffer()->GetChannel(ch), GetBuffer()->BufferSize());
@@ -78,8 +78,6 @@ private:
       height = 68;
    }
 
-   ChannelBuffer mDryBuffer;
-
    float mFreq{ 220 };
    float mDryWet{ 1 };
    float mVolume{ 1 };
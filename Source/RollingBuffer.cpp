@@ -35,37 +35,45 @@ RollingBuffer::~RollingBuffer()
 {
 }
 
-float RollingBuffer::GetSample(int samplesAgo, int channel)
+WrappedSpan RollingBuffer::GetSpan(int size, int samplesAgo, int channel)
 {
-   assert(samplesAgo >= 0);
-   assert(samplesAgo < Size());
-   return mBuffer.GetChannel(channel)[(Size() + mOffsetToNow[channel] - samplesAgo) % Size()];
+   assert(size >= 0 && size <= Size());
+   assert(samplesAgo >= 0 && samplesAgo <= Size());
+
+   float* buffer = mBuffer.GetChannel(channel);
+   int start = mOffsetToNow[channel] - samplesAgo;
+   if (start < 0)
+      start += Size();
+   start -= size;
+   if (start < 0)
+      start += Size();
+
+   WrappedSpan span;
+   span.mFirst = buffer + start;
+   span.mFirstSize = MIN(size, Size() - start);
+   span.mSecond = buffer;
+   span.mSecondSize = size - span.mFirstSize;
+   return span;
 }
 
 void RollingBuffer::ReadChunk(float* dst, int size, int samplesAgo, int channel)
 {
    assert(size <= Size());
 
-   int offset = mOffsetToNow[channel] - samplesAgo;
-   if (offset < 0)
-      offset += Size();
-
-   int wrapSamples = size - offset;
-   if (wrapSamples <= 0) //no wraparound
-   {
-      BufferCopy(dst, mBuffer.GetChannel(channel) + (offset - size), size);
-   }
-   else //wrap around loop point
-   {
-      BufferCopy(dst, mBuffer.GetChannel(channel) + (Size() - wrapSamples), wrapSamples);
-      BufferCopy(dst + wrapSamples, mBuffer.GetChannel(channel), (size - wrapSamples));
-   }
+   WrappedSpan span = GetSpan(size, samplesAgo, channel);
+   BufferCopy(dst, span.mFirst, span.mFirstSize);
+   if (span.mSecondSize > 0) //wrap around loop point
+      BufferCopy(dst + span.mFirstSize, span.mSecond, span.mSecondSize);
 }
 
 void RollingBuffer::Accum(int samplesAgo, float sample, int channel)
 {
+   assert(samplesAgo >= 0);
    assert(samplesAgo < Size());
-   mBuffer.GetChannel(channel)[(Size() + mOffsetToNow[channel] - samplesAgo) % Size()] += sample;
+   int index = mOffsetToNow[channel] - samplesAgo;
+   if (index < 0)
+      index += Size();
+   mBuffer.GetChannel(channel)[index] += sample;
 }
 
 void RollingBuffer::WriteChunk(float* samples, int size, int channel)
@@ -83,7 +91,9 @@ void RollingBuffer::WriteChunk(float* samples, int size, int channel)
       BufferCopy(mBuffer.GetChannel(channel), samples + (size - wrapSamples), wrapSamples);
    }
 
-   mOffsetToNow[channel] = (mOffsetToNow[channel] + size) % Size();
+   mOffsetToNow[channel] += size;
+   if (mOffsetToNow[channel] >= Size())
+      mOffsetToNow[channel] -= Size();
    if (channel != 0 && mOffsetToNow[channel] < mOffsetToNow[0] - gBufferSize * 2) //channels out of sync, probably was only writing to channel 0 for a while
       mOffsetToNow[channel] = mOffsetToNow[0];
 }
@@ -91,7 +101,8 @@ void RollingBuffer::WriteChunk(float* samples, int size, int channel)
 void RollingBuffer::Write(float sample, int channel)
 {
    mBuffer.GetChannel(channel)[mOffsetToNow[channel]] = sample;
-   mOffsetToNow[channel] = (mOffsetToNow[channel] + 1) % Size();
+   if (++mOffsetToNow[channel] == Size())
+      mOffsetToNow[channel] = 0;
    if (channel != 0 && mOffsetToNow[channel] < mOffsetToNow[0] - gBufferSize * 2) //channels out of sync, probably was only writing to channel 0 for a while
       mOffsetToNow[channel] = mOffsetToNow[0];
 }
@@ -30,13 +30,33 @@
 #include "FileStream.h"
 #include "ChannelBuffer.h"
 
+//a run of samples in a circular buffer, split at the wraparound point so each part can be processed with a plain loop
+//walking mFirst and then mSecond visits the samples from oldest to newest. either part may be empty
+struct WrappedSpan
+{
+   float* mFirst{ nullptr };
+   int mFirstSize{ 0 };
+   float* mSecond{ nullptr };
+   int mSecondSize{ 0 };
+
+   int Size() const { return mFirstSize + mSecondSize; }
+};
+
 class RollingBuffer
 {
 public:
    RollingBuffer(int sizeInSamples);
    ~RollingBuffer();
-   float GetSample(int samplesAgo, int channel);
+   float GetSample(int samplesAgo, int channel)
+   {
+      assert(samplesAgo >= 0 && samplesAgo < Size());
+      int index = mOffsetToNow[channel] - samplesAgo;
+      if (index < 0)
+         index += Size();
+      return mBuffer.GetChannel(channel)[index];
+   }
    void ReadChunk(float* dst, int size, int samplesAgo, int channel);
+   WrappedSpan GetSpan(int size, int samplesAgo, int channel); //same samples that ReadChunk() would copy out
    void WriteChunk(float* samples, int size, int channel);
    void Write(float sample, int channel);
    void ClearBuffer();
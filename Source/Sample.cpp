@@ -28,20 +28,61 @@
 #include "FileStream.h"
 #include "ModularSynth.h"
 #include "ChannelBuffer.h"
+#include "SampleRateConverter.h"
+#include "BufferArena.h"
+#include "UserPrefs.h"
+#include <functional>
 #include <memory>
 
 #include "juce_audio_formats/juce_audio_formats.h"
 
+namespace
+{
+   //one background thread shared by every sample, rather than one per load
+   juce::ThreadPool& GetConversionPool()
+   {
+      static juce::ThreadPool sPool(1);
+      return sPool;
+   }
+
+   class ConversionJob : public juce::ThreadPoolJob
+   {
+   public:
+      ConversionJob(std::function<void()> convert)
+      : juce::ThreadPoolJob("sample rate conversion")
+      , mConvert(convert)
+      {}
+
+      JobStatus runJob() override
+      {
+         mConvert();
+         return jobHasFinished;
+      }
+
+   private:
+      std::function<void()> mConvert;
+   };
+}
+
 Sample::Sample()
 {
+   mData.EnablePeaks();
 }
 
 Sample::~Sample()
 {
+   if (mConversionJob != nullptr)
+   {
+      GetConversionPool().waitForJobToFinish(mConversionJob.get(), -1);
+      for (auto* data : mConvertedData)
+         BufferArena::Free(data);
+   }
 }
 
 bool Sample::Read(const char* path, bool mono, ReadType readType)
 {
+   WaitForSampleRateConversion();
+
    mReadPath = path;
    ofStringReplace(mReadPath, GetPathSeparator(), "/");
    std::vector<std::string> tokens = ofSplitString(mReadPath, "/");
@@ -103,11 +144,93 @@ void Sample::FinishRead()
       for (int ch = 0; ch < mReadBuffer->getNumChannels(); ++ch)
          BufferCopy(mData.GetChannel(ch), mReadBuffer->getReadPointer(ch), mReadBuffer->getNumSamples());
    }
+   mData.MarkDirty(0, mReadBuffer->getNumSamples());
+
+   //convert once here, so that playback only has to deal with pitch changes, and doesn't alias when the file's rate is lower than ours
+   //the conversion runs in the background for both read types. until it's swapped in, the unconverted data plays back through mSampleRateRatio
+   if (UserPrefs.resample_samples_on_load.Get() && mOriginalSampleRate != gSampleRate && mNumSamples > 0)
+   {
+      //IsSampleLoading() stays true until the converted data is swapped in
+      mConvertingSampleRate = true;
+      mConversionJob = std::make_unique<ConversionJob>([this]
+                                                       {
+                                                          ConvertToSessionSampleRate();
+                                                       });
+      GetConversionPool().addJob(mConversionJob.get(), false);
+      startTimer(50); //to pick up the result on the main thread
+   }
+}
+
+//conversion thread. only reads mData, which nothing changes without waiting for us first
+void Sample::ConvertToSessionSampleRate()
+{
+   mConvertedLength = SampleRateConverter::GetOutputLength(mNumSamples, mOriginalSampleRate, gSampleRate);
+   for (int ch = 0; ch < mData.NumActiveChannels(); ++ch)
+   {
+      mConvertedData[ch] = BufferArena::Allocate(mConvertedLength);
+      SampleRateConverter::Convert(mData.GetChannel(ch), mNumSamples, mOriginalSampleRate, mConvertedData[ch], gSampleRate);
+   }
+}
+
+//main thread, so nothing drawing from the old data can still be looking at it
+void Sample::ApplySampleRateConversion()
+{
+   int channels = mData.NumActiveChannels();
+
+   {
+      //the audio lock keeps every module's processing off the old data. this only swaps pointers, so it's held briefly
+      ScopedMutex mutex(TheSynth->GetAudioMutex(), "Sample::ApplySampleRateConversion()");
+      mPlayMutex.lock();
+      LockDataMutex(true);
+      double scale = double(gSampleRate) / mOriginalSampleRate;
+      if (mOffset < mNumSamples)
+         mOffset *= scale;
+      else
+         mOffset = mConvertedLength;
+      if (mStopPoint != -1)
+         mStopPoint = int(mStopPoint * scale);
+      mData.Resize(mConvertedLength);
+      mData.SetNumActiveChannels(channels);
+      for (int ch = 0; ch < channels; ++ch)
+         mData.SetChannelPointer(mConvertedData[ch], ch, false);
+      mNumSamples = mConvertedLength;
+      mOriginalSampleRate = gSampleRate;
+      mSampleRateRatio = 1;
+      LockDataMutex(false);
+      mPlayMutex.unlock();
+   }
+
+   for (auto& data : mConvertedData)
+      data = nullptr;
+   mConvertingSampleRate = false;
+}
+
+float Sample::GetLengthMs() const
+{
+   return mNumSamples / mSampleRateRatio * gInvSampleRateMs;
+}
+
+void Sample::WaitForSampleRateConversion()
+{
+   if (mConversionJob == nullptr)
+      return;
+
+   GetConversionPool().waitForJobToFinish(mConversionJob.get(), -1);
+   mConversionJob.reset();
+   stopTimer();
+   ApplySampleRateConversion();
 }
 
 //juce::Timer
 void Sample::timerCallback()
 {
+   if (mConversionJob != nullptr)
+   {
+      if (!GetConversionPool().contains(mConversionJob.get()))
+         WaitForSampleRateConversion(); //already done, so this just swaps it in
+      return;
+   }
+
    int samplesToRead = 44100 * 10;
    if (samplesToRead > mSamplesLeftToRead)
       samplesToRead = mSamplesLeftToRead;
@@ -117,13 +240,14 @@ void Sample::timerCallback()
 
    if (mSamplesLeftToRead <= 0)
    {
-      FinishRead();
       stopTimer();
+      FinishRead(); //might start the timer again, to wait for the conversion
    }
 }
 
 void Sample::Create(int length)
 {
+   WaitForSampleRateConversion();
    mData.Resize(length);
    mData.SetNumActiveChannels(1);
    Setup(length);
@@ -131,12 +255,14 @@ void Sample::Create(int length)
 
 void Sample::Create(ChannelBuffer* data)
 {
+   WaitForSampleRateConversion();
    int channels = data->NumActiveChannels();
    int length = data->BufferSize();
    mData.Resize(length);
    mData.SetNumActiveChannels(channels);
    for (int ch = 0; ch < channels; ++ch)
       BufferCopy(mData.GetChannel(ch), data->GetChannel(ch), length);
+   mData.MarkDirty(0, length);
    Setup(length);
 }
 
@@ -154,6 +280,7 @@ void Sample::Setup(int length)
 
 bool Sample::Write(const char* path /*=nullptr*/)
 {
+   WaitForSampleRateConversion();
    const std::string writeTo = path ? path : mReadPath;
    WriteDataToFile(writeTo, &mData, mNumSamples);
    return true;
@@ -200,6 +327,48 @@ void Sample::Play(double startTime, float rate /*=1*/, int offset /*=0*/, int st
    mPlayMutex.unlock();
 }
 
+namespace
+{
+   const int kReadChunkSize = 256;
+
+   //linearly interpolated reads at offset, offset + step, offset + 2*step...
+   //equivalent to calling GetInterpolatedSample() for each one, but without wrapping every read while they stay inside the buffer
+   void ReadInterpolated(const float* buffer, int bufferSize, double offset, double step, float* out, int count)
+   {
+      int i = 0;
+      while (i < count)
+      {
+         double pos = offset + step * i;
+         int span = 0;
+         if (step >= 0 && pos >= 0 && pos < bufferSize - 1)
+         {
+            span = count - i;
+            if (step > 0)
+               span = MIN(span, (int)ceil((bufferSize - 1 - pos) / step));
+            while (span > 0 && pos + step * (span - 1) >= bufferSize - 1) //guard against rounding at the edge
+               --span;
+         }
+
+         if (span > 0)
+         {
+            for (int j = 0; j < span; ++j)
+            {
+               double samplePos = pos + step * j;
+               int index = int(samplePos);
+               float a = float(samplePos - index);
+               out[i + j] = (1 - a) * buffer[index] + a * buffer[index + 1];
+            }
+            i += span;
+         }
+         else
+         {
+            out[i] = GetInterpolatedSample(pos, buffer, bufferSize);
+            ++i;
+         }
+      }
+   }
+}
+
 bool Sample::ConsumeData(double time, ChannelBuffer* out, int size, bool replace)
 {
    assert(size <= out->BufferSize());
@@ -219,36 +388,51 @@ bool Sample::ConsumeData(double time, ChannelBuffer* out, int size, bool replace
    }
 
    LockDataMutex(true);
-   for (int i = 0; i < size; ++i)
+
+   //nothing plays before the start time
+   int startIndex = 0;
+   while (startIndex < size && time < mStartTime)
+   {
+      time += gInvSampleRateMs;
+      ++startIndex;
+   }
+   if (replace)
+   {
+      for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
+         ::Clear(out->GetChannel(ch), startIndex);
+   }
+
+   int count = size - startIndex;
+   double step = mRate * mSampleRateRatio;
+
+   //past the end point is silent, unless we're looping
+   int playable = count;
+   if (!mLooping && step > 0)
+      playable = (int)ofClamp(ceil((end - mOffset) / step), 0, count);
+
+   for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
    {
-      if (time < mStartTime)
+      const float* data = mData.GetChannel(MIN(ch, mData.NumActiveChannels() - 1));
+      float* dest = out->GetChannel(ch) + startIndex;
+
+      float chunk[kReadChunkSize];
+      for (int i = 0; i < playable; i += kReadChunkSize)
       {
+         int chunkSize = MIN(kReadChunkSize, playable - i);
+         ReadInterpolated(data, mNumSamples, mOffset + step * i, step, chunk, chunkSize);
+         Mult(chunk, mVolume, chunkSize);
          if (replace)
-         {
-            for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
-               out->GetChannel(ch)[i] = 0;
-         }
+            BufferCopy(dest + i, chunk, chunkSize);
+         else
+            Add(dest + i, chunk, chunkSize);
       }
-      else
-      {
-         for (int ch = 0; ch < out->NumActiveChannels(); ++ch)
-         {
-            int dataChannel = MIN(ch, mData.NumActiveChannels() - 1);
 
-            float sample = 0;
-            if (mOffset < end || mLooping)
-               sample = GetInterpolatedSample(mOffset, mData.GetChannel(dataChannel), mNumSamples) * mVolume;
+      if (replace)
+         ::Clear(dest + playable, count - playable);
+   }
 
-            if (replace)
-               out->GetChannel(ch)[i] = sample;
-            else
-               out->GetChannel(ch)[i] += sample;
-         }
+   mOffset += step * count;
 
-         mOffset += mRate * mSampleRateRatio;
-      }
-      time += gInvSampleRateMs;
-   }
    LockDataMutex(false);
    mPlayMutex.unlock();
 
@@ -300,6 +484,8 @@ void Sample::ShiftWrap(int numSamplesToShift)
 
 void Sample::CopyFrom(Sample* sample)
 {
+   WaitForSampleRateConversion();
+   sample->WaitForSampleRateConversion();
    mNumSamples = sample->mNumSamples;
    if (mData.BufferSize() != sample->mData.BufferSize())
       mData.Resize(sample->mNumSamples);
@@ -321,6 +507,8 @@ namespace
 
 void Sample::SaveState(FileStreamOut& out)
 {
+   WaitForSampleRateConversion();
+
    out << kSaveStateRev;
 
    out << mNumSamples;
@@ -337,6 +525,8 @@ void Sample::SaveState(FileStreamOut& out)
 
 void Sample::LoadState(FileStreamIn& in)
 {
+   WaitForSampleRateConversion();
+
    int rev;
    in >> rev;
 
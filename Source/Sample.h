@@ -29,6 +29,8 @@
 #include "OpenFrameworksPort.h"
 #include "ChannelBuffer.h"
 #include <limits>
+#include <atomic>
+#include <memory>
 
 #include "juce_events/juce_events.h"
 
@@ -85,8 +87,11 @@ public:
    int GetNumBars() const { return mNumBars; }
    void SetVolume(float vol) { mVolume = vol; }
    void CopyFrom(Sample* sample);
-   bool IsSampleLoading() { return mSamplesLeftToRead > 0; }
+   bool IsSampleLoading() { return mSamplesLeftToRead > 0 || mConvertingSampleRate; }
    float GetSampleLoadProgress() { return (mNumSamples > 0) ? (1 - (float(mSamplesLeftToRead) / mNumSamples)) : 1; }
+   float GetLengthMs() const; //correct before and after sample rate conversion
+   //Read() converts to the session rate in the background, and swaps the result in on the main thread. call this first if you need the converted data, or positions in it, right away
+   void WaitForSampleRateConversion();
 
    void SaveState(FileStreamOut& out);
    void LoadState(FileStreamIn& in);
@@ -94,6 +99,8 @@ public:
 private:
    void Setup(int length);
    void FinishRead();
+   void ConvertToSessionSampleRate();
+   void ApplySampleRateConversion();
    //juce::Timer
    void timerCallback();
 
@@ -116,6 +123,10 @@ private:
    juce::AudioFormatReader* mReader{};
    std::unique_ptr<juce::AudioSampleBuffer> mReadBuffer;
    int mSamplesLeftToRead{ 0 };
+   std::unique_ptr<juce::ThreadPoolJob> mConversionJob;
+   float* mConvertedData[ChannelBuffer::kMaxNumChannels]{};
+   int mConvertedLength{ 0 };
+   std::atomic<bool> mConvertingSampleRate{ false };
 };
 
 #endif /* defined(__modularSynth__Sample__) */
@@ -74,6 +74,9 @@ void SampleBrowser::DrawModule()
       textX = moduleWidth - 3 - stringWidth;
    gFont.DrawString(mCurrentDirectory.toStdString(), fontSize, textX, 15);
 
+   if (mWaitingForIndex)
+      DrawTextNormal("scanning...", 30, 32);
+
    for (size_t i = 0; i < mButtons.size(); ++i)
       mButtons[i]->Draw();
    mBackButton->Draw();
@@ -107,7 +110,7 @@ void SampleBrowser::ButtonClicked(ClickButton* button, double time)
                else
                   SetDirectory("");
             }
-            else if (File(clicked).isDirectory())
+            else if (entryIndex < mNumDirectoryEntries)
             {
                SetDirectory(clicked);
             }
@@ -120,27 +123,13 @@ void SampleBrowser::ButtonClicked(ClickButton* button, double time)
    }
 }
 
-namespace
+void SampleBrowser::Poll()
 {
-   int CompareDirectoryListing(const String& text, const String& other)
-   {
-      if (text == other)
-         return 0;
-      bool isDir = text == ".." || File(text).isDirectory();
-      bool isOtherDir = other == ".." || File(other).isDirectory();
-      if (isDir && !isOtherDir)
-         return -1;
-      if (!isDir && isOtherDir)
-         return 1;
-      return text.compareIgnoreCase(other);
-   }
-
-   void SortDirectoryListing(StringArray& listing)
+   //the index fills in (or notices changes to) the current directory in the background
+   if (mCurrentDirectory != "" && mListingGeneration != TheSynth->GetSampleLibraryIndex()->GetGeneration())
    {
-      std::sort(listing.begin(), listing.end(), [](const String& a, const String& b)
-                {
-                   return CompareDirectoryListing(a, b) < 0;
-                });
+      UpdateListing();
+      ShowPage(mCurrentPage);
    }
 }
 
@@ -148,40 +137,52 @@ void SampleBrowser::SetDirectory(String dirPath)
 {
    mCurrentDirectory = dirPath;
 
+   //listing straight from disk froze the ui on big folders, so we show what the index has and let it catch up
+   if (dirPath != "")
+      TheSynth->GetSampleLibraryIndex()->RequestScan(ofToDataPath(dirPath.toStdString()), false, true);
+
+   UpdateListing();
+   ShowPage(0);
+}
+
+void SampleBrowser::UpdateListing()
+{
    mDirectoryListing.clear();
+   mNumDirectoryEntries = 0;
+   mWaitingForIndex = false;
 
-   if (dirPath != "")
+   auto compare = [](const String& a, const String& b)
    {
-      String matcher = TheSynth->GetAudioFormatManager().getWildcardForAllFormats();
+      return a.compareIgnoreCase(b) < 0;
+   };
 
-      StringArray wildcards;
-      wildcards.addTokens(matcher, ";,", "\"'");
-      wildcards.trim();
-      wildcards.removeEmptyStrings();
+   if (mCurrentDirectory != "")
+   {
+      mListingGeneration = TheSynth->GetSampleLibraryIndex()->GetGeneration();
 
       mDirectoryListing.add("..");
+      ++mNumDirectoryEntries;
 
-      File dir(ofToDataPath(dirPath.toStdString()));
-      for (auto file : dir.findChildFiles(File::findFilesAndDirectories | File::ignoreHiddenFiles, false))
+      std::vector<std::string> subdirectories;
+      std::vector<std::string> samples;
+      if (TheSynth->GetSampleLibraryIndex()->GetListing(ofToDataPath(mCurrentDirectory.toStdString()), subdirectories, samples))
       {
-         bool include = false;
-         if (file.isDirectory())
-         {
-            include = true;
-         }
-         else
-         {
-            for (auto& w : wildcards)
-            {
-               if (file.getFileName().matchesWildcard(w, true))
-               {
-                  include = true;
-                  break;
-               }
-            }
-         }
-         if (include)
-            mDirectoryListing.add(file.getFullPathName());
+         StringArray sortedSubdirectories;
+         for (const auto& subdirectory : subdirectories)
+            sortedSubdirectories.add(subdirectory);
+         std::sort(sortedSubdirectories.begin(), sortedSubdirectories.end(), compare);
+         mDirectoryListing.addArray(sortedSubdirectories);
+         mNumDirectoryEntries += sortedSubdirectories.size();
+
+         StringArray sortedSamples;
+         for (const auto& sample : samples)
+            sortedSamples.add(sample);
+         std::sort(sortedSamples.begin(), sortedSamples.end(), compare);
+         mDirectoryListing.addArray(sortedSamples);
+      }
+      else
+      {
+         mWaitingForIndex = true;
       }
    }
    else
@@ -190,10 +191,9 @@ void SampleBrowser::SetDirectory(String dirPath)
       File::findFileSystemRoots(roots);
       for (auto root : roots)
          mDirectoryListing.add(root.getFullPathName());
+      std::sort(mDirectoryListing.begin(), mDirectoryListing.end(), compare);
+      mNumDirectoryEntries = mDirectoryListing.size();
    }
-   SortDirectoryListing(mDirectoryListing);
-
-   ShowPage(0);
 }
 
 void SampleBrowser::ShowPage(int page)
@@ -206,7 +206,7 @@ void SampleBrowser::ShowPage(int page)
       if (i + offset < (int)mDirectoryListing.size())
       {
          mButtons[i]->SetShowing(true);
-         if (mDirectoryListing[i + offset] == ".." || File(mDirectoryListing[i + offset]).isDirectory())
+         if (i + offset < mNumDirectoryEntries)
             mButtons[i]->SetDisplayStyle(ButtonDisplayStyle::kFolderIcon);
          else
             mButtons[i]->SetDisplayStyle(ButtonDisplayStyle::kSampleIcon);
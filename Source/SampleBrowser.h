@@ -54,6 +54,8 @@ public:
 
    bool IsEnabled() const override { return true; }
 
+   void Poll() override;
+
 private:
    //IDrawableModule
    void DrawModule() override;
@@ -64,11 +66,15 @@ private:
    }
 
    void SetDirectory(juce::String dirPath);
+   void UpdateListing();
    int GetNumPages() const;
    void ShowPage(int page);
 
    juce::String mCurrentDirectory;
-   juce::StringArray mDirectoryListing;
+   juce::StringArray mDirectoryListing; //directories first, then samples
+   int mNumDirectoryEntries{ 0 };
+   int mListingGeneration{ -1 };
+   bool mWaitingForIndex{ false };
    std::array<ClickButton*, 30> mButtons;
    ClickButton* mBackButton{ nullptr };
    ClickButton* mForwardButton{ nullptr };
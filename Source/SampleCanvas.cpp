@@ -186,6 +186,7 @@ void SampleCanvas::FilesDropped(std::vector<std::string> files, int x, int y)
 {
    Sample sample;
    sample.Read(files[0].c_str());
+   sample.WaitForSampleRateConversion();
    SampleDropped(x, y, &sample);
 }
 
@@ -196,6 +196,7 @@ void SampleFinder::FilesDropped(std::vector<std::string> files, int x, int y)
    mSample->Reset();
 
    mSample->Read(files[0].c_str());
+   mSample->WaitForSampleRateConversion();
 
    mClipStart = 0;
    mClipEnd = mSample->LengthInSamples();
@@ -0,0 +1,504 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleLibraryIndex.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SampleLibraryIndex.h"
+
+#include <algorithm>
+#include <memory>
+#include "SynthGlobals.h"
+#include "FileStream.h"
+#include "UserPrefs.h"
+
+#include "juce_audio_formats/juce_audio_formats.h"
+
+namespace
+{
+   const int kCacheRev = 1;
+   const int kIdleWaitMs = 500;
+   const juce::uint32 kSaveIntervalMs = 60000; //during a long scan, so progress isn't lost if we quit or crash
+   const double kMaxThumbnailSeconds = 60 * 5; //longer files would make the scan crawl, so they get no thumbnail
+
+   std::string CacheFilePath()
+   {
+      return ofToDataPath("internal/sample_index.dat");
+   }
+
+   bool IsUnder(const std::string& path, const std::string& root)
+   {
+      const juce::String separator = juce::File::getSeparatorString();
+      return path.size() > root.size() && path.compare(0, root.size(), root) == 0 && path.compare(root.size(), separator.length(), separator.toStdString()) == 0;
+   }
+}
+
+SampleLibraryIndex::SampleLibraryIndex()
+: juce::Thread("SampleLibraryIndex")
+{
+}
+
+SampleLibraryIndex::~SampleLibraryIndex()
+{
+   Stop();
+}
+
+void SampleLibraryIndex::Start(juce::AudioFormatManager* formatManager)
+{
+   mFormatManager = formatManager;
+
+   mWildcards.clear();
+   mWildcards.addTokens(mFormatManager->getWildcardForAllFormats(), ";,", "\"'");
+   mWildcards.trim();
+   mWildcards.removeEmptyStrings();
+
+   LoadCache();
+   ScanLibrary();
+   startThread();
+}
+
+void SampleLibraryIndex::Stop()
+{
+   if (!isThreadRunning())
+      return;
+
+   stopThread(5000);
+   if (mCacheDirty)
+      SaveCache();
+}
+
+void SampleLibraryIndex::ScanLibrary()
+{
+   juce::StringArray paths;
+   paths.addTokens(UserPrefs.sample_library_paths.Get(), ";", "\"");
+   paths.trim();
+   paths.removeEmptyStrings();
+   for (auto& path : paths)
+      RequestScan(ofToDataPath(path.toStdString()), true);
+}
+
+void SampleLibraryIndex::RequestScan(const std::string& dirPath, bool recursive, bool urgent /*= false*/)
+{
+   ScanRequest request;
+   request.mPath = Normalize(dirPath);
+   request.mRecursive = recursive;
+
+   {
+      std::lock_guard<ofMutex> lock(mMutex);
+      if (!mQueuedPaths.insert(request.mPath).second)
+      {
+         for (auto it = mRequests.begin(); it != mRequests.end(); ++it)
+         {
+            if (it->mPath == request.mPath)
+            {
+               if (!urgent)
+               {
+                  it->mRecursive = it->mRecursive || request.mRecursive; //already queued, just make sure it covers what we asked for
+                  return;
+               }
+
+               //already waiting further back, so jump the queue with it
+               request.mRecursive = request.mRecursive || it->mRecursive;
+               mRequests.erase(it);
+               break;
+            }
+         }
+      }
+
+      if (urgent)
+         mRequests.push_front(request);
+      else
+         mRequests.push_back(request);
+   }
+
+   notify();
+}
+
+bool SampleLibraryIndex::GetListing(const std::string& dirPath, std::vector<std::string>& subdirectories, std::vector<std::string>& samples)
+{
+   std::string path = Normalize(dirPath);
+   {
+      std::lock_guard<ofMutex> lock(mMutex);
+      auto it = mDirectories.find(path);
+      if (it != mDirectories.end())
+      {
+         subdirectories = it->second.mSubdirectories;
+         samples.clear();
+         samples.reserve(it->second.mSamples.size());
+         for (const auto& sample : it->second.mSamples)
+            samples.push_back(sample.mPath);
+         return true;
+      }
+   }
+
+   RequestScan(path, false, true);
+   return false;
+}
+
+bool SampleLibraryIndex::GetSamples(const std::string& dirPath, std::vector<std::string>& samples)
+{
+   std::vector<std::string> subdirectories;
+   return GetListing(dirPath, subdirectories, samples);
+}
+
+bool SampleLibraryIndex::GetDirectoriesWithSamples(const std::string& rootPath, std::vector<std::string>& relativePaths)
+{
+   std::string root = Normalize(rootPath);
+   relativePaths.clear();
+   {
+      std::lock_guard<ofMutex> lock(mMutex);
+      if (mDirectories.find(root) != mDirectories.end())
+      {
+         //everything under root is contiguous in the map
+         for (auto it = mDirectories.upper_bound(root); it != mDirectories.end(); ++it)
+         {
+            if (!IsUnder(it->first, root))
+            {
+               if (it->first.compare(0, root.size(), root) == 0)
+                  continue; //a sibling that shares root's name as a prefix, and sorts before the separator
+               break;
+            }
+            if (!it->second.mSamples.empty())
+               relativePaths.push_back(juce::String(it->first.substr(root.size() + 1)).replaceCharacter('\\', '/').toStdString());
+         }
+         return true;
+      }
+   }
+
+   RequestScan(root, true, true);
+   return false;
+}
+
+bool SampleLibraryIndex::GetSampleInfo(const std::string& path, SampleInfo& info)
+{
+   juce::File file(path);
+   std::string fullPath = file.getFullPathName().toStdString();
+   std::string dirPath = file.getParentDirectory().getFullPathName().toStdString();
+
+   std::lock_guard<ofMutex> lock(mMutex);
+   auto it = mDirectories.find(dirPath);
+   if (it == mDirectories.end())
+      return false;
+
+   const auto& samples = it->second.mSamples;
+   auto sample = std::lower_bound(samples.begin(), samples.end(), fullPath, [](const SampleInfo& a, const std::string& b)
+                                  {
+                                     return a.mPath < b;
+                                  });
+   if (sample == samples.end() || sample->mPath != fullPath)
+      return false;
+   info = *sample;
+   return true;
+}
+
+void SampleLibraryIndex::run()
+{
+   juce::uint32 lastSaveTime = juce::Time::getMillisecondCounter();
+   while (!threadShouldExit())
+   {
+      ScanRequest request;
+      bool hasRequest = false;
+      {
+         std::lock_guard<ofMutex> lock(mMutex);
+         if (!mRequests.empty())
+         {
+            request = mRequests.front();
+            mRequests.pop_front();
+            mQueuedPaths.erase(request.mPath);
+            hasRequest = true;
+         }
+      }
+
+      if (hasRequest)
+      {
+         mScanning = true;
+         ScanDirectory(request);
+         if (mCacheDirty && juce::Time::getMillisecondCounter() - lastSaveTime > kSaveIntervalMs)
+         {
+            SaveCache();
+            lastSaveTime = juce::Time::getMillisecondCounter();
+         }
+      }
+      else
+      {
+         mScanning = false;
+         if (mCacheDirty)
+         {
+            SaveCache();
+            lastSaveTime = juce::Time::getMillisecondCounter();
+         }
+         wait(kIdleWaitMs);
+      }
+   }
+}
+
+void SampleLibraryIndex::ScanDirectory(const ScanRequest& request)
+{
+   juce::File dir(request.mPath);
+   if (!dir.isDirectory())
+   {
+      std::lock_guard<ofMutex> lock(mMutex);
+      if (mDirectories.find(request.mPath) != mDirectories.end())
+      {
+         RemoveDirectory(request.mPath);
+         mCacheDirty = true;
+         ++mGeneration;
+      }
+      return;
+   }
+
+   Directory previous;
+   bool hadPrevious = false;
+   {
+      std::lock_guard<ofMutex> lock(mMutex);
+      auto it = mDirectories.find(request.mPath);
+      if (it != mDirectories.end())
+      {
+         previous = it->second;
+         hadPrevious = true;
+      }
+   }
+
+   Directory scanned;
+   for (const auto& entry : juce::RangedDirectoryIterator(dir, false, "*", juce::File::findFilesAndDirectories | juce::File::ignoreHiddenFiles))
+   {
+      if (threadShouldExit())
+         return; //leave the previous contents alone, rather than commit half a listing
+
+      juce::File file = entry.getFile();
+      if (entry.isDirectory())
+      {
+         scanned.mSubdirectories.push_back(file.getFullPathName().toStdString());
+      }
+      else if (IsSampleFile(file.getFileName()))
+      {
+         SampleInfo info;
+         info.mPath = file.getFullPathName().toStdString();
+         info.mModificationTime = entry.getModificationTime().toMilliseconds();
+         info.mFileSize = entry.getFileSize();
+
+         auto cached = std::lower_bound(previous.mSamples.begin(), previous.mSamples.end(), info.mPath, [](const SampleInfo& a, const std::string& b)
+                                        {
+                                           return a.mPath < b;
+                                        });
+         if (cached != previous.mSamples.end() && cached->mPath == info.mPath && cached->mModificationTime == info.mModificationTime && cached->mFileSize == info.mFileSize)
+            info = *cached;
+         else
+            ReadSampleInfo(file, info); //unreadable files stay listed, just without any info
+
+         scanned.mSamples.push_back(info);
+      }
+   }
+
+   std::sort(scanned.mSubdirectories.begin(), scanned.mSubdirectories.end());
+   std::sort(scanned.mSamples.begin(), scanned.mSamples.end(), [](const SampleInfo& a, const SampleInfo& b)
+             {
+                return a.mPath < b.mPath;
+             });
+
+   bool changed = !hadPrevious || scanned.mSubdirectories != previous.mSubdirectories || scanned.mSamples.size() != previous.mSamples.size();
+   for (size_t i = 0; i < scanned.mSamples.size() && !changed; ++i)
+      changed = scanned.mSamples[i].mPath != previous.mSamples[i].mPath || scanned.mSamples[i].mModificationTime != previous.mSamples[i].mModificationTime || scanned.mSamples[i].mFileSize != previous.mSamples[i].mFileSize;
+
+   if (changed)
+   {
+      std::lock_guard<ofMutex> lock(mMutex);
+      for (const auto& subdirectory : previous.mSubdirectories)
+      {
+         if (!std::binary_search(scanned.mSubdirectories.begin(), scanned.mSubdirectories.end(), subdirectory))
+            RemoveDirectory(subdirectory);
+      }
+      mDirectories[request.mPath] = scanned;
+      mCacheDirty = true;
+      ++mGeneration;
+   }
+
+   if (request.mRecursive)
+   {
+      for (const auto& subdirectory : scanned.mSubdirectories)
+         RequestScan(subdirectory, true);
+   }
+}
+
+bool SampleLibraryIndex::ReadSampleInfo(const juce::File& file, SampleInfo& info)
+{
+   std::unique_ptr<juce::AudioFormatReader> reader(mFormatManager->createReaderFor(file));
+   if (reader == nullptr)
+      return false;
+
+   info.mLengthInSamples = reader->lengthInSamples;
+   info.mNumChannels = (int)reader->numChannels;
+   info.mSampleRate = reader->sampleRate;
+   info.mThumbnail.fill(0);
+
+   if (info.mLengthInSamples > 0 && info.mLengthInSamples <= kMaxThumbnailSeconds * info.mSampleRate)
+   {
+      const int numChannelsToRead = std::min(info.mNumChannels, 2);
+      for (int i = 0; i < kThumbnailSize; ++i)
+      {
+         std::int64_t start = info.mLengthInSamples * i / kThumbnailSize;
+         std::int64_t end = info.mLengthInSamples * (i + 1) / kThumbnailSize;
+         if (end <= start)
+            continue;
+
+         juce::Range<float> levels[2];
+         reader->readMaxLevels(start, end - start, levels, numChannelsToRead);
+         float peak = 0;
+         for (int ch = 0; ch < numChannelsToRead; ++ch)
+            peak = std::max({ peak, std::abs(levels[ch].getStart()), std::abs(levels[ch].getEnd()) });
+         info.mThumbnail[i] = (unsigned char)ofClamp(peak * 255, 0, 255);
+      }
+   }
+
+   return true;
+}
+
+void SampleLibraryIndex::RemoveDirectory(const std::string& path)
+{
+   auto it = mDirectories.lower_bound(path);
+   while (it != mDirectories.end() && (it->first == path || it->first.compare(0, path.size(), path) == 0))
+   {
+      if (it->first == path || IsUnder(it->first, path))
+         it = mDirectories.erase(it);
+      else
+         ++it; //a sibling that shares path's name as a prefix
+   }
+}
+
+bool SampleLibraryIndex::IsSampleFile(const juce::String& filename) const
+{
+   for (auto& wildcard : mWildcards)
+   {
+      if (filename.matchesWildcard(wildcard, true))
+         return true;
+   }
+   return false;
+}
+
+void SampleLibraryIndex::LoadCache()
+{
+   if (!juce::File(CacheFilePath()).existsAsFile())
+      return;
+
+   FileStreamIn in(CacheFilePath());
+   if (!in.OpenedOk())
+      return;
+
+   int rev = 0;
+   in >> rev;
+   if (rev != kCacheRev)
+      return;
+
+   //smallest each entry can be on disk, so a corrupt count can't make us allocate more than the file could hold
+   const std::int64_t kMinStringBytes = sizeof(uint32_t);
+   const std::int64_t kMinSampleBytes = kMinStringBytes + sizeof(SampleInfo::mModificationTime) + sizeof(SampleInfo::mFileSize) + sizeof(SampleInfo::mLengthInSamples) + sizeof(SampleInfo::mNumChannels) + sizeof(SampleInfo::mSampleRate) + kThumbnailSize;
+
+   std::map<std::string, Directory> directories;
+   int numDirectories = 0;
+   in >> numDirectories;
+   for (int i = 0; i < numDirectories; ++i)
+   {
+      if (in.Eof())
+         return; //truncated, so rebuild from scratch
+
+      std::string path;
+      in >> path;
+      Directory& dir = directories[path];
+
+      int numSubdirectories = -1;
+      in >> numSubdirectories;
+      if (numSubdirectories < 0 || numSubdirectories > (in.GetSize() - in.GetPosition()) / kMinStringBytes)
+         return;
+      dir.mSubdirectories.resize(numSubdirectories);
+      for (auto& subdirectory : dir.mSubdirectories)
+         in >> subdirectory;
+
+      int numSamples = -1;
+      in >> numSamples;
+      if (numSamples < 0 || numSamples > (in.GetSize() - in.GetPosition()) / kMinSampleBytes)
+         return;
+      dir.mSamples.resize(numSamples);
+      for (auto& sample : dir.mSamples)
+      {
+         in >> sample.mPath;
+         in.ReadGeneric(&sample.mModificationTime, sizeof(sample.mModificationTime));
+         in.ReadGeneric(&sample.mFileSize, sizeof(sample.mFileSize));
+         in.ReadGeneric(&sample.mLengthInSamples, sizeof(sample.mLengthInSamples));
+         in >> sample.mNumChannels;
+         in >> sample.mSampleRate;
+         in.ReadGeneric(sample.mThumbnail.data(), kThumbnailSize);
+      }
+   }
+
+   std::lock_guard<ofMutex> lock(mMutex);
+   mDirectories.swap(directories);
+   ++mGeneration;
+}
+
+void SampleLibraryIndex::SaveCache()
+{
+   //snapshot, so queries aren't blocked while we write
+   std::map<std::string, Directory> directories;
+   {
+      std::lock_guard<ofMutex> lock(mMutex);
+      directories = mDirectories;
+      mCacheDirty = false;
+   }
+
+   //write to a temp file and swap it in, so a crash mid-write can't leave a corrupt cache
+   juce::File cacheFile(CacheFilePath());
+   juce::File tempFile = cacheFile.getSiblingFile(cacheFile.getFileName() + ".tmp");
+   {
+      FileStreamOut out(tempFile.getFullPathName().toStdString());
+
+      out << kCacheRev;
+      out << (int)directories.size();
+      for (const auto& pair : directories)
+      {
+         out << pair.first;
+
+         out << (int)pair.second.mSubdirectories.size();
+         for (const auto& subdirectory : pair.second.mSubdirectories)
+            out << subdirectory;
+
+         out << (int)pair.second.mSamples.size();
+         for (const auto& sample : pair.second.mSamples)
+         {
+            out << sample.mPath;
+            out.WriteGeneric(&sample.mModificationTime, sizeof(sample.mModificationTime));
+            out.WriteGeneric(&sample.mFileSize, sizeof(sample.mFileSize));
+            out.WriteGeneric(&sample.mLengthInSamples, sizeof(sample.mLengthInSamples));
+            out << sample.mNumChannels;
+            out << sample.mSampleRate;
+            out.WriteGeneric(sample.mThumbnail.data(), kThumbnailSize);
+         }
+      }
+   }
+   tempFile.moveFileTo(cacheFile);
+}
+
+//static
+std::string SampleLibraryIndex::Normalize(const std::string& path)
+{
+   return juce::File(path).getFullPathName().toStdString();
+}
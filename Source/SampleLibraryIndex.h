@@ -0,0 +1,115 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleLibraryIndex.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "OpenFrameworksPort.h"
+#include "juce_core/juce_core.h"
+
+namespace juce
+{
+   class AudioFormatManager;
+}
+
+//background index of the sample library, so browsing and picking samples doesn't have to hit the disk on the main thread
+//directories are listed on the scanner thread, and each sample's header is only read again if its modification time or size changed
+//the index is cached on disk, so after the first scan it is available immediately on startup and rescans are cheap
+class SampleLibraryIndex : public juce::Thread
+{
+public:
+   SampleLibraryIndex();
+   ~SampleLibraryIndex();
+
+   static const int kThumbnailSize = 32;
+
+   struct SampleInfo
+   {
+      std::string mPath;
+      std::int64_t mModificationTime{ 0 };
+      std::int64_t mFileSize{ 0 };
+      std::int64_t mLengthInSamples{ 0 }; //0 if the file couldn't be read
+      int mNumChannels{ 0 };
+      double mSampleRate{ 0 };
+      std::array<unsigned char, kThumbnailSize> mThumbnail{}; //peak of each slice of the file, scaled to 0-255
+   };
+
+   void Start(juce::AudioFormatManager* formatManager); //loads the cache and rescans the library paths
+   void Stop(); //writes the cache
+
+   void ScanLibrary(); //recursively rescans every path in the sample_library_paths pref
+   void RequestScan(const std::string& dirPath, bool recursive, bool urgent = false);
+
+   //these return false if the directory isn't indexed yet. a scan of it is requested in that case, and GetGeneration() will change once it's done
+   bool GetListing(const std::string& dirPath, std::vector<std::string>& subdirectories, std::vector<std::string>& samples);
+   bool GetSamples(const std::string& dirPath, std::vector<std::string>& samples);
+   bool GetDirectoriesWithSamples(const std::string& rootPath, std::vector<std::string>& relativePaths); //recursive, relative to root, with '/' separators
+   bool GetSampleInfo(const std::string& path, SampleInfo& info);
+
+   int GetGeneration() const { return mGeneration; } //changes whenever the indexed contents change
+   bool IsScanning() const { return mScanning; }
+
+private:
+   struct Directory
+   {
+      std::vector<std::string> mSubdirectories; //full paths, sorted
+      std::vector<SampleInfo> mSamples; //sorted by path
+   };
+
+   struct ScanRequest
+   {
+      std::string mPath;
+      bool mRecursive{ false };
+   };
+
+   void run() override;
+   void ScanDirectory(const ScanRequest& request);
+   bool ReadSampleInfo(const juce::File& file, SampleInfo& info);
+   void RemoveDirectory(const std::string& path); //and everything under it. call with mMutex locked
+   bool IsSampleFile(const juce::String& filename) const;
+   void LoadCache();
+   void SaveCache();
+   static std::string Normalize(const std::string& path);
+
+   juce::AudioFormatManager* mFormatManager{ nullptr };
+   juce::StringArray mWildcards;
+
+   ofMutex mMutex; //guards everything below
+   std::map<std::string, Directory> mDirectories;
+   std::deque<ScanRequest> mRequests;
+   std::set<std::string> mQueuedPaths;
+
+   std::atomic<bool> mCacheDirty{ false }; //set along with mDirectories under mMutex, but checked without it
+   std::atomic<int> mGeneration{ 0 };
+   std::atomic<bool> mScanning{ false };
+};
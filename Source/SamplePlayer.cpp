@@ -53,6 +53,7 @@ SamplePlayer::SamplePlayer()
 , mNoteInputBuffer(this)
 {
    mYoutubeSearch[0] = 0;
+   mDrawBuffer.EnablePeaks();
 }
 
 void SamplePlayer::CreateUIControls()
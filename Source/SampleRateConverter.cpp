@@ -0,0 +1,110 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleRateConverter.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SampleRateConverter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+   const int kZeroCrossings = 16; //on each side of the kernel center
+   const int kTableResolution = 512; //table entries per zero crossing
+   const double kKaiserBeta = 8;
+   const double kPassband = .95; //fraction of the lower nyquist frequency to keep, the rest is the filter's transition band
+
+   double BesselI0(double x)
+   {
+      double sum = 1;
+      double term = 1;
+      for (int k = 1; k < 32; ++k)
+      {
+         term *= (x / (2 * k)) * (x / (2 * k));
+         sum += term;
+         if (term < sum * 1e-12)
+            break;
+      }
+      return sum;
+   }
+
+   //one side of a kaiser-windowed sinc, indexed in zero crossings
+   struct KernelTable
+   {
+      KernelTable()
+      {
+         const double norm = 1 / BesselI0(kKaiserBeta);
+         for (int i = 0; i <= kTableSize; ++i)
+         {
+            double x = double(i) / kTableResolution;
+            double sinc = (i == 0) ? 1 : sin(M_PI * x) / (M_PI * x);
+            double w = x / kZeroCrossings;
+            double window = BesselI0(kKaiserBeta * sqrt(std::max(0.0, 1 - w * w))) * norm;
+            mValues[i] = float(sinc * window);
+         }
+         mValues[kTableSize + 1] = 0;
+      }
+
+      float Lookup(double x) const
+      {
+         double pos = fabs(x) * kTableResolution;
+         int index = int(pos);
+         if (index >= kTableSize)
+            return 0;
+         float a = float(pos - index);
+         return mValues[index] + a * (mValues[index + 1] - mValues[index]);
+      }
+
+      static const int kTableSize = kZeroCrossings * kTableResolution;
+      float mValues[kTableSize + 2];
+   };
+
+   const KernelTable sKernel;
+}
+
+int SampleRateConverter::GetOutputLength(int inputLength, double inputRate, double outputRate)
+{
+   return (int)ceil(inputLength * outputRate / inputRate);
+}
+
+void SampleRateConverter::Convert(const float* input, int inputLength, double inputRate, float* output, double outputRate)
+{
+   const int outputLength = GetOutputLength(inputLength, inputRate, outputRate);
+   const double step = inputRate / outputRate; //input samples per output sample
+   const double cutoff = kPassband * std::min(1.0, outputRate / inputRate); //relative to the input nyquist, lower when downsampling to avoid aliasing
+   const double halfWidth = kZeroCrossings / cutoff; //in input samples
+
+   for (int i = 0; i < outputLength; ++i)
+   {
+      double center = i * step;
+      int first = std::max(0, (int)ceil(center - halfWidth));
+      int last = std::min(inputLength - 1, (int)floor(center + halfWidth));
+
+      double sum = 0;
+      for (int k = first; k <= last; ++k)
+         sum += input[k] * sKernel.Lookup((k - center) * cutoff);
+      output[i] = float(sum * cutoff);
+   }
+}
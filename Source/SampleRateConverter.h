@@ -0,0 +1,36 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SampleRateConverter.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//offline windowed-sinc sample rate conversion of whole buffers
+//this is for converting audio once (like a sample at load time), it's far too expensive to run per voice
+namespace SampleRateConverter
+{
+   int GetOutputLength(int inputLength, double inputRate, double outputRate);
+   //output must have room for GetOutputLength() samples
+   void Convert(const float* input, int inputLength, double inputRate, float* output, double outputRate);
+};
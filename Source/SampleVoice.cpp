@@ -44,6 +44,11 @@ bool SampleVoice::IsDone(double time)
    return mAdsr.IsDone(time);
 }
 
+bool SampleVoice::IsReleasedBelow(double time, float level)
+{
+   return mAdsr.IsReleasedBelow(time, level);
+}
+
 bool SampleVoice::Process(double time, ChannelBuffer* out, int oversampling)
 {
    PROFILER(SampleVoice);
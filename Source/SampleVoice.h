@@ -59,6 +59,7 @@ public:
    bool Process(double time, ChannelBuffer* out, int oversampling) override;
    void SetVoiceParams(IVoiceParams* params) override;
    bool IsDone(double time) override;
+   bool IsReleasedBelow(double time, float level) override;
 
 private:
    ::ADSR mAdsr;
@@ -229,6 +229,7 @@ void Sampler::FilesDropped(std::vector<std::string> files, int x, int y)
 {
    Sample sample;
    sample.Read(files[0].c_str());
+   sample.WaitForSampleRateConversion();
    SampleDropped(x, y, &sample);
 }
 
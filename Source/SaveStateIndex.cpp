@@ -0,0 +1,116 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SaveStateIndex.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SaveStateIndex.h"
+#include "FileStream.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+   const char kTrailerTag[] = "bskindex";
+   const int kTrailerTagLength = 8;
+   const int kIndexRev = 1;
+   const int kTrailerSize = sizeof(std::int64_t) + kTrailerTagLength + sizeof(int);
+}
+
+void SaveStateIndex::AddSection(const std::string& module, std::int64_t start, std::int64_t end)
+{
+   assert(mSections.empty() || start >= mSections.back().mEnd);
+   mSections.push_back({ module, start, end });
+}
+
+const SaveStateIndex::Section* SaveStateIndex::FindSection(std::int64_t start) const
+{
+   auto it = std::lower_bound(mSections.begin(), mSections.end(), start, [](const Section& section, std::int64_t value)
+                              {
+                                 return section.mStart < value;
+                              });
+   if (it != mSections.end() && it->mStart == start)
+      return &(*it);
+   return nullptr;
+}
+
+void SaveStateIndex::Write(FileStreamOut& out) const
+{
+   std::int64_t indexStart = out.GetPosition();
+
+   out << (int)mSections.size();
+   for (const auto& section : mSections)
+   {
+      out << section.mModule;
+      out.WriteGeneric(&section.mStart, sizeof(section.mStart));
+      out.WriteGeneric(&section.mEnd, sizeof(section.mEnd));
+   }
+
+   out.WriteGeneric(&indexStart, sizeof(indexStart));
+   out.WriteGeneric(kTrailerTag, kTrailerTagLength);
+   out << kIndexRev;
+}
+
+bool SaveStateIndex::Read(FileStreamIn& in)
+{
+   mSections.clear();
+
+   if (in.GetSize() < kTrailerSize)
+      return false;
+
+   std::int64_t position = in.GetPosition();
+
+   std::int64_t indexStart;
+   char tag[kTrailerTagLength];
+   int rev;
+   in.Seek(in.GetSize() - kTrailerSize);
+   in.ReadGeneric(&indexStart, sizeof(indexStart));
+   in.ReadGeneric(tag, kTrailerTagLength);
+   in >> rev;
+
+   bool valid = memcmp(tag, kTrailerTag, kTrailerTagLength) == 0 && rev <= kIndexRev && indexStart >= 0 && indexStart < in.GetSize() - kTrailerSize;
+   if (valid)
+   {
+      in.Seek(indexStart);
+      int numSections;
+      in >> numSections;
+      valid = numSections >= 0 && numSections < (in.GetSize() - indexStart) / (int)sizeof(std::int64_t);
+      for (int i = 0; valid && i < numSections; ++i)
+      {
+         Section section;
+         in >> section.mModule;
+         in.ReadGeneric(&section.mStart, sizeof(section.mStart));
+         in.ReadGeneric(&section.mEnd, sizeof(section.mEnd));
+         valid = section.mStart <= section.mEnd && section.mEnd <= indexStart && (mSections.empty() || section.mStart >= mSections.back().mEnd);
+         mSections.push_back(section);
+      }
+   }
+
+   if (!valid)
+      mSections.clear();
+
+   in.Seek(position);
+   return valid;
+}
@@ -0,0 +1,57 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    SaveStateIndex.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class FileStreamOut;
+class FileStreamIn;
+
+//where each top-level module's state starts and ends in a .bsk
+//it's appended after all of the module data, so anything that reads the file front to back (including older builds) never gets to it
+class SaveStateIndex
+{
+public:
+   struct Section
+   {
+      std::string mModule;
+      std::int64_t mStart{ 0 };
+      std::int64_t mEnd{ 0 };
+   };
+
+   void AddSection(const std::string& module, std::int64_t start, std::int64_t end);
+   const Section* FindSection(std::int64_t start) const;
+   int GetNumSections() const { return (int)mSections.size(); }
+
+   void Write(FileStreamOut& out) const;
+   bool Read(FileStreamIn& in); //false if the file has no (valid) index. leaves the read position where it was
+
+private:
+   std::vector<Section> mSections; //in file order
+};
@@ -26,6 +26,7 @@
 #include "Scale.h"
 #include "SynthGlobals.h"
 #include "ModularSynth.h"
+#include "Transport.h"
 #include "ofxJSONElement.h"
 #include "Tunings.h"
 #include "libMTSClient.h"
@@ -48,6 +49,9 @@ Scale::Scale()
 
 Scale::~Scale()
 {
+   if (TheTransport)
+      TheTransport->RemoveAudioPoller(this);
+
    if (mOddsoundMTSClient)
    {
       MTS_DeregisterClient(mOddsoundMTSClient);
@@ -115,6 +119,8 @@ void Scale::Init()
 {
    IDrawableModule::Init();
 
+   TheTransport->AddAudioPoller(this);
+
    ofxJSONElement root;
    root.open(ofToDataPath("scales.json"));
 
@@ -169,19 +175,92 @@ void Scale::Init()
    }
 
    SetRandomRootAndScale();
+   UpdatePitchToFreqTable();
+}
+
+void Scale::UpdatePitchToFreqTable()
+{
+   //the spare is the table we swapped away from last time. the audio thread might still be in the middle of a block that's reading from it
+   if (mPitchToFreqTable != nullptr && mAudioBlockCount - mPitchToFreqTableSwapBlock < 2)
+   {
+      mPitchToFreqTableWanted = true; //Poll() will try again
+      return;
+   }
+   mPitchToFreqTableWanted = false;
+
+   PitchToFreqTable& table = (mPitchToFreqTable == &mPitchToFreqTables[0]) ? mPitchToFreqTables[1] : mPitchToFreqTables[0];
+   for (int i = 0; i < kPitchToFreqTableSize; ++i)
+      table.mFreqs[i] = PitchToFreqDirect(kPitchToFreqTableMinPitch + float(i) / kPitchToFreqTableStepsPerPitch);
+   table.mReferenceFreq = mReferenceFreq;
+   table.mReferencePitch = mReferencePitch;
+   table.mPitchesPerOctave = mPitchesPerOctave;
+   mPitchToFreqTable = &table;
+   mPitchToFreqTableSwapBlock = mAudioBlockCount;
+}
+
+bool Scale::IsPitchToFreqTableCurrent() const
+{
+   const PitchToFreqTable* table = mPitchToFreqTable;
+   return table != nullptr && mReferenceFreq == table->mReferenceFreq && mReferencePitch == table->mReferencePitch && mPitchesPerOctave == table->mPitchesPerOctave;
+}
+
+void Scale::PitchToFreq(const float* pitches, float* freqsOut, int size)
+{
+   const PitchToFreqTable* table = mPitchToFreqTable;
+   if (table == nullptr)
+   {
+      for (int i = 0; i < size; ++i)
+         freqsOut[i] = PitchToFreqDirect(pitches[i]);
+      return;
+   }
+
+   for (int i = 0; i < size; ++i)
+   {
+      float pos = (pitches[i] - kPitchToFreqTableMinPitch) * kPitchToFreqTableStepsPerPitch;
+      if (pos >= 0 && pos < kPitchToFreqTableSize - 1)
+      {
+         int idx = int(pos);
+         float a = pos - idx;
+         freqsOut[i] = table->mFreqs[idx] + a * (table->mFreqs[idx + 1] - table->mFreqs[idx]);
+      }
+      else
+      {
+         freqsOut[i] = PitchToFreqDirect(pitches[i]);
+      }
+   }
 }
 
-float Scale::PitchToFreq(float pitch)
+bool Scale::CheckForOddsoundRetune()
+{
+   bool hasMaster = mOddsoundMTSClient && MTS_HasMaster(mOddsoundMTSClient);
+   bool changed = (hasMaster != mOddsoundHadMaster);
+   mOddsoundHadMaster = hasMaster;
+   if (hasMaster)
+   {
+      for (int i = 0; i < (int)mOddsoundNoteFreqs.size(); ++i)
+      {
+         float freq = MTS_NoteToFrequency(mOddsoundMTSClient, i, 0);
+         if (freq != mOddsoundNoteFreqs[i])
+         {
+            mOddsoundNoteFreqs[i] = freq;
+            changed = true;
+         }
+      }
+   }
+   return changed;
+}
+
+float Scale::PitchToFreqDirect(float pitch)
 {
    if (mIntonation == kIntonation_SclFile)
    {
       auto ip = (int)pitch + 128;
-      if (ip < 0 || ip > 256)
+      if (ip < 0 || ip >= 256)
          return 440;
 
       // Interpolate in log space
       auto lt = mTuningTable[ip];
-      auto nt = mTuningTable[ip + ((ip != 255) ? 1 : 0)];
+      auto nt = mTuningTable[MIN(ip + 1, 255)];
       auto fp = (pitch + 128) - ip;
       auto interplt = (1 - fp) * lt + fp * nt;
 
@@ -316,6 +395,9 @@ void Scale::SetRoot(int root, bool force)
 
    mScale.SetRoot(root);
 
+   if (mIntonation != kIntonation_Equal && mIntonation != kIntonation_SclFile && mIntonation != kIntonation_Oddsound)
+      UpdatePitchToFreqTable(); //these intonations are relative to the scale root
+
    NotifyListeners();
 }
 
@@ -467,6 +549,25 @@ void Scale::Poll()
       SetRandomRootAndScale();
       mWantSetRandomRootAndScale = false;
    }
+
+   if (mIntonation == kIntonation_Oddsound && CheckForOddsoundRetune())
+      UpdatePitchToFreqTable();
+
+   if (mPitchToFreqTableWanted)
+      UpdatePitchToFreqTable();
+
+   //the tuning entries can also be set without going through TextEntryComplete() (scripts, snapshots, mappings)
+   if (!mPitchToFreqTableWanted && !IsPitchToFreqTableCurrent())
+   {
+      const PitchToFreqTable* table = mPitchToFreqTable;
+      bool pitchesPerOctaveChanged = (table == nullptr || mPitchesPerOctave != table->mPitchesPerOctave);
+      UpdateTuningTable();
+      if (pitchesPerOctaveChanged)
+      {
+         SetUpRootList();
+         NotifyListeners();
+      }
+   }
 }
 
 float Scale::RationalizeNumber(float input)
@@ -679,6 +780,10 @@ void Scale::UpdateTuningTable()
             mTuningTable[i] *= ratio;
       }
    }
+
+   if (mIntonation == kIntonation_Oddsound)
+      CheckForOddsoundRetune();
+   UpdatePitchToFreqTable();
 }
 
 float Scale::GetTuningTableRatio(int semitonesFromCenter)
@@ -791,6 +896,10 @@ void Scale::LoadState(FileStreamIn& in, int rev)
       ofLog() << "Restoring SCL/KBM from streaming";
       UpdateTuningTable();
    }
+   else
+   {
+      UpdatePitchToFreqTable();
+   }
 }
 
 void ScalePitches::SetRoot(int root)
@@ -34,6 +34,7 @@
 #include "Chord.h"
 #include "TextEntry.h"
 #include "ChordDatabase.h"
+#include "IAudioPoller.h"
 #include <atomic>
 
 class IScaleListener
@@ -86,7 +87,7 @@ struct ScalePitches
 
 class MTSClient;
 
-class Scale : public IDrawableModule, public IDropdownListener, public IFloatSliderListener, public IIntSliderListener, public ITextEntryListener, public IButtonListener
+class Scale : public IDrawableModule, public IDropdownListener, public IFloatSliderListener, public IIntSliderListener, public ITextEntryListener, public IButtonListener, public IAudioPoller
 {
 public:
    Scale();
@@ -124,7 +125,22 @@ public:
    int NumTonesInScale() const { return mScale.NumTonesInScale(); }
    int GetPitchesPerOctave() const { return MAX(1, mPitchesPerOctave); }
 
-   float PitchToFreq(float pitch);
+   float PitchToFreq(float pitch)
+   {
+      const PitchToFreqTable* table = mPitchToFreqTable;
+      if (table != nullptr)
+      {
+         float pos = (pitch - kPitchToFreqTableMinPitch) * kPitchToFreqTableStepsPerPitch;
+         if (pos >= 0 && pos < kPitchToFreqTableSize - 1)
+         {
+            int idx = int(pos);
+            float a = pos - idx;
+            return table->mFreqs[idx] + a * (table->mFreqs[idx + 1] - table->mFreqs[idx]);
+         }
+      }
+      return PitchToFreqDirect(pitch);
+   }
+   void PitchToFreq(const float* pitches, float* freqsOut, int size); //a whole block at once, for voices
    float FreqToPitch(float freq);
 
    const ChordDatabase& GetChordDatabase() const { return mChordDatabase; }
@@ -137,6 +153,9 @@ public:
 
    void ButtonClicked(ClickButton* button, double time) override;
 
+   //IAudioPoller
+   void OnTransportAdvanced(float amount) override { ++mAudioBlockCount; }
+
    void LoadLayout(const ofxJSONElement& moduleInfo) override;
    void SetUpFromSaveData() override;
    void SaveState(FileStreamOut& out) override;
@@ -167,6 +186,11 @@ private:
    float RationalizeNumber(float input);
    void UpdateTuningTable();
    float GetTuningTableRatio(int semitonesFromCenter);
+   float PitchToFreqDirect(float pitch);
+   void UpdatePitchToFreqTable();
+   //main thread. false when a tuning entry was changed underneath us, until Poll() rebuilds the table
+   bool IsPitchToFreqTableCurrent() const;
+   bool CheckForOddsoundRetune();
    void SetRandomRootAndScale();
 
    enum IntonationMode
@@ -205,6 +229,28 @@ private:
 
    std::array<float, 256> mTuningTable{};
 
+   //PitchToFreq() is called per-sample by every voice, so we precompute it at a fine resolution and interpolate
+   //double buffered so the table can be rebuilt on the main thread while the audio thread is reading from it
+   static constexpr int kPitchToFreqTableMinPitch = -128;
+   static constexpr int kPitchToFreqTableStepsPerPitch = 32;
+   static constexpr int kPitchToFreqTableSize = 256 * kPitchToFreqTableStepsPerPitch + 1;
+   struct PitchToFreqTable
+   {
+      std::array<float, kPitchToFreqTableSize> mFreqs{};
+      //the tuning entries it was built from
+      float mReferenceFreq{ -1 };
+      float mReferencePitch{ -1 };
+      int mPitchesPerOctave{ -1 };
+   };
+   std::array<PitchToFreqTable, 2> mPitchToFreqTables{};
+   std::atomic<const PitchToFreqTable*> mPitchToFreqTable{ nullptr }; //never written to once it's published here
+   //the spare table can't be rewritten until the audio thread has started a new block since it was swapped out
+   std::atomic<int> mAudioBlockCount{ 0 };
+   int mPitchToFreqTableSwapBlock{ 0 };
+   bool mPitchToFreqTableWanted{ false }; //a rebuild is waiting on that
+   std::array<float, 128> mOddsoundNoteFreqs{};
+   bool mOddsoundHadMaster{ false };
+
    ChordDatabase mChordDatabase;
 
    MTSClient* mOddsoundMTSClient{ nullptr };
@@ -42,6 +42,7 @@ const float mBufferH = 200;
 SeaOfGrain::SeaOfGrain()
 : IAudioProcessor(gBufferSize)
 , mRecordBuffer(10 * gSampleRate)
+, mGrainBuffer(gBufferSize)
 {
    mSample = new Sample();
 
@@ -81,7 +82,7 @@ void SeaOfGrain::CreateUIControls()
       float x = 10 + i * 130;
       mManualVoices[i].mGainSlider = new FloatSlider(this, ("gain " + ofToString(i + 1)).c_str(), x, mBufferY + mBufferH + 12, 120, 15, &mManualVoices[i].mGain, 0, 1);
       mManualVoices[i].mPositionSlider = new FloatSlider(this, ("pos " + ofToString(i + 1)).c_str(), mManualVoices[i].mGainSlider, kAnchor_Below, 120, 15, &mManualVoices[i].mPosition, 0, 1);
-      mManualVoices[i].mOverlapSlider = new FloatSlider(this, ("overlap " + ofToString(i + 1)).c_str(), mManualVoices[i].mPositionSlider, kAnchor_Below, 120, 15, &mManualVoices[i].mGranulator.mGrainOverlap, .25, MAX_GRAINS);
+      mManualVoices[i].mOverlapSlider = new FloatSlider(this, ("overlap " + ofToString(i + 1)).c_str(), mManualVoices[i].mPositionSlider, kAnchor_Below, 120, 15, &mManualVoices[i].mGranulator.mGrainOverlap, .25, kMaxGrainOverlap);
       mManualVoices[i].mSpeedSlider = new FloatSlider(this, ("speed " + ofToString(i + 1)).c_str(), mManualVoices[i].mOverlapSlider, kAnchor_Below, 120, 15, &mManualVoices[i].mGranulator.mSpeed, -3, 3);
       mManualVoices[i].mLengthMsSlider = new FloatSlider(this, ("len ms " + ofToString(i + 1)).c_str(), mManualVoices[i].mSpeedSlider, kAnchor_Below, 120, 15, &mManualVoices[i].mGranulator.mGrainLengthMs, 1, 1000);
       mManualVoices[i].mPosRandomizeSlider = new FloatSlider(this, ("pos r " + ofToString(i + 1)).c_str(), mManualVoices[i].mLengthMsSlider, kAnchor_Below, 120, 15, &mManualVoices[i].mGranulator.mPosRandomizeMs, 0, 200);
@@ -245,6 +246,7 @@ void SeaOfGrain::FilesDropped(std::vector<std::string> files, int x, int y)
    mSample->Reset();
 
    mSample->Read(files[0].c_str());
+   mSample->WaitForSampleRateConversion();
    UpdateSample();
 
    mRecordInput = false;
@@ -428,30 +430,42 @@ SeaOfGrain::GrainMPEVoice::GrainMPEVoice()
 
 void SeaOfGrain::GrainMPEVoice::Process(ChannelBuffer* output, int bufferSize)
 {
-   if (!mADSR.IsDone(gTime) && mOwner->GetSourceBuffer()->BufferSize() > 0)
+   ChannelBuffer* source = mOwner->GetSourceBuffer();
+   if (!mADSR.IsDone(gTime) && source->BufferSize() > 0)
    {
+      //grain parameters only matter when a grain spawns, so they follow the modulation at block rate
+      float pitchBend = mPitchBend ? mPitchBend->GetValue(0) : 0;
+      float pressure = mPressure ? mPressure->GetValue(0) : 0;
+      float modwheel = mModWheel ? mModWheel->GetValue(0) : 0;
+      if (pressure > 0)
+      {
+         mGranulator.mGrainOverlap = ofMap(pressure * pressure, 0, 1, 3, kMaxGrainOverlap);
+         mGranulator.mPosRandomizeMs = ofMap(pressure * pressure, 0, 1, 100, .03f);
+      }
+      mGranulator.mGrainLengthMs = ofMap(modwheel, -1, 1, 10, 700);
+
+      float endPitchBend = mPitchBend ? mPitchBend->GetValue(bufferSize - 1) : 0;
+      float startPos = (mPitch + pitchBend + MIN(.125f, mPlay) - mOwner->mKeyboardBasePitch) / mOwner->mKeyboardNumPitches;
+      float endPos = (mPitch + endPitchBend + MIN(.125f, mPlay + .001f * (bufferSize - 1)) - mOwner->mKeyboardBasePitch) / mOwner->mKeyboardNumPitches;
+      double startOffset = ofLerp(mOwner->GetSourceStartSample(), mOwner->GetSourceEndSample(), startPos) + mOwner->GetSourceBufferOffset();
+      double endOffset = ofLerp(mOwner->GetSourceStartSample(), mOwner->GetSourceEndSample(), endPos) + mOwner->GetSourceBufferOffset();
+      double offsetIncrement = bufferSize > 1 ? (endOffset - startOffset) / (bufferSize - 1) : 0;
+
+      ChannelBuffer* grains = &mOwner->mGrainBuffer;
+      grains->SetNumActiveChannels(source->NumActiveChannels());
+      mGranulator.ProcessBlock(gTime, source, source->BufferSize(), startOffset, offsetIncrement, grains, bufferSize);
+
+      int numChannels = MIN(output->NumActiveChannels(), grains->NumActiveChannels());
       double time = gTime;
       for (int i = 0; i < bufferSize; ++i)
       {
-         float pitchBend = mPitchBend ? mPitchBend->GetValue(i) : 0;
-         float pressure = mPressure ? mPressure->GetValue(i) : 0;
-         float modwheel = mModWheel ? mModWheel->GetValue(i) : 0;
-         if (pressure > 0)
-         {
-            mGranulator.mGrainOverlap = ofMap(pressure * pressure, 0, 1, 3, MAX_GRAINS);
-            mGranulator.mPosRandomizeMs = ofMap(pressure * pressure, 0, 1, 100, .03f);
-         }
-         mGranulator.mGrainLengthMs = ofMap(modwheel, -1, 1, 10, 700);
-
+         pressure = mPressure ? mPressure->GetValue(i) : 0;
          float blend = .0005f;
          mGain = mGain * (1 - blend) + pressure * blend;
 
-         float outSample[ChannelBuffer::kMaxNumChannels];
-         Clear(outSample, ChannelBuffer::kMaxNumChannels);
-         float pos = (mPitch + pitchBend + MIN(.125f, mPlay) - mOwner->mKeyboardBasePitch) / mOwner->mKeyboardNumPitches;
-         mGranulator.ProcessFrame(time, mOwner->GetSourceBuffer(), mOwner->GetSourceBuffer()->BufferSize(), ofLerp(mOwner->GetSourceStartSample(), mOwner->GetSourceEndSample(), pos) + mOwner->GetSourceBufferOffset(), outSample);
-         for (int ch = 0; ch < output->NumActiveChannels(); ++ch)
-            output->GetChannel(ch)[i] += outSample[ch] * sqrtf(mGain) * mADSR.Value(time);
+         float gain = sqrtf(mGain) * mADSR.Value(time);
+         for (int ch = 0; ch < numChannels; ++ch)
+            output->GetChannel(ch)[i] += grains->GetChannel(ch)[i] * gain;
 
          time += gInvSampleRateMs;
          mPlay += .001f;
@@ -497,19 +511,22 @@ SeaOfGrain::GrainManualVoice::GrainManualVoice()
 
 void SeaOfGrain::GrainManualVoice::Process(ChannelBuffer* output, int bufferSize)
 {
-   if (mGain > 0 && mOwner->GetSourceBuffer()->BufferSize() > 0)
+   ChannelBuffer* source = mOwner->GetSourceBuffer();
+   if (mGain > 0 && source->BufferSize() > 0)
    {
-      double time = gTime;
       float panLeft = GetLeftPanGain(mPan);
       float panRight = GetRightPanGain(mPan);
-      for (int i = 0; i < bufferSize; ++i)
+      double offset = ofLerp(mOwner->GetSourceStartSample(), mOwner->GetSourceEndSample(), mPosition) + mOwner->GetSourceBufferOffset();
+
+      ChannelBuffer* grains = &mOwner->mGrainBuffer;
+      grains->SetNumActiveChannels(source->NumActiveChannels());
+      mGranulator.ProcessBlock(gTime, source, source->BufferSize(), offset, 0, grains, bufferSize);
+
+      int numChannels = MIN(output->NumActiveChannels(), grains->NumActiveChannels());
+      for (int ch = 0; ch < numChannels; ++ch)
       {
-         float outSample[ChannelBuffer::kMaxNumChannels];
-         Clear(outSample, ChannelBuffer::kMaxNumChannels);
-         mGranulator.ProcessFrame(time, mOwner->GetSourceBuffer(), mOwner->GetSourceBuffer()->BufferSize(), ofLerp(mOwner->GetSourceStartSample(), mOwner->GetSourceEndSample(), mPosition) + mOwner->GetSourceBufferOffset(), outSample);
-         for (int ch = 0; ch < output->NumActiveChannels(); ++ch)
-            output->GetChannel(ch)[i] += outSample[ch] * mGain * (ch == 0 ? panLeft : panRight);
-         time += gInvSampleRateMs;
+         Mult(grains->GetChannel(ch), mGain * (ch == 0 ? panLeft : panRight), bufferSize);
+         Add(output->GetChannel(ch), grains->GetChannel(ch), bufferSize);
       }
    }
    else
@@ -155,6 +155,8 @@ private:
    GrainMPEVoice mMPEVoices[kNumMPEVoices];
    static const int kNumManualVoices = 6;
    GrainManualVoice mManualVoices[kNumManualVoices];
+   static const int kMaxGrainOverlap = 128;
+   ChannelBuffer mGrainBuffer;
 
    Sample* mSample{ nullptr };
    RollingBuffer mRecordBuffer;
@@ -29,6 +29,7 @@
 #include "Scale.h"
 #include "Profiler.h"
 #include "ChannelBuffer.h"
+#include "BufferArena.h"
 
 SingleOscillatorVoice::SingleOscillatorVoice(IDrawableModule* owner)
 : mOwner(owner)
@@ -44,6 +45,11 @@ bool SingleOscillatorVoice::IsDone(double time)
    return mAdsr.IsDone(time);
 }
 
+bool SingleOscillatorVoice::IsReleasedBelow(double time, float level)
+{
+   return mAdsr.IsReleasedBelow(time, level);
+}
+
 bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversampling)
 {
    PROFILER(SingleOscillatorVoice);
@@ -62,13 +68,22 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
    float freq;
    float vol;
 
+   //look up the whole block's frequencies at once
+   int numUpdates = mVoiceParams->mLiteCPUMode ? 1 : out->BufferSize();
+   ScratchBuffer pitchBuffer(numUpdates, 2);
+   float* pitches = pitchBuffer.Get(0);
+   float* freqs = pitchBuffer.Get(1);
+   for (int pos = 0; pos < numUpdates; ++pos)
+      pitches[pos] = GetPitch(pos);
+   TheScale->PitchToFreq(pitches, freqs, numUpdates);
+
    if (mVoiceParams->mLiteCPUMode)
-      DoParameterUpdate(0, pitch, freq, vol);
+      DoParameterUpdate(0, pitches, freqs, pitch, freq, vol);
 
    for (int pos = 0; pos < out->BufferSize(); ++pos)
    {
       if (!mVoiceParams->mLiteCPUMode)
-         DoParameterUpdate(pos, pitch, freq, vol);
+         DoParameterUpdate(pos, pitches, freqs, pitch, freq, vol);
 
       float adsrVal = mAdsr.Value(time);
 
@@ -137,15 +152,11 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
       {
          //PROFILER(SingleOscillatorVoice_filter);
          float f = ofLerp(mVoiceParams->mFilterCutoffMin, mVoiceParams->mFilterCutoffMax, mFilterAdsr.Value(time)) * (1 - GetModWheel(pos) * .9f);
-         float q = mVoiceParams->mFilterQ;
-         if (f != mFilterLeft.mF || q != mFilterLeft.mQ)
-            mFilterLeft.SetFilterParams(f, q);
-         summedLeft = mFilterLeft.Filter(summedLeft);
-         if (!mono)
-         {
-            mFilterRight.CopyCoeffFrom(mFilterLeft);
-            summedRight = mFilterRight.Filter(summedRight);
-         }
+         mFilter.SetFilterParams(f, mVoiceParams->mFilterQ);
+         if (mono)
+            summedLeft = mFilter.Filter(summedLeft);
+         else
+            mFilter.Filter(summedLeft, summedRight);
       }
 
       {
@@ -167,6 +178,8 @@ bool SingleOscillatorVoice::Process(double time, ChannelBuffer* out, int oversam
 }
 
 void SingleOscillatorVoice::DoParameterUpdate(int samplesIn,
+                                              const float* pitches,
+                                              const float* freqs,
                                               float& pitch,
                                               float& freq,
                                               float& vol)
@@ -174,8 +187,8 @@ void SingleOscillatorVoice::DoParameterUpdate(int samplesIn,
    if (mOwner)
       mOwner->ComputeSliders(samplesIn);
 
-   pitch = GetPitch(samplesIn);
-   freq = TheScale->PitchToFreq(pitch) * mVoiceParams->mMult;
+   pitch = pitches[samplesIn];
+   freq = freqs[samplesIn] * mVoiceParams->mMult;
    vol = mVoiceParams->mVol * .4f / mVoiceParams->mUnison;
 
    for (int u = 0; u < mVoiceParams->mUnison && u < kMaxUnison; ++u)
@@ -202,8 +215,6 @@ void SingleOscillatorVoice::Start(double time, float target)
    if (mVoiceParams->mFilterCutoffMax != SINGLEOSCILLATOR_NO_CUTOFF)
    {
       mUseFilter = true;
-      mFilterLeft.SetFilterType(kFilterType_Lowpass);
-      mFilterRight.SetFilterType(kFilterType_Lowpass);
       mFilterAdsr.Start(time, 1, mVoiceParams->mFilterAdsr, adsrScale);
    }
    else
@@ -33,7 +33,7 @@
 #include "ADSR.h"
 #include "EnvOscillator.h"
 #include "LFO.h"
-#include "BiquadFilter.h"
+#include "StateVariableFilter.h"
 
 #define SINGLEOSCILLATOR_NO_CUTOFF 10000
 
@@ -78,6 +78,7 @@ public:
    bool Process(double time, ChannelBuffer* out, int oversampling) override;
    void SetVoiceParams(IVoiceParams* params) override;
    bool IsDone(double time) override;
+   bool IsReleasedBelow(double time, float level) override;
 
    static float GetADSRScale(float velocity, float velToEnvelope);
 
@@ -85,6 +86,8 @@ public:
 
 private:
    void DoParameterUpdate(int samplesIn,
+                          const float* pitches,
+                          const float* freqs,
                           float& pitch,
                           float& freq,
                           float& vol);
@@ -102,8 +105,7 @@ private:
    OscillatorVoiceParams* mVoiceParams{ nullptr };
 
    ::ADSR mFilterAdsr;
-   BiquadFilter mFilterLeft;
-   BiquadFilter mFilterRight;
+   StateVariableFilter mFilter;
    bool mUseFilter{ false };
 
    IDrawableModule* mOwner;
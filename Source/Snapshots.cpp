@@ -29,6 +29,9 @@
 #include "ofxJSONElement.h"
 #include "PatchCableSource.h"
 
+#include <cmath>
+#include <unordered_map>
+
 std::vector<IUIControl*> Snapshots::sSnapshotHighlightControls;
 
 Snapshots::Snapshots()
@@ -43,11 +46,13 @@ Snapshots::~Snapshots()
 void Snapshots::CreateUIControls()
 {
    IDrawableModule::CreateUIControls();
-   mGrid = new UIGrid("uigrid", 5, 38, 120, 50, 8, 3, this);
+   mGrid = new UIGrid("uigrid", 5, 56, 120, 50, 8, 3, this);
    mBlendTimeSlider = new FloatSlider(this, "blend", 5, 20, 70, 15, &mBlendTime, 0, 5000);
    mCurrentSnapshotSelector = new DropdownList(this, "snapshot", 35, 3, &mCurrentSnapshot, 64);
    mRandomizeButton = new ClickButton(this, "random", 78, 20);
    mAddButton = new ClickButton(this, "add", 101, 3);
+   mCrossfadeSlider = new FloatSlider(this, "crossfade", 5, 38, 70, 15, &mCrossfade, 0, 1);
+   mCrossfadeTargetSelector = new DropdownList(this, "to", 95, 38, &mCrossfadeTarget, 30);
    mSnapshotLabelEntry = new TextEntry(this, "snapshot label", -1, -1, 12, &mSnapshotLabel);
 
    {
@@ -73,7 +78,10 @@ void Snapshots::CreateUIControls()
    }
 
    for (int i = 0; i < 32; ++i)
+   {
       mCurrentSnapshotSelector->AddLabel(ofToString(i).c_str(), i);
+      mCrossfadeTargetSelector->AddLabel(ofToString(i).c_str(), i);
+   }
 }
 
 void Snapshots::Init()
@@ -102,10 +110,33 @@ void Snapshots::Poll()
          sSnapshotHighlightControls.clear();
    }
 
-   if (!mBlending && !mBlendRamps.empty())
+   if (!mBlending && !mBlendMorph.mControls.empty())
+   {
+      std::lock_guard<ofMutex> lock(mRampMutex);
+      mBlendMorph.Clear();
+   }
+
+   if (mBlending && mBlendMorph.mGeneration != IClickable::sPathGeneration)
    {
-      mBlendRamps.clear();
+      std::lock_guard<ofMutex> lock(mRampMutex);
+      RebindBlend();
    }
+
+   int generation = IClickable::sPathGeneration;
+   if (mSweptGeneration != generation)
+   {
+      //something was renamed, moved, added or deleted. rebind everything now, so recalls from the audio thread find their bindings current
+      std::lock_guard<ofMutex> lock(mRampMutex);
+      for (auto& coll : mSnapshotCollection)
+      {
+         coll.Invalidate();
+         Bind(coll);
+      }
+      mSweptGeneration = generation;
+   }
+
+   if (mCrossfadeDirty || mCrossfadeMorph.mGeneration != IClickable::sPathGeneration)
+      RebuildCrossfade();
 }
 
 void Snapshots::DrawModule()
@@ -116,6 +147,8 @@ void Snapshots::DrawModule()
    mGrid->Draw();
    mBlendTimeSlider->Draw();
    mCurrentSnapshotSelector->Draw();
+   mCrossfadeSlider->Draw();
+   mCrossfadeTargetSelector->Draw();
    mRandomizeButton->Draw();
    mAddButton->Draw();
    mSnapshotLabelEntry->SetPosition(3, mGrid->GetRect(K(local)).getMaxY() + 3);
@@ -259,35 +292,49 @@ void Snapshots::SetSnapshot(int idx, double time)
    if (idx < 0 || idx >= (int)mSnapshotCollection.size())
       return;
 
+   std::unique_lock<ofMutex> lock(mRampMutex, std::defer_lock);
+   if (IsAudioThread())
+   {
+      //binding walks the module tree, which is only safe on the main thread. if the snapshot needs it (or the main thread is busy with it), hand the recall over to Poll()
+      if ((mAutoStoreOnSwitch && idx == mCurrentSnapshot) || !lock.try_lock() || !IsBindingCurrent(mSnapshotCollection[idx]))
+      {
+         if (lock.owns_lock())
+            lock.unlock();
+         mQueuedSnapshotIndex = idx;
+         return;
+      }
+   }
+   else
+   {
+      lock.lock();
+   }
+
    if (mAutoStoreOnSwitch)
       Store(mCurrentSnapshot);
 
    mCurrentSnapshot = idx;
+   mCrossfadeDirty = true;
+   mCrossfadeMorph.Clear(); //it's from the old snapshot, keep it from being applied until Poll() rebuilds it
+
+   SnapshotCollection& coll = mSnapshotCollection[idx];
+   Bind(coll);
 
    if (mBlendTime > 0)
    {
-      mRampMutex.lock();
       mBlending = true;
       mBlendProgress = 0;
-      mBlendRamps.clear();
+      mBlendMorph.Clear();
    }
 
    sSnapshotHighlightControls.clear();
-   const SnapshotCollection& coll = mSnapshotCollection[idx];
-   for (std::list<Snapshot>::const_iterator i = coll.mSnapshots.begin();
-        i != coll.mSnapshots.end(); ++i)
+   for (size_t k = 0; k < coll.mBoundControls.size(); ++k)
    {
-      auto context = IClickable::sPathLoadContext;
-      IClickable::sPathLoadContext = GetParent() ? GetParent()->Path() + "~" : "";
-      IUIControl* control = TheSynth->FindUIControl(i->mControlPath);
-      IClickable::sPathLoadContext = context;
+      IUIControl* control = coll.mBoundControls[k];
+      const Snapshot* i = coll.mBoundSnapshots[k];
 
       if (control)
       {
-         if (mBlendTime == 0 ||
-             i->mHasLFO ||
-             !i->mGridContents.empty() ||
-             !i->mString.empty())
+         if (mBlendTime == 0 || !CanBlend(*i))
          {
             control->SetValueDirect(i->mValue, time);
 
@@ -318,10 +365,7 @@ void Snapshots::SetSnapshot(int idx, double time)
          }
          else
          {
-            ControlRamp ramp;
-            ramp.mUIControl = control;
-            ramp.mRamp.Start(0, control->GetValue(), i->mValue, mBlendTime);
-            mBlendRamps.push_back(ramp);
+            mBlendMorph.Add(control, control->GetValue(), coll.mBoundValues[k], coll.mBoundSnapshots[k]->mControlPath);
          }
 
          sSnapshotHighlightControls.push_back(control);
@@ -329,9 +373,7 @@ void Snapshots::SetSnapshot(int idx, double time)
    }
 
    if (mBlendTime > 0)
-   {
-      mRampMutex.unlock();
-   }
+      mBlendMorph.mGeneration = coll.mBoundGeneration;
 
    mDrawSetSnapshotCountdown = 30;
    mSnapshotLabel = coll.mLabel;
@@ -359,21 +401,187 @@ void Snapshots::RandomizeControl(IUIControl* control)
 
 void Snapshots::OnTransportAdvanced(float amount)
 {
+   mCrossfadeSlider->Compute();
+
+   if (!mBlending && mCrossfade == mAppliedCrossfade)
+      return;
+
+   //the main thread only holds this while rebuilding, skip a buffer rather than wait on it
+   if (!mRampMutex.try_lock())
+      return;
+
    if (mBlending)
    {
-      mRampMutex.lock();
+      //if something was renamed or deleted, the controls we're holding might be gone. hold the blend where it is until Poll() rebinds it
+      if (mBlendMorph.mGeneration == IClickable::sPathGeneration)
+      {
+         mBlendProgress += amount * TheTransport->MsPerBar();
+         mBlendMorph.Apply(mBlendTime > 0 ? std::min(mBlendProgress / mBlendTime, 1.0f) : 1, gTime);
 
-      mBlendProgress += amount * TheTransport->MsPerBar();
+         if (mBlendProgress >= mBlendTime)
+         {
+            mBlending = false;
+            if (mCrossfade != 0)
+               mAppliedCrossfade = NAN; //settle onto the crossfade position
+         }
+      }
+   }
+   else if (mCrossfadeMorph.mGeneration == IClickable::sPathGeneration)
+   {
+      mCrossfadeMorph.Apply(mCrossfade, gTime);
+      mAppliedCrossfade = mCrossfade;
+   }
 
-      for (auto& ramp : mBlendRamps)
+   mRampMutex.unlock();
+}
+
+//called with mRampMutex held, on the main thread
+void Snapshots::Bind(SnapshotCollection& coll)
+{
+   if (coll.mBoundGeneration == IClickable::sPathGeneration)
+      return;
+
+   int generation = IClickable::sPathGeneration;
+
+   auto context = IClickable::sPathLoadContext;
+   IClickable::sPathLoadContext = GetParent() ? GetParent()->Path() + "~" : "";
+
+   coll.mBoundControls.clear();
+   coll.mBoundPaths.clear();
+   coll.mBoundValues.clear();
+   coll.mBoundSnapshots.clear();
+   for (const auto& snapshot : coll.mSnapshots)
+   {
+      IUIControl* control = TheSynth->FindUIControl(snapshot.mControlPath);
+      coll.mBoundControls.push_back(control);
+      coll.mBoundPaths.push_back(control ? control->Path(true) : "");
+      coll.mBoundValues.push_back(snapshot.mValue);
+      coll.mBoundSnapshots.push_back(&snapshot);
+   }
+
+   IClickable::sPathLoadContext = context;
+   coll.mBoundGeneration = generation;
+}
+
+//called with mRampMutex held. paths changing somewhere else in the patch doesn't affect us, as long as none of the controls we're bound to were deleted or moved
+//deleted modules aren't freed until the layout is cleared, so the bound pointers are still safe to look at. Poll() picks up anything else soon after
+bool Snapshots::IsBindingCurrent(SnapshotCollection& coll)
+{
+   int generation = IClickable::sPathGeneration;
+   if (coll.mBoundGeneration == generation)
+      return true;
+   if (coll.mBoundGeneration == -1)
+      return false;
+
+   for (size_t i = 0; i < coll.mBoundControls.size(); ++i)
+   {
+      IUIControl* control = coll.mBoundControls[i];
+      if (control == nullptr)
+         continue;
+      IDrawableModule* module = control->GetModuleParent();
+      if ((module != nullptr && module->IsDeleted()) || control->Path(true) != coll.mBoundPaths[i])
+         return false;
+   }
+
+   coll.mBoundGeneration = generation;
+   return true;
+}
+
+//called with mRampMutex held, on the main thread
+void Snapshots::RebindBlend()
+{
+   int generation = IClickable::sPathGeneration;
+
+   auto context = IClickable::sPathLoadContext;
+   IClickable::sPathLoadContext = GetParent() ? GetParent()->Path() + "~" : "";
+
+   Morph rebound;
+   for (size_t i = 0; i < mBlendMorph.mControls.size(); ++i)
+   {
+      IUIControl* control = TheSynth->FindUIControl(mBlendMorph.mPaths[i]);
+      if (control != nullptr)
       {
-         ramp.mUIControl->SetValueDirect(ramp.mRamp.Value(mBlendProgress), gTime);
+         rebound.Add(control, mBlendMorph.mFrom[i], mBlendMorph.mTo[i], mBlendMorph.mPaths[i]);
+         rebound.mValues.back() = mBlendMorph.mValues[i];
       }
+   }
+   rebound.mGeneration = generation;
+
+   IClickable::sPathLoadContext = context;
+   mBlendMorph = rebound;
+}
 
-      if (mBlendProgress >= mBlendTime)
-         mBlending = false;
+void Snapshots::RebuildCrossfade()
+{
+   //only push values out again if what's being crossfaded actually changed while the crossfade is engaged. a plain rebind leaves the controls alone, so live tweaks survive
+   bool reapply = mCrossfadeDirty && mCrossfade != 0;
+   mCrossfadeDirty = false;
+
+   int generation = IClickable::sPathGeneration;
+   bool valid = mCurrentSnapshot >= 0 && mCurrentSnapshot < (int)mSnapshotCollection.size() &&
+                mCrossfadeTarget >= 0 && mCrossfadeTarget < (int)mSnapshotCollection.size();
+
+   std::lock_guard<ofMutex> lock(mRampMutex);
+   mCrossfadeMorph.Clear();
+   mCrossfadeMorph.mGeneration = generation;
+   if (reapply)
+      mAppliedCrossfade = NAN;
+   if (!valid)
+      return;
+
+   SnapshotCollection& from = mSnapshotCollection[mCurrentSnapshot];
+   SnapshotCollection& to = mSnapshotCollection[mCrossfadeTarget];
+   Bind(from);
+   Bind(to);
 
-      mRampMutex.unlock();
+   //only controls that both snapshots have a plain value for can be crossfaded
+   std::unordered_map<IUIControl*, float> fromValues;
+   for (size_t i = 0; i < from.mBoundControls.size(); ++i)
+   {
+      if (from.mBoundControls[i] != nullptr && CanBlend(*from.mBoundSnapshots[i]))
+         fromValues[from.mBoundControls[i]] = from.mBoundValues[i];
+   }
+   for (size_t i = 0; i < to.mBoundControls.size(); ++i)
+   {
+      auto match = fromValues.find(to.mBoundControls[i]);
+      if (match != fromValues.end() && CanBlend(*to.mBoundSnapshots[i]))
+         mCrossfadeMorph.Add(match->first, match->second, to.mBoundValues[i]);
+   }
+}
+
+void Snapshots::Morph::Clear()
+{
+   mControls.clear();
+   mPaths.clear();
+   mFrom.clear();
+   mTo.clear();
+   mValues.clear();
+}
+
+void Snapshots::Morph::Add(IUIControl* control, float from, float to, const std::string& path /*= ""*/)
+{
+   mControls.push_back(control);
+   mPaths.push_back(path);
+   mFrom.push_back(from);
+   mTo.push_back(to);
+   mValues.push_back(from);
+}
+
+void Snapshots::Morph::Apply(float amount, double time)
+{
+   const int count = (int)mControls.size();
+   const float* from = mFrom.data();
+   const float* to = mTo.data();
+   float* values = mValues.data();
+
+   //straight loop over flat arrays, so this vectorizes
+   for (int i = 0; i < count; ++i)
+      values[i] = from[i] + (to[i] - from[i]) * amount;
+
+   for (int i = 0; i < count; ++i)
+   {
+      if (from[i] != to[i])
+         mControls[i]->SetValueDirect(values[i], time);
    }
 }
 
@@ -405,7 +613,9 @@ void Snapshots::PostRepatch(PatchCableSource* cableSource, bool fromUserClick)
 
          for (auto remove : toRemove)
             square.mSnapshots.remove(remove);
+         square.Invalidate();
       }
+      mCrossfadeDirty = true;
    }
 }
 
@@ -434,6 +644,8 @@ void Snapshots::Store(int idx)
 
    SnapshotCollection& coll = mSnapshotCollection[idx];
    coll.mSnapshots.clear();
+   coll.Invalidate();
+   mCrossfadeDirty = true;
 
    for (int i = 0; i < mSnapshotControls.size(); ++i)
    {
@@ -459,6 +671,8 @@ void Snapshots::Delete(int idx)
 
    SnapshotCollection& coll = mSnapshotCollection[idx];
    coll.mSnapshots.clear();
+   coll.Invalidate();
+   mCrossfadeDirty = true;
    coll.mLabel = ofToString(idx);
    mCurrentSnapshotSelector->SetLabel(coll.mLabel, idx);
 }
@@ -466,7 +680,7 @@ void Snapshots::Delete(int idx)
 namespace
 {
    const float extraW = 10;
-   const float extraH = 58;
+   const float extraH = 76;
    const float gridSquareDimension = 18;
    const int maxGridSide = 20;
 }
@@ -500,6 +714,9 @@ void Snapshots::DropdownUpdated(DropdownList* list, int oldVal, double time)
       SetSnapshot(newIdx, time);
       UpdateGridValues();
    }
+
+   if (list == mCrossfadeTargetSelector)
+      mCrossfadeDirty = true;
 }
 
 void Snapshots::TextEntryComplete(TextEntry* entry)
@@ -534,6 +751,9 @@ void Snapshots::SetGridSize(float w, float h)
       mSnapshotCollection.resize(size_t(cols) * rows);
       for (int i = oldSize; i < (int)mSnapshotCollection.size(); ++i)
          mSnapshotCollection[i].mLabel = ofToString(i);
+      for (auto& coll : mSnapshotCollection)
+         coll.Invalidate(); //the collections may have been copied, so the bound snapshot pointers are stale
+      mCrossfadeDirty = true;
    }
    UpdateGridValues();
 }
@@ -642,6 +862,7 @@ void Snapshots::LoadState(FileStreamIn& in, int rev)
          in >> snapshotData.mString;
       }
       in >> mSnapshotCollection[i].mLabel;
+      mSnapshotCollection[i].Invalidate();
       if (rev < 2 && mSnapshotCollection[i].mLabel.empty())
          mSnapshotCollection[i].mLabel = ofToString(i);
       mCurrentSnapshotSelector->SetLabel(mSnapshotCollection[i].mLabel, i);
@@ -676,6 +897,8 @@ void Snapshots::LoadState(FileStreamIn& in, int rev)
 
    if (rev >= 2)
       in >> mCurrentSnapshot;
+
+   mCrossfadeDirty = true;
 }
 
 void Snapshots::UpdateOldControlName(std::string& oldName)
@@ -33,7 +33,6 @@
 #include "FloatSliderLFOControl.h"
 #include "Transport.h"
 #include "Slider.h"
-#include "Ramp.h"
 #include "INoteReceiver.h"
 #include "DropdownList.h"
 #include "TextEntry.h"
@@ -94,6 +93,8 @@ private:
    bool IsConnectedToPath(std::string path) const;
    void RandomizeTargets();
    void RandomizeControl(IUIControl* control);
+   void RebuildCrossfade();
+   void RebindBlend();
 
    //IDrawableModule
    void DrawModule() override;
@@ -128,16 +129,38 @@ private:
 
    struct SnapshotCollection
    {
+      void Invalidate() { mBoundGeneration = -1; }
+
       std::list<Snapshot> mSnapshots;
       std::string mLabel;
+
+      //mSnapshots resolved to controls, in the same order. rebuilt by Bind() after mSnapshots or any paths change
+      std::vector<IUIControl*> mBoundControls; //nullptr if the control is gone
+      std::vector<std::string> mBoundPaths; //full paths of mBoundControls when they were bound
+      std::vector<float> mBoundValues;
+      std::vector<const Snapshot*> mBoundSnapshots;
+      int mBoundGeneration{ -1 };
    };
 
-   struct ControlRamp
+   //a set of controls moving between two flat arrays of values
+   struct Morph
    {
-      IUIControl* mUIControl{ nullptr };
-      Ramp mRamp;
+      void Clear();
+      void Add(IUIControl* control, float from, float to, const std::string& path = "");
+      void Apply(float amount, double time);
+
+      std::vector<IUIControl*> mControls;
+      std::vector<std::string> mPaths; //control paths, if the morph needs to be rebound after paths change
+      std::vector<float> mFrom;
+      std::vector<float> mTo;
+      std::vector<float> mValues;
+      int mGeneration{ -1 }; //IClickable::sPathGeneration this was built with, mControls can't be trusted after that changes
    };
 
+   void Bind(SnapshotCollection& coll);
+   bool IsBindingCurrent(SnapshotCollection& coll);
+   static bool CanBlend(const Snapshot& snapshot) { return !snapshot.mHasLFO && snapshot.mGridContents.empty() && snapshot.mString.empty(); }
+
    UIGrid* mGrid{ nullptr };
    std::vector<SnapshotCollection> mSnapshotCollection;
    ClickButton* mRandomizeButton{ nullptr };
@@ -149,7 +172,14 @@ private:
    float mBlendTime{ 0 };
    FloatSlider* mBlendTimeSlider{ nullptr };
    float mBlendProgress{ 0 };
-   std::vector<ControlRamp> mBlendRamps;
+   Morph mBlendMorph;
+   float mCrossfade{ 0 };
+   FloatSlider* mCrossfadeSlider{ nullptr };
+   int mCrossfadeTarget{ 0 };
+   DropdownList* mCrossfadeTargetSelector{ nullptr };
+   Morph mCrossfadeMorph; //from mCurrentSnapshot to mCrossfadeTarget
+   bool mCrossfadeDirty{ true };
+   float mAppliedCrossfade{ 0 }; //the crossfade is only pushed out when the slider moves away from this. NAN to push it out once regardless
    ofMutex mRampMutex;
    int mCurrentSnapshot{ 0 };
    DropdownList* mCurrentSnapshotSelector{ nullptr };
@@ -161,4 +191,5 @@ private:
    TextEntry* mSnapshotLabelEntry{ nullptr };
    std::string mSnapshotLabel;
    int mLoadRev{ -1 };
+   int mSweptGeneration{ -1 }; //IClickable::sPathGeneration that Poll() last rebound all collections for
 };
@@ -0,0 +1,92 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    StateVariableFilter.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StateVariableFilter.h"
+#include "SynthGlobals.h"
+
+namespace
+{
+   //tan(pi * f/sampleRate) across the normalized cutoff range, shared by every filter
+   const int kTanTableSize = 2048;
+   const float kMaxNormalizedCutoff = .49f; //tan() blows up at nyquist
+
+   struct TanTable
+   {
+      TanTable()
+      {
+         for (int i = 0; i <= kTanTableSize; ++i)
+            mValues[i] = tan(M_PI * kMaxNormalizedCutoff * i / kTanTableSize);
+      }
+
+      float Lookup(float normalizedCutoff) const
+      {
+         float pos = normalizedCutoff * (kTanTableSize / kMaxNormalizedCutoff);
+         if (pos >= kTanTableSize)
+            return mValues[kTanTableSize];
+         int index = int(pos);
+         float a = pos - index;
+         return mValues[index] + a * (mValues[index + 1] - mValues[index]);
+      }
+
+      float mValues[kTanTableSize + 1];
+   };
+
+   const TanTable sTanTable;
+}
+
+StateVariableFilter::StateVariableFilter()
+: mInvSampleRate(1.0f / gSampleRate)
+{
+}
+
+void StateVariableFilter::Clear()
+{
+   for (int ch = 0; ch < kMaxChannels; ++ch)
+   {
+      mIc1eq[ch] = 0;
+      mIc2eq[ch] = 0;
+   }
+}
+
+void StateVariableFilter::SetFilterParams(float f, float q)
+{
+   if (f == mF && q == mQ)
+      return;
+
+   mF = f;
+   mQ = q;
+
+   float g;
+   if (f <= 0 || f != f)
+      g = sTanTable.Lookup(kMaxNormalizedCutoff); //fully open, since BiquadFilter passes everything through with an invalid cutoff
+   else
+      g = sTanTable.Lookup(f * mInvSampleRate);
+
+   float k = 1 / q;
+   mA1 = 1 / (1 + g * (g + k));
+   mA2 = g * mA1;
+   mA3 = g * mA2;
+}
@@ -0,0 +1,93 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    StateVariableFilter.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//lowpass state variable filter in topology-preserving (trapezoidal) form
+//it has the same response as BiquadFilter's kFilterType_Lowpass, but is meant for cutoffs that move every sample:
+//changing the cutoff is a table lookup and a handful of multiplies instead of a tan() and a full coefficient redesign in double,
+//and the structure stays well behaved while it's being modulated
+class StateVariableFilter
+{
+public:
+   static const int kMaxChannels = 2;
+
+   StateVariableFilter();
+
+   void SetSampleRate(double sampleRate)
+   {
+      float invSampleRate = 1.0f / sampleRate;
+      if (invSampleRate != mInvSampleRate)
+      {
+         mInvSampleRate = invSampleRate;
+         mF = -1; //force the next SetFilterParams() to recalculate
+      }
+   }
+   void Clear();
+   void SetFilterParams(float f, float q);
+
+   float Filter(float sample);
+   //filters a stereo pair with the same coefficients
+   void Filter(float& left, float& right);
+
+   float mF{ 0 };
+   float mQ{ 0 };
+
+private:
+   float mA1{ 1 };
+   float mA2{ 0 };
+   float mA3{ 0 };
+   float mIc1eq[kMaxChannels]{};
+   float mIc2eq[kMaxChannels]{};
+   float mInvSampleRate;
+};
+
+inline float StateVariableFilter::Filter(float sample)
+{
+   float v3 = sample - mIc2eq[0];
+   float v1 = mA1 * mIc1eq[0] + mA2 * v3;
+   float v2 = mIc2eq[0] + mA2 * mIc1eq[0] + mA3 * v3;
+   mIc1eq[0] = 2 * v1 - mIc1eq[0];
+   mIc2eq[0] = 2 * v2 - mIc2eq[0];
+   return v2;
+}
+
+inline void StateVariableFilter::Filter(float& left, float& right)
+{
+   float in[kMaxChannels] = { left, right };
+   float out[kMaxChannels];
+   for (int ch = 0; ch < kMaxChannels; ++ch)
+   {
+      float v3 = in[ch] - mIc2eq[ch];
+      float v1 = mA1 * mIc1eq[ch] + mA2 * v3;
+      float v2 = mIc2eq[ch] + mA2 * mIc1eq[ch] + mA3 * v3;
+      mIc1eq[ch] = 2 * v1 - mIc1eq[ch];
+      mIc2eq[ch] = 2 * v2 - mIc2eq[ch];
+      out[ch] = v2;
+   }
+   left = out[0];
+   right = out[1];
+}
@@ -36,6 +36,7 @@
 #include "PatchCable.h"
 #include "PatchCableSource.h"
 #include "ChannelBuffer.h"
+#include "PeakPyramid.h"
 #include "IPulseReceiver.h"
 #include "exprtk/exprtk.hpp"
 #include "UserPrefs.h"
@@ -130,6 +131,38 @@ std::string GetBuildInfoString()
    juce::JUCEApplication::getInstance()->getApplicationVersion().toStdString() + " (" + std::string(__DATE__) + " " + std::string(__TIME__) + ")";
 }
 
+static void DrawAudioBufferChannel(float width, float height, const float* buffer, const PeakPyramid* peaks, float start, float end, float pos, float vol, ofColor color, int wraparoundFrom, int wraparoundTo, int bufferSize);
+
+namespace
+{
+   //peak of numSamples starting at position, following the same wraparound rules as the sample-by-sample scan
+   float GetWrappedPeak(const PeakPyramid* peaks, const float* buffer, int position, int numSamples, int wraparoundFrom, int wraparoundTo, int bufferSize)
+   {
+      float peak = 0;
+      while (numSamples > 0)
+      {
+         int run = numSamples;
+         int sampleIdx = position;
+         if (wraparoundFrom != -1)
+         {
+            if (sampleIdx > wraparoundFrom)
+               sampleIdx = sampleIdx - wraparoundFrom + wraparoundTo;
+            else
+               run = MIN(run, wraparoundFrom + 1 - position);
+         }
+         if (bufferSize > 0)
+         {
+            sampleIdx %= bufferSize;
+            run = MIN(run, bufferSize - sampleIdx);
+         }
+         peak = std::max(peak, peaks->GetPeak(buffer, sampleIdx, sampleIdx + run));
+         position += run;
+         numSamples -= run;
+      }
+      return peak;
+   }
+}
+
 void DrawAudioBuffer(float width, float height, ChannelBuffer* buffer, float start, float end, float pos, float vol /*=1*/, ofColor color /*=ofColor::black*/, int wraparoundFrom /*= -1*/, int wraparoundTo /*= 0*/)
 {
    ofPushMatrix();
@@ -138,7 +171,7 @@ void DrawAudioBuffer(float width, float height, ChannelBuffer* buffer, float sta
       int numChannels = buffer->NumActiveChannels();
       for (int i = 0; i < numChannels; ++i)
       {
-         DrawAudioBuffer(width, height / numChannels, buffer->GetChannel(i), start, MIN(end, buffer->BufferSize()), pos, vol, color, wraparoundFrom, wraparoundTo, buffer->BufferSize());
+         DrawAudioBufferChannel(width, height / numChannels, buffer->GetChannel(i), buffer->GetPeaks(i), start, MIN(end, buffer->BufferSize()), pos, vol, color, wraparoundFrom, wraparoundTo, buffer->BufferSize());
          ofTranslate(0, height / numChannels);
       }
    }
@@ -146,6 +179,11 @@ void DrawAudioBuffer(float width, float height, ChannelBuffer* buffer, float sta
 }
 
 void DrawAudioBuffer(float width, float height, const float* buffer, float start, float end, float pos, float vol /*=1*/, ofColor color /*=ofColor::black*/, int wraparoundFrom /*= -1*/, int wraparoundTo /*= 0*/, int bufferSize /*=-1*/)
+{
+   DrawAudioBufferChannel(width, height, buffer, nullptr, start, end, pos, vol, color, wraparoundFrom, wraparoundTo, bufferSize);
+}
+
+static void DrawAudioBufferChannel(float width, float height, const float* buffer, const PeakPyramid* peaks, float start, float end, float pos, float vol, ofColor color, int wraparoundFrom, int wraparoundTo, int bufferSize)
 {
    vol = MAX(.1f, vol); //make sure we at least draw something if there is waveform data
 
@@ -182,17 +220,24 @@ void DrawAudioBuffer(float width, float height, const float* buffer, float start
          {
             float mag = 0;
             int position = i / width * length + start;
-            //rms
-            int j;
-            int inc = 1 + samplesPerStep / 100;
-            for (j = 0; j < samplesPerStep; j += inc)
+            if (peaks != nullptr)
             {
-               int sampleIdx = position + j;
-               if (wraparoundFrom != -1 && sampleIdx > wraparoundFrom)
-                  sampleIdx = sampleIdx - wraparoundFrom + wraparoundTo;
-               if (bufferSize > 0)
-                  sampleIdx %= bufferSize;
-               mag = MAX(mag, fabsf(buffer[sampleIdx]));
+               mag = GetWrappedPeak(peaks, buffer, position, (int)ceil(samplesPerStep), wraparoundFrom, wraparoundTo, bufferSize);
+            }
+            else
+            {
+               //rms
+               int j;
+               int inc = 1 + samplesPerStep / 100;
+               for (j = 0; j < samplesPerStep; j += inc)
+               {
+                  int sampleIdx = position + j;
+                  if (wraparoundFrom != -1 && sampleIdx > wraparoundFrom)
+                     sampleIdx = sampleIdx - wraparoundFrom + wraparoundTo;
+                  if (bufferSize > 0)
+                     sampleIdx %= bufferSize;
+                  mag = MAX(mag, fabsf(buffer[sampleIdx]));
+               }
             }
             mag = pow(mag, .25f);
             mag *= height / 2 * vol;
@@ -288,6 +333,19 @@ void BufferCopy(float* dst, const float* src, int bufferSize)
 #endif
 }
 
+float GetPeakLevel(const float* buffer, int bufferSize)
+{
+#ifdef USE_VECTOR_OPS
+   auto range = FloatVectorOperations::findMinAndMax(buffer, bufferSize);
+   return std::max(-range.getStart(), range.getEnd());
+#else
+   float peak = 0;
+   for (int i = 0; i < bufferSize; ++i)
+      peak = std::max(peak, fabsf(buffer[i]));
+   return peak;
+#endif
+}
+
 std::string NoteName(int pitch, bool flat, bool includeOctave)
 {
    int octave = pitch / 12;
@@ -298,6 +298,7 @@ TransportListenerInfo* Transport::AddListener(ITimeListener* listener, NoteInter
    else
    {
       mListeners.push_front(TransportListenerInfo(listener, interval, offsetInfo, useEventLookahead));
+      mListenerScheduleDirty = true;
    }
 
    return GetListenerInfo(listener);
@@ -320,9 +321,19 @@ void Transport::RemoveListener(ITimeListener* listener)
    {
       TransportListenerInfo& info = *i;
       if (info.mListener == listener)
+      {
+         for (auto& entry : mListenerSchedule)
+         {
+            if (entry.mInfo == &info)
+               entry.mInfo = nullptr; //we might be in the middle of UpdateListeners()
+         }
+         mListenerScheduleDirty = true;
          i = mListeners.erase(i);
+      }
       else
+      {
          ++i;
+      }
    }
 }
 
@@ -348,6 +359,8 @@ void Transport::ClearListenersAndPollers()
 {
    mListeners.clear();
    mAudioPollers.clear();
+   mListenerSchedule.clear();
+   mListenerScheduleDirty = true;
 }
 
 int Transport::GetQuantized(double time, const TransportListenerInfo* listenerInfo, double* remainderMs /*=nullptr*/)
@@ -617,54 +630,186 @@ double Transport::GetMeasureFraction(NoteInterval interval)
    }
 }
 
-void Transport::UpdateListeners(double jumpMs)
+void Transport::RebuildListenerSchedule()
 {
-   std::list<int> priorities;
-   for (const auto& info : mListeners)
+   mListenerSchedule.clear();
+   for (auto& info : mListeners)
+   {
+      if (info.mListener != nullptr)
+      {
+         ListenerScheduleEntry entry;
+         entry.mInfo = &info;
+         mListenerSchedule.push_back(entry);
+      }
+   }
+
+   //stable, so listeners with the same priority keep their list order
+   std::stable_sort(mListenerSchedule.begin(), mListenerSchedule.end(), [](const ListenerScheduleEntry& a, const ListenerScheduleEntry& b)
+                    { return a.mInfo->mListener->mTransportPriority < b.mInfo->mListener->mTransportPriority; });
+
+   mListenerScheduleDirty = false;
+}
+
+double Transport::GetStableMeasures(const TransportListenerInfo* info, double checkMeasureTime, double offsetMeasures)
+{
+   //returns how far (in measures) checkMeasureTime can advance before GetQuantized() or IsPastQueuedMeasureJump() could give a different answer, erring short. 0 means check every block
+   if (checkMeasureTime < 0)
+      return 0;
+
+   double untilMeasure = floor(checkMeasureTime) + 1 - checkMeasureTime;
+   double stable = untilMeasure;
+
+   if (mQueuedMeasure != -1)
    {
-      if (info.mListener != nullptr && !ListContains(info.mListener->mTransportPriority, priorities))
-         priorities.push_back(info.mListener->mTransportPriority);
+      double untilJump = MIN(mJumpFromMeasure - checkMeasureTime, mJumpFromMeasure - (checkMeasureTime - offsetMeasures));
+      if (untilJump <= 0)
+         return 0;
+      stable = MIN(stable, untilJump);
    }
 
-   priorities.sort();
+   //steps are evenly spaced in swung time. swing can squeeze them by up to 1 + |term|, see SwingBeat()
+   double swingTerm = (.5 - mSwing) / (mSwing * mSwing - mSwing);
+   if (!(fabs(swingTerm) < .99)) //not monotonic, or nan
+      return 0;
+   double maxSwingSlope = 1 + fabs(swingTerm);
+   double swungPos = Swing(fmod(checkMeasureTime, 1));
+   double timeSigScale = double(mTimeSigTop) / mTimeSigBottom;
 
-   for (const auto& priority : priorities)
+   double swungUntilStep;
+   switch (info->mInterval)
    {
-      for (const auto& info : mListeners)
+      case kInterval_1n:
+      case kInterval_2:
+      case kInterval_3:
+      case kInterval_4:
+      case kInterval_8:
+      case kInterval_16:
+      case kInterval_32:
+      case kInterval_64:
+         swungUntilStep = untilMeasure; //only changes on measure boundaries
+         break;
+      case kInterval_2n:
+      case kInterval_2nt:
+      case kInterval_4n:
+      case kInterval_4nt:
+      case kInterval_8n:
+      case kInterval_8nt:
+      case kInterval_16n:
+      case kInterval_16nt:
+      case kInterval_32n:
+      case kInterval_32nt:
+      case kInterval_64n:
+      {
+         double stepsPerMeasure = timeSigScale * CountInStandardMeasure(info->mInterval);
+         double step = swungPos * stepsPerMeasure;
+         swungUntilStep = (floor(step) + 1 - step) / stepsPerMeasure;
+         break;
+      }
+      case kInterval_4nd:
+      case kInterval_8nd:
+      case kInterval_16nd:
       {
-         if (info.mListener != nullptr &&
-             info.mListener->mTransportPriority == priority &&
-             info.mInterval != kInterval_None &&
-             info.mInterval != kInterval_Free)
+         double fraction = GetMeasureFraction(info->mInterval);
+         double step = (floor(checkMeasureTime) + swungPos * timeSigScale) / fraction;
+         swungUntilStep = (floor(step) + 1 - step) * fraction / timeSigScale;
+         break;
+      }
+      case kInterval_CustomDivisor:
+      {
+         if (info->mCustomDivisor <= 0)
+            return 0;
+         double step = swungPos * info->mCustomDivisor;
+         swungUntilStep = (floor(step) + 1 - step) / info->mCustomDivisor;
+         break;
+      }
+      default:
+         return 0;
+   }
+
+   stable = MIN(stable, swungUntilStep / maxSwingSlope);
+   return MAX(0, stable * .999 - 1e-7); //margin for rounding differences against GetQuantized()
+}
+
+void Transport::UpdateListeners(double jumpMs)
+{
+   if (mListenerScheduleDirty)
+      RebuildListenerSchedule();
+
+   if (mTimeSigTop != mScheduledTimeSigTop || mTimeSigBottom != mScheduledTimeSigBottom ||
+       mSwing != mScheduledSwing || mSwingInterval != mScheduledSwingInterval ||
+       mQueuedMeasure != mScheduledQueuedMeasure || mJumpFromMeasure != mScheduledJumpFromMeasure)
+   {
+      //the measure -> step mapping changed, so every cached window is suspect. tempo doesn't matter here, the windows are in measures
+      mScheduledTimeSigTop = mTimeSigTop;
+      mScheduledTimeSigBottom = mTimeSigBottom;
+      mScheduledSwing = mSwing;
+      mScheduledSwingInterval = mSwingInterval;
+      mScheduledQueuedMeasure = mQueuedMeasure;
+      mScheduledJumpFromMeasure = mJumpFromMeasure;
+      ++mTimingVersion;
+   }
+
+   double msPerBar = MsPerBar();
+   for (size_t i = 0; i < mListenerSchedule.size(); ++i)
+   {
+      ListenerScheduleEntry& entry = mListenerSchedule[i];
+      const TransportListenerInfo* info = entry.mInfo;
+      if (info == nullptr || //removed during this update
+          info->mInterval == kInterval_None ||
+          info->mInterval == kInterval_Free)
+         continue;
+
+      double lookaheadMs = jumpMs;
+      if (info->mUseEventLookahead)
+         lookaheadMs = MAX(lookaheadMs, GetEventLookaheadMs());
+
+      double offsetMeasures = info->mOffsetInfo.mOffset;
+      if (info->mOffsetInfo.mOffsetIsInMs)
+         offsetMeasures /= msPerBar;
+      double checkMeasureTime = mMeasureTime + lookaheadMs / msPerBar + offsetMeasures;
+      double prevCheckMeasureTime = checkMeasureTime - jumpMs / msPerBar;
+
+      //nothing can happen if this block's check span is inside the window we worked out last time
+      if (entry.mTimingVersion == mTimingVersion &&
+          entry.mInterval == info->mInterval &&
+          entry.mOffsetInfo.mOffset == info->mOffsetInfo.mOffset &&
+          entry.mOffsetInfo.mOffsetIsInMs == info->mOffsetInfo.mOffsetIsInMs &&
+          entry.mCustomDivisor == info->mCustomDivisor &&
+          prevCheckMeasureTime >= entry.mStableFrom &&
+          checkMeasureTime < entry.mStableUntil)
+         continue;
+
+      double checkTime = gTime + lookaheadMs;
+
+      double remainderMs;
+      int oldStep = GetQuantized(checkTime - jumpMs, info);
+      int newStep = GetQuantized(checkTime, info, &remainderMs);
+      bool oldJumped = IsPastQueuedMeasureJump(checkTime - jumpMs);
+      bool newJumped = IsPastQueuedMeasureJump(checkTime);
+
+      //update the window before calling out, since the listener is allowed to remove itself
+      entry.mInterval = info->mInterval;
+      entry.mOffsetInfo = info->mOffsetInfo;
+      entry.mCustomDivisor = info->mCustomDivisor;
+      entry.mTimingVersion = mTimingVersion;
+      entry.mStableFrom = checkMeasureTime;
+      entry.mStableUntil = checkMeasureTime + GetStableMeasures(info, checkMeasureTime, offsetMeasures);
+
+      if (oldStep != newStep ||
+          oldJumped != newJumped)
+      {
+         double time = checkTime - remainderMs + .0001; //TODO(Ryan) investigate this fudge number. I would think that subtracting remainderMs from checkTime would give me a number that gives me the same GetQuantized() result with a zero remainder, but sometimes it is just short of the correct quantization
+         /*ofLog() << oldStep << " " << newStep << " " << remainderMs << " " << jumpMs << " " << checkTime << " " << time << " " << GetQuantized(checkTime, info.mInterval) << " " << GetQuantized(time, info.mInterval);
+         if (GetQuantized(checkTime + offsetMs, info.mInterval) != GetQuantized(time + offsetMs, info.mInterval))
          {
-            double lookaheadMs = jumpMs;
-            if (info.mUseEventLookahead)
-               lookaheadMs = MAX(lookaheadMs, GetEventLookaheadMs());
-
-            double checkTime = gTime + lookaheadMs;
-
-            double remainderMs;
-            int oldStep = GetQuantized(checkTime - jumpMs, &info);
-            int newStep = GetQuantized(checkTime, &info, &remainderMs);
-            bool oldJumped = IsPastQueuedMeasureJump(checkTime - jumpMs);
-            bool newJumped = IsPastQueuedMeasureJump(checkTime);
-            if (oldStep != newStep ||
-                oldJumped != newJumped)
-            {
-               double time = checkTime - remainderMs + .0001; //TODO(Ryan) investigate this fudge number. I would think that subtracting remainderMs from checkTime would give me a number that gives me the same GetQuantized() result with a zero remainder, but sometimes it is just short of the correct quantization
-               /*ofLog() << oldStep << " " << newStep << " " << remainderMs << " " << jumpMs << " " << checkTime << " " << time << " " << GetQuantized(checkTime, info.mInterval) << " " << GetQuantized(time, info.mInterval);
-               if (GetQuantized(checkTime + offsetMs, info.mInterval) != GetQuantized(time + offsetMs, info.mInterval))
-               {
-                  double aboveRemainderMs;
-                  GetQuantized(checkTime + offsetMs, info.mInterval, &aboveRemainderMs);
-                  double remainderShouldBeZeroMs;
-                  GetQuantized(time + offsetMs, info.mInterval, &remainderShouldBeZeroMs);
-                  ofLog() << remainderShouldBeZeroMs;
-               }*/
-               //assert(GetQuantized(checkTime + offsetMs, info.mInterval) == GetQuantized(time + offsetMs, info.mInterval));
-               info.mListener->OnTimeEvent(time);
-            }
-         }
+            double aboveRemainderMs;
+            GetQuantized(checkTime + offsetMs, info.mInterval, &aboveRemainderMs);
+            double remainderShouldBeZeroMs;
+            GetQuantized(time + offsetMs, info.mInterval, &remainderShouldBeZeroMs);
+            ofLog() << remainderShouldBeZeroMs;
+         }*/
+         //assert(GetQuantized(checkTime + offsetMs, info.mInterval) == GetQuantized(time + offsetMs, info.mInterval));
+         info->mListener->OnTimeEvent(time);
       }
    }
 }
@@ -124,6 +124,7 @@ public:
    void AddAudioPoller(IAudioPoller* poller);
    void RemoveAudioPoller(IAudioPoller* poller);
    void ClearListenersAndPollers();
+   void OnListenerPriorityChanged() { mListenerScheduleDirty = true; }
    double GetDuration(NoteInterval interval);
    int GetQuantized(double time, const TransportListenerInfo* listenerInfo, double* remainderMs = nullptr);
    double GetMeasurePos(double time) const { return fmod(GetMeasureTime(time), 1); }
@@ -182,6 +183,8 @@ public:
 
 private:
    void UpdateListeners(double jumpMs);
+   void RebuildListenerSchedule();
+   double GetStableMeasures(const TransportListenerInfo* info, double checkMeasureTime, double offsetMeasures);
    double Swing(double measurePos);
    double SwingBeat(double pos);
    void Nudge(double amount);
@@ -225,6 +228,28 @@ private:
 
    std::list<TransportListenerInfo> mListeners;
    std::list<IAudioPoller*> mAudioPollers;
+
+   //mListeners sorted by priority, with a cached window per listener over which its quantized step can't change
+   struct ListenerScheduleEntry
+   {
+      TransportListenerInfo* mInfo{ nullptr };
+      //modules adjust their TransportListenerInfo directly, so the window is only trusted while these still match
+      NoteInterval mInterval{ kInterval_None };
+      OffsetInfo mOffsetInfo{ 0, false };
+      int mCustomDivisor{ 0 };
+      int mTimingVersion{ -1 };
+      double mStableFrom{ 0 }; //in measures, including the listener's lookahead and offset
+      double mStableUntil{ 0 };
+   };
+   std::vector<ListenerScheduleEntry> mListenerSchedule;
+   bool mListenerScheduleDirty{ true };
+   int mTimingVersion{ 0 };
+   int mScheduledTimeSigTop{ 0 };
+   int mScheduledTimeSigBottom{ 0 };
+   float mScheduledSwing{ 0 };
+   int mScheduledSwingInterval{ 0 };
+   int mScheduledQueuedMeasure{ -1 };
+   int mScheduledJumpFromMeasure{ -1 };
 };
 
 extern Transport* TheTransport;
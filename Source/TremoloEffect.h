@@ -48,6 +48,7 @@ public:
    void SetEnabled(bool enabled) override { mEnabled = enabled; }
    float GetEffectAmount() override;
    std::string GetType() override { return "tremolo"; }
+   float GetTailLengthMs() override { return 0; }
 
    //IDropdownListener
    void DropdownUpdated(DropdownList* list, int oldVal, double time) override;
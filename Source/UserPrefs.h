@@ -310,7 +310,10 @@ public:
    UserPrefBool autosave{ "autosave", false, UserPrefCategory::General };
    UserPrefBool show_tooltips_on_load{ "show_tooltips_on_load", true, UserPrefCategory::General };
    UserPrefBool show_minimap{ "show_minimap", false, UserPrefCategory::General };
+   UserPrefBool record_output{ "record_output", false, UserPrefCategory::General };
    UserPrefTextEntryFloat record_buffer_length_minutes{ "record_buffer_length_minutes", 30, 1, 120, 5, UserPrefCategory::General };
+   UserPrefBool resample_samples_on_load{ "resample_samples_on_load", true, UserPrefCategory::General };
+   UserPrefBool sleep_silent_modules{ "sleep_silent_modules", true, UserPrefCategory::General };
 #if !BESPOKE_LINUX
    UserPrefBool vst_always_on_top{ "vst_always_on_top", true, UserPrefCategory::General };
 #endif
@@ -346,6 +349,7 @@ public:
    UserPrefString layout{ "layout", "layouts/blank.json", 70, UserPrefCategory::Paths };
    UserPrefString youtube_dl_path{ "youtube_dl_path", kDefaultYoutubeDlPath, 70, UserPrefCategory::Paths };
    UserPrefString ffmpeg_path{ "ffmpeg_path", kDefaultFfmpegPath, 70, UserPrefCategory::Paths };
+   UserPrefString sample_library_paths{ "sample_library_paths", "samples/;drums/", 70, UserPrefCategory::Paths };
 };
 
 extern UserPrefsHolder UserPrefs;
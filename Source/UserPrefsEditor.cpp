@@ -330,6 +330,7 @@ void UserPrefsEditor::DrawModule()
    DrawRightLabel(UserPrefs.layout.GetControl(), "(default: " + UserPrefs.layout.GetDefault() + ")", ofColor::white);
    DrawRightLabel(UserPrefs.youtube_dl_path.GetControl(), "(default: " + UserPrefs.youtube_dl_path.GetDefault() + ")", ofColor::white);
    DrawRightLabel(UserPrefs.ffmpeg_path.GetControl(), "(default: " + UserPrefs.ffmpeg_path.GetDefault() + ")", ofColor::white);
+   DrawRightLabel(UserPrefs.sample_library_paths.GetControl(), "(indexed in the background, separate with ;)", ofColor::white);
 
    if (hasPrefThatRequiresRestart)
       DrawRightLabel(mCancelButton, "*requires restart before taking effect", ofColor::magenta, 4);
@@ -363,6 +364,7 @@ bool UserPrefsEditor::PrefRequiresRestart(UserPref* pref) const
           pref == &UserPrefs.oversampling ||
           pref == &UserPrefs.max_output_channels ||
           pref == &UserPrefs.max_input_channels ||
+          pref == &UserPrefs.record_output ||
           pref == &UserPrefs.record_buffer_length_minutes ||
           pref == &UserPrefs.show_minimap;
 }
@@ -0,0 +1,451 @@
+/**
+    bespoke synth, a software modular synthesizer
+    Copyright (C) 2022 Ryan Challinor (contact: awwbees@gmail.com)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+**/
+/*
+  ==============================================================================
+
+    BespokeBench.cpp
+    Created: 19 Oct 2026
+
+    headless micro-benchmarks for the core DSP kernels, reported in ns per sample
+    usage: bespoke_bench [--samplerate 44100,48000] [--buffersize 64,256,1024] [--voices 1,8,16] [--seconds 2] [--filter name] [--csv]
+
+  ==============================================================================
+*/
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "SynthGlobals.h"
+#include "Scale.h"
+#include "ChannelBuffer.h"
+#include "Oscillator.h"
+#include "ADSR.h"
+#include "BiquadFilter.h"
+#include "RollingBuffer.h"
+#include "FFT.h"
+#include "PitchShifter.h"
+#include "Granulator.h"
+#include "PolyphonyMgr.h"
+#include "SingleOscillatorVoice.h"
+#include "ModulationChain.h"
+#include "freeverb/revmodel.hpp"
+
+#include "juce_audio_basics/juce_audio_basics.h"
+#include "juce_data_structures/juce_data_structures.h"
+
+//normally provided by Main.cpp, which is left out of this target
+juce::ApplicationProperties& getAppProperties()
+{
+   static juce::ApplicationProperties sProperties;
+   return sProperties;
+}
+
+namespace
+{
+   const int kNumRepeats = 5; //the fastest repeat is reported, to keep scheduler noise out of the numbers
+
+   struct BenchConfig
+   {
+      int mSampleRate{ 48000 };
+      int mBufferSize{ 256 };
+      double mSeconds{ 2 };
+   };
+
+   struct BenchOptions
+   {
+      std::vector<int> mSampleRates{ 48000 };
+      std::vector<int> mBufferSizes{ 64, 256, 1024 };
+      std::vector<int> mVoiceCounts{ 1, 8, 16 };
+      double mSeconds{ 2 };
+      std::string mFilter;
+      bool mCsv{ false };
+   };
+
+   //results are accumulated here so the optimizer can't throw the work away
+   volatile float sSink = 0;
+
+   void Consume(const float* buffer, int size)
+   {
+      float sum = 0;
+      for (int i = 0; i < size; ++i)
+         sum += buffer[i];
+      sSink = sSink + sum;
+   }
+
+   void AdvanceTime(int bufferSize)
+   {
+      gTime += bufferSize * gInvSampleRateMs;
+   }
+
+   void FillNoise(float* buffer, int size)
+   {
+      for (int i = 0; i < size; ++i)
+         buffer[i] = ofRandom(-1, 1);
+   }
+
+   //runs processBlock for config.mSeconds worth of audio, a few times over, and returns the best time in ns per sample
+   double Measure(const BenchConfig& config, const std::function<void()>& processBlock)
+   {
+      int numBlocks = std::max(1, int(config.mSeconds * config.mSampleRate / config.mBufferSize));
+
+      for (int i = 0; i < numBlocks / 4 + 1; ++i) //warm up caches, allocations and envelopes
+         processBlock();
+
+      double best = std::numeric_limits<double>::max();
+      for (int repeat = 0; repeat < kNumRepeats; ++repeat)
+      {
+         auto start = std::chrono::steady_clock::now();
+         for (int i = 0; i < numBlocks; ++i)
+            processBlock();
+         auto end = std::chrono::steady_clock::now();
+
+         double ns = std::chrono::duration<double, std::nano>(end - start).count();
+         best = std::min(best, ns / (double(numBlocks) * config.mBufferSize));
+      }
+      return best;
+   }
+
+   double BenchOscillator(const BenchConfig& config, OscillatorType type)
+   {
+      Oscillator osc(type);
+      std::vector<float> out(config.mBufferSize);
+      float phase = 0;
+      float phaseInc = 440 * gTwoPiOverSampleRate;
+      return Measure(config, [&]()
+                     {
+                        for (int i = 0; i < config.mBufferSize; ++i)
+                        {
+                           phase += phaseInc;
+                           while (phase > FTWO_PI * 2)
+                              phase -= FTWO_PI * 2;
+                           out[i] = osc.Value(phase);
+                        }
+                        Consume(out.data(), config.mBufferSize);
+                     });
+   }
+
+   double BenchADSR(const BenchConfig& config)
+   {
+      ::ADSR adsr(10, 50, .5f, 100);
+      std::vector<float> out(config.mBufferSize);
+      double nextEventMs = 0;
+      bool noteOn = false;
+      return Measure(config, [&]()
+                     {
+                        if (gTime >= nextEventMs) //cycle through every stage, like a busy sequence would
+                        {
+                           if (noteOn)
+                              adsr.Stop(gTime);
+                           else
+                              adsr.Start(gTime, 1);
+                           noteOn = !noteOn;
+                           nextEventMs = gTime + 150;
+                        }
+                        for (int i = 0; i < config.mBufferSize; ++i)
+                           out[i] = adsr.Value(gTime + i * gInvSampleRateMs);
+                        Consume(out.data(), config.mBufferSize);
+                        AdvanceTime(config.mBufferSize);
+                     });
+   }
+
+   double BenchBiquadFilter(const BenchConfig& config)
+   {
+      BiquadFilter filter;
+      filter.SetSampleRate(gSampleRate);
+      filter.SetFilterType(kFilterType_Lowpass);
+      filter.SetFilterParams(1200, sqrt(2) / 2);
+      std::vector<float> input(config.mBufferSize);
+      std::vector<float> buffer(config.mBufferSize);
+      FillNoise(input.data(), config.mBufferSize);
+      return Measure(config, [&]()
+                     {
+                        BufferCopy(buffer.data(), input.data(), config.mBufferSize);
+                        filter.Filter(buffer.data(), config.mBufferSize);
+                        Consume(buffer.data(), config.mBufferSize);
+                     });
+   }
+
+   double BenchRollingBuffer(const BenchConfig& config)
+   {
+      RollingBuffer rollingBuffer(gSampleRate);
+      rollingBuffer.SetNumChannels(2);
+      std::vector<float> input(config.mBufferSize);
+      std::vector<float> out(config.mBufferSize);
+      FillNoise(input.data(), config.mBufferSize);
+      int delaySamples = gSampleRate / 4;
+      return Measure(config, [&]()
+                     {
+                        for (int ch = 0; ch < 2; ++ch)
+                        {
+                           rollingBuffer.ReadChunk(out.data(), config.mBufferSize, delaySamples, ch);
+                           rollingBuffer.WriteChunk(input.data(), config.mBufferSize, ch);
+                           Consume(out.data(), config.mBufferSize);
+                        }
+                     });
+   }
+
+   double BenchFFT(const BenchConfig& config)
+   {
+      const int kWindowSize = 1024;
+      const int kHopSize = kWindowSize / 4;
+      ::FFT fft(kWindowSize);
+      std::vector<float> window(kWindowSize);
+      std::vector<float> real(kWindowSize);
+      std::vector<float> imag(kWindowSize);
+      std::vector<float> out(kWindowSize);
+      FillNoise(window.data(), kWindowSize);
+      int pendingSamples = 0;
+      return Measure(config, [&]()
+                     {
+                        //analysis and resynthesis once per hop, the way the spectral modules use it
+                        pendingSamples += config.mBufferSize;
+                        while (pendingSamples >= kHopSize)
+                        {
+                           fft.Forward(window.data(), real.data(), imag.data());
+                           fft.Inverse(real.data(), imag.data(), out.data());
+                           pendingSamples -= kHopSize;
+                        }
+                        Consume(out.data(), kHopSize);
+                     });
+   }
+
+   double BenchPitchShifter(const BenchConfig& config)
+   {
+      PitchShifter pitchShifter(1024);
+      pitchShifter.SetRatio(1.5f);
+      std::vector<float> input(config.mBufferSize);
+      std::vector<float> buffer(config.mBufferSize);
+      FillNoise(input.data(), config.mBufferSize);
+      return Measure(config, [&]()
+                     {
+                        BufferCopy(buffer.data(), input.data(), config.mBufferSize);
+                        pitchShifter.Process(buffer.data(), config.mBufferSize);
+                        Consume(buffer.data(), config.mBufferSize);
+                     });
+   }
+
+   double BenchGranulator(const BenchConfig& config)
+   {
+      Granulator granulator;
+      int sourceLength = gSampleRate * 2;
+      ChannelBuffer source(sourceLength);
+      source.SetNumActiveChannels(2);
+      for (int ch = 0; ch < 2; ++ch)
+         FillNoise(source.GetChannel(ch), sourceLength);
+      ChannelBuffer output(config.mBufferSize);
+      output.SetNumActiveChannels(2);
+      double offset = 0;
+      return Measure(config, [&]()
+                     {
+                        granulator.ProcessBlock(gTime, &source, sourceLength, offset, 1, &output, config.mBufferSize);
+                        offset += config.mBufferSize;
+                        if (offset >= sourceLength)
+                           offset -= sourceLength;
+                        for (int ch = 0; ch < 2; ++ch)
+                           Consume(output.GetChannel(ch), config.mBufferSize);
+                        AdvanceTime(config.mBufferSize);
+                     });
+   }
+
+   double BenchRevmodel(const BenchConfig& config)
+   {
+      revmodel reverb;
+      reverb.setroomsize(.8f);
+      reverb.setdamp(.5f);
+      reverb.setwet(.3f);
+      reverb.setdry(.7f);
+      reverb.setwidth(1);
+      std::vector<float> inputLeft(config.mBufferSize);
+      std::vector<float> inputRight(config.mBufferSize);
+      std::vector<float> outLeft(config.mBufferSize);
+      std::vector<float> outRight(config.mBufferSize);
+      FillNoise(inputLeft.data(), config.mBufferSize);
+      FillNoise(inputRight.data(), config.mBufferSize);
+      return Measure(config, [&]()
+                     {
+                        reverb.processreplace(inputLeft.data(), inputRight.data(), outLeft.data(), outRight.data(), config.mBufferSize, 1);
+                        Consume(outLeft.data(), config.mBufferSize);
+                        Consume(outRight.data(), config.mBufferSize);
+                     });
+   }
+
+   double BenchGetInterpolatedSample(const BenchConfig& config)
+   {
+      int sourceLength = gSampleRate;
+      std::vector<float> source(sourceLength);
+      FillNoise(source.data(), sourceLength);
+      std::vector<float> out(config.mBufferSize);
+      double offset = 0;
+      const double kSpeed = .73; //an awkward playback rate, so every read is fractional
+      return Measure(config, [&]()
+                     {
+                        for (int i = 0; i < config.mBufferSize; ++i)
+                        {
+                           out[i] = GetInterpolatedSample(offset, source.data(), sourceLength);
+                           offset += kSpeed;
+                           if (offset >= sourceLength)
+                              offset -= sourceLength;
+                        }
+                        Consume(out.data(), config.mBufferSize);
+                     });
+   }
+
+   double BenchPolyphonyMgr(const BenchConfig& config, int numVoices)
+   {
+      OscillatorVoiceParams voiceParams;
+      voiceParams.mOscType = kOsc_Saw;
+      voiceParams.mFilterCutoffMax = 4000;
+      PolyphonyMgr polyMgr(nullptr);
+      polyMgr.Init(kVoiceType_SingleOscillator, &voiceParams);
+      for (int i = 0; i < numVoices; ++i)
+         polyMgr.Start(gTime, 36 + (i * 7) % 48, 1, -1, ModulationParameters());
+
+      ChannelBuffer output(config.mBufferSize);
+      output.SetNumActiveChannels(2);
+      double ns = Measure(config, [&]()
+                          {
+                             output.Clear();
+                             polyMgr.Process(gTime, &output, config.mBufferSize);
+                             for (int ch = 0; ch < 2; ++ch)
+                                Consume(output.GetChannel(ch), config.mBufferSize);
+                             AdvanceTime(config.mBufferSize);
+                          });
+      polyMgr.KillAll();
+      return ns;
+   }
+
+   std::vector<int> ParseIntList(const std::string& list)
+   {
+      std::vector<int> values;
+      for (const auto& token : ofSplitString(list, ",", true, true))
+         values.push_back(ofToInt(token));
+      return values;
+   }
+
+   void PrintUsage()
+   {
+      std::cout << "usage: bespoke_bench [--samplerate 48000] [--buffersize 64,256,1024] [--voices 1,8,16] [--seconds 2] [--filter name] [--csv]" << std::endl;
+   }
+
+   bool ParseArgs(int argc, char* argv[], BenchOptions& options)
+   {
+      for (int i = 1; i < argc; ++i)
+      {
+         std::string arg = argv[i];
+         bool hasValue = i + 1 < argc;
+         if (arg == "--samplerate" && hasValue)
+            options.mSampleRates = ParseIntList(argv[++i]);
+         else if (arg == "--buffersize" && hasValue)
+            options.mBufferSizes = ParseIntList(argv[++i]);
+         else if (arg == "--voices" && hasValue)
+            options.mVoiceCounts = ParseIntList(argv[++i]);
+         else if (arg == "--seconds" && hasValue)
+            options.mSeconds = ofToFloat(argv[++i]);
+         else if (arg == "--filter" && hasValue)
+            options.mFilter = argv[++i];
+         else if (arg == "--csv")
+            options.mCsv = true;
+         else
+            return false;
+      }
+
+      for (int bufferSize : options.mBufferSizes)
+      {
+         if (bufferSize <= 0 || bufferSize > kWorkBufferSize)
+            return false;
+      }
+      for (int& voices : options.mVoiceCounts)
+         voices = std::clamp(voices, 1, kNumVoices);
+      return !options.mSampleRates.empty() && !options.mBufferSizes.empty() && options.mSeconds > 0;
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   BenchOptions options;
+   if (!ParseArgs(argc, argv, options))
+   {
+      PrintUsage();
+      return 1;
+   }
+
+   juce::FloatVectorOperations::disableDenormalisedNumberSupport(); //same as the audio thread
+
+   //constructed without Init(), so pitches go through PitchToFreqDirect() and nothing reaches for TheSynth
+   Scale scale;
+
+   std::vector<std::pair<std::string, std::function<double(const BenchConfig&)>>> benches;
+   benches.push_back({ "oscillator_sin", [](const BenchConfig& config) { return BenchOscillator(config, kOsc_Sin); } });
+   benches.push_back({ "oscillator_saw", [](const BenchConfig& config) { return BenchOscillator(config, kOsc_Saw); } });
+   benches.push_back({ "oscillator_square", [](const BenchConfig& config) { return BenchOscillator(config, kOsc_Square); } });
+   benches.push_back({ "adsr", BenchADSR });
+   benches.push_back({ "biquadfilter", BenchBiquadFilter });
+   benches.push_back({ "rollingbuffer", BenchRollingBuffer });
+   benches.push_back({ "fft", BenchFFT });
+   benches.push_back({ "pitchshifter", BenchPitchShifter });
+   benches.push_back({ "granulator", BenchGranulator });
+   benches.push_back({ "revmodel", BenchRevmodel });
+   benches.push_back({ "getinterpolatedsample", BenchGetInterpolatedSample });
+   for (int voices : options.mVoiceCounts)
+      benches.push_back({ "polyphonymgr_" + ofToString(voices) + "voices", [voices](const BenchConfig& config) { return BenchPolyphonyMgr(config, voices); } });
+
+   if (options.mCsv)
+      std::cout << "kernel,samplerate,buffersize,ns_per_sample,realtime_cpu_percent" << std::endl;
+   else
+      std::cout << std::left << std::setw(28) << "kernel" << std::right << std::setw(8) << "rate" << std::setw(8) << "buffer" << std::setw(14) << "ns/sample" << std::setw(12) << "%cpu" << std::endl;
+
+   for (int sampleRate : options.mSampleRates)
+   {
+      for (int bufferSize : options.mBufferSizes)
+      {
+         SetGlobalSampleRateAndBufferSize(sampleRate, bufferSize);
+
+         BenchConfig config;
+         config.mSampleRate = gSampleRate;
+         config.mBufferSize = gBufferSize;
+         config.mSeconds = options.mSeconds;
+
+         for (const auto& bench : benches)
+         {
+            if (!options.mFilter.empty() && bench.first.find(options.mFilter) == std::string::npos)
+               continue;
+
+            gTime = 0;
+            double nsPerSample = bench.second(config);
+            double cpuPercent = nsPerSample * config.mSampleRate / 1e9 * 100; //share of one core needed to keep up in realtime
+
+            if (options.mCsv)
+            {
+               std::cout << bench.first << "," << config.mSampleRate << "," << config.mBufferSize << "," << nsPerSample << "," << cpuPercent << std::endl;
+            }
+            else
+            {
+               std::cout << std::left << std::setw(28) << bench.first << std::right << std::setw(8) << config.mSampleRate << std::setw(8) << config.mBufferSize
+                         << std::setw(14) << std::fixed << std::setprecision(2) << nsPerSample << std::setw(12) << std::setprecision(3) << cpuPercent << std::endl;
+            }
+         }
+      }
+   }
+
+   return 0;
+}